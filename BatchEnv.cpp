@@ -0,0 +1,123 @@
+/*
+Title:	BatchEnv.cpp
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: implementation file for BatchEnv class for my game engine
+ */
+
+#include "BatchEnv.h"
+
+BatchEnv::BatchEnv()
+{
+}
+
+BatchEnv::~BatchEnv()
+{
+	free();
+}
+
+bool BatchEnv::init(int count, int shardCount, const SessionMedia& media, const WaveScript& waves, Uint64 seed)
+{
+	free();
+
+	//port 0 makes every session played rather than served
+	if(!host.init(count, shardCount, media, waves, seed, 0))
+	{
+		return false;
+	}
+
+	killsSeen.assign(count, 0);
+
+	return true;
+}
+
+void BatchEnv::free()
+{
+	host.free();
+	killsSeen.clear();
+}
+
+void BatchEnv::reset(BatchObservation* observations)
+{
+	for(int i = 0; i < host.getSessionCount(); i++)
+	{
+		host.getSession(i).reset();
+		observe(i, observations[i], 0, false);
+	}
+}
+
+void BatchEnv::step(const PlayerInput* actions, BatchObservation* observations)
+{
+	//observed on thread that stepped game, while it is still in cache
+	host.step(actions, [this, observations](int index)
+	{
+		Session& session = host.getSession(index);
+		Uint32 killed = session.getScene().getEnemiesKilled();
+
+		float reward = (killed - killsSeen[index]) * BATCH_KILL_REWARD;
+		if (session.getResult() == ROUND_DIED) { reward += BATCH_DEATH_REWARD; }
+		else if (session.getResult() == ROUND_SURVIVED) { reward += BATCH_SURVIVE_REWARD; }
+
+		observe(index, observations[index], reward, session.getResult() != ROUND_PLAYING);
+	});
+}
+
+void BatchEnv::observe(int index, BatchObservation& observation, float reward, bool done)
+{
+	Session& session = host.getSession(index);
+	Scene& scene = session.getScene();
+	Sprite* player = scene.getPlayer();
+
+	SDL_Point center = scene.getPlayerPos();
+	observation.playerX = (float)center.x;
+	observation.playerY = (float)center.y;
+	observation.playerAngle = player != NULL ? (float)player->getImgAngle() : 0;
+	observation.health = player != NULL ? (float)player->getHealth() : 0;
+	observation.reloadTicks = player != NULL ? (float)player->getReloadTicks() : 0;
+	observation.roundTicks = (float)session.getRoundTicks();
+	observation.enemyCount = (float)scene.getEnemyCount();
+
+	//keep nearest enemies sorted by distance, inserting each one into place
+	int distances[BATCH_NEAREST_ENEMIES];
+	int found = 0;
+	for(const Sprite& enemy : scene.getEntities())
+	{
+		if(enemy.isPlayer())
+		{
+			continue;
+		}
+
+		int offsetX = enemy.getCenter().x - center.x;
+		int offsetY = enemy.getCenter().y - center.y;
+		int distance = offsetX * offsetX + offsetY * offsetY;
+
+		if(found == BATCH_NEAREST_ENEMIES && distance >= distances[found - 1])
+		{
+			continue;
+		}
+
+		int slot = found < BATCH_NEAREST_ENEMIES ? found++ : found - 1;
+		while(slot > 0 && distances[slot - 1] > distance)
+		{
+			distances[slot] = distances[slot - 1];
+			observation.enemyX[slot] = observation.enemyX[slot - 1];
+			observation.enemyY[slot] = observation.enemyY[slot - 1];
+			slot--;
+		}
+
+		distances[slot] = distance;
+		observation.enemyX[slot] = (float)offsetX;
+		observation.enemyY[slot] = (float)offsetY;
+	}
+
+	for(int i = found; i < BATCH_NEAREST_ENEMIES; i++)
+	{
+		observation.enemyX[i] = 0;
+		observation.enemyY[i] = 0;
+	}
+
+	observation.reward = reward;
+	observation.done = done;
+
+	killsSeen[index] = scene.getEnemiesKilled();
+}
@@ -0,0 +1,78 @@
+/*
+Title:	BatchEnv.h
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: header file for BatchEnv class for my game engine. Steps many headless games in lockstep for training agents and
+	automated playtesting, without going through SDL events. Each step takes one packed PlayerInput per game and writes one
+	BatchObservation per game straight into the caller's array, from the thread that stepped that game. Games run as
+	sessions of a SessionHost, so they are sharded across cores and a game whose round ends starts over on its own.
+ */
+
+#pragma once
+#ifndef BATCHENV_H
+#define BATCHENV_H
+
+#include <SDL.h>
+#include <vector>
+#include "Session.h"
+
+//batch environment constants
+const int BATCH_NEAREST_ENEMIES = 8;		//enemies reported in each observation, nearest first
+const float BATCH_KILL_REWARD = 1.0f;		//reward for each enemy killed in a step
+const float BATCH_DEATH_REWARD = -10.0f;	//reward for dying
+const float BATCH_SURVIVE_REWARD = 10.0f;	//reward for lasting out the round
+
+//what an agent sees of one game after a step. All floats but done, so it can be viewed as rows of numbers
+struct BatchObservation
+{
+	float playerX;		//player center in pixels
+	float playerY;
+	float playerAngle;	//facing in radians
+	float health;
+	float reloadTicks;	//ticks until player can fire again
+	float roundTicks;	//ticks into round
+	float enemyCount;
+	float enemyX[BATCH_NEAREST_ENEMIES];	//nearest enemies' centers relative to player, 0 where there are fewer
+	float enemyY[BATCH_NEAREST_ENEMIES];
+	float reward;		//reward earned by step
+	Uint8 done;			//step ended round, rest of observation is of new round's start
+	Uint8 padding[3];
+};
+
+class BatchEnv
+{
+public:
+	//initialize variables
+	BatchEnv();
+
+	//destructor
+	~BatchEnv();
+
+	//make count games seeded from seed, split into shards, 0 for one per core. Textures in media give sprites their sizes
+	bool init(int count, int shardCount, const SessionMedia& media, const WaveScript& waves, Uint64 seed);
+
+	//deallocates resources
+	void free();
+
+	//start every game's round over and observe it
+	void reset(BatchObservation* observations);
+
+	//step every game once with actions[i], writing observations[i]. Both arrays hold a game count of entries
+	void step(const PlayerInput* actions, BatchObservation* observations);
+
+	//getters
+	int getCount() const { return host.getSessionCount(); }
+	int getShardCount() const { return host.getShardCount(); }
+	Sint64 getSteps() const { return host.getSteps(); }		//get game steps run since init, over every game
+
+private:
+	//write what game at index looks like now, with reward for step that led here
+	void observe(int index, BatchObservation& observation, float reward, bool done);
+
+	//games
+	SessionHost host;
+
+	//enemies each game had killed when last observed
+	std::vector<Uint32> killsSeen;
+};
+#endif
@@ -0,0 +1,166 @@
+/*
+Title:	DynamicResolution.cpp
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: implementation file for DynamicResolution class for my game engine
+ */
+
+#include "DynamicResolution.h"
+#include "MemTrack.h"
+#include "PerfOverlay.h"
+#include <algorithm>
+#include <cmath>
+
+DynamicResolution::DynamicResolution()
+{
+	//initialize variables
+	mRenderer = NULL;
+	target = NULL;
+	softRenderer = NULL;
+	width = 0;
+	height = 0;
+	scale = 1;
+	drawingToTarget = false;
+	budgetMs = 0;
+	frameMs = 0;
+	drawMs = 0;
+	overFrames = 0;
+	underFrames = 0;
+	settleFrames = 0;
+	changes = 0;
+	active = false;
+}
+
+DynamicResolution::~DynamicResolution()
+{
+	free();
+}
+
+bool DynamicResolution::init(SDL_Renderer* renderer, int width, int height, float budgetMs, SoftRenderer* softRenderer)
+{
+	free();
+
+	//SDL drawing needs somewhere smaller to go
+	if(softRenderer == NULL)
+	{
+		target = memTrackTexture(SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, width, height));
+		if(target == NULL)
+		{
+			SDL_LogMessage(SDL_LOG_CATEGORY_RENDER, SDL_LOG_PRIORITY_ERROR, "Unable to create dynamic resolution target! SDL Error: %s\n", SDL_GetError());
+			return false;
+		}
+
+		SDL_SetTextureScaleMode(target, SDL_ScaleModeLinear);
+	}
+
+	mRenderer = renderer;
+	this->softRenderer = softRenderer;
+	this->width = width;
+	this->height = height;
+	this->budgetMs = budgetMs;
+	scale = 1;
+	frameMs = 0;
+	drawMs = 0;
+	overFrames = 0;
+	underFrames = 0;
+	settleFrames = 0;
+	changes = 0;
+	active = true;
+
+	return true;
+}
+
+void DynamicResolution::free()
+{
+	memDestroyTexture(target);
+	target = NULL;
+
+	if (softRenderer != NULL) { softRenderer->setScale(1); }
+	softRenderer = NULL;
+
+	mRenderer = NULL;
+	scale = 1;
+	active = false;
+}
+
+void DynamicResolution::addFrame(float frameMs, float drawMs)
+{
+	if(!active)
+	{
+		return;
+	}
+
+	//smoothed so a single slow frame doesn't move scale
+	this->frameMs = this->frameMs == 0 ? frameMs : this->frameMs + (frameMs - this->frameMs) * RES_SMOOTHING;
+	this->drawMs = this->drawMs == 0 ? drawMs : this->drawMs + (drawMs - this->drawMs) * RES_SMOOTHING;
+
+	//drawing less only helps if drawing is part of what is slow
+	bool over = this->frameMs > budgetMs * RES_HIGH_FRACTION && this->drawMs > this->frameMs * RES_DRAW_SHARE;
+	bool under = this->frameMs < budgetMs * RES_LOW_FRACTION;
+	overFrames = over ? overFrames + 1 : 0;
+	underFrames = under ? underFrames + 1 : 0;
+
+	//give last change time to show in smoothed times
+	if(++settleFrames < RES_SETTLE_FRAMES)
+	{
+		return;
+	}
+
+	float newScale = scale;
+	if (overFrames >= RES_DROP_FRAMES) { newScale = std::max(scale - RES_DROP_STEP, RES_MIN_SCALE); }
+	else if (underFrames >= RES_RAISE_FRAMES) { newScale = std::min(scale + RES_RAISE_STEP, 1.0f); }
+
+	if(newScale != scale)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_RENDER, SDL_LOG_PRIORITY_INFO, "Render scale %.3f to %.3f, %.1f ms frames (%.1f ms drawing) against %.1f ms budget\n",
+			scale, newScale, this->frameMs, this->drawMs, budgetMs);
+
+		scale = newScale;
+		overFrames = 0;
+		underFrames = 0;
+		settleFrames = 0;
+		changes++;
+	}
+}
+
+void DynamicResolution::begin()
+{
+	drawingToTarget = false;
+
+	if(!active)
+	{
+		return;
+	}
+
+	//CPU renderer scales its own framebuffer
+	if(softRenderer != NULL)
+	{
+		softRenderer->setScale(scale);
+		return;
+	}
+
+	//full scale draws straight to window
+	if(scale < 1)
+	{
+		SDL_SetRenderTarget(mRenderer, target);
+		SDL_RenderSetScale(mRenderer, scale, scale);
+		drawingToTarget = true;
+	}
+}
+
+void DynamicResolution::end()
+{
+	if(!drawingToTarget)
+	{
+		return;
+	}
+
+	SDL_SetRenderTarget(mRenderer, NULL);
+	SDL_RenderSetScale(mRenderer, 1, 1);
+
+	SDL_Rect drawn = { 0, 0, (int)lroundf(width * scale), (int)lroundf(height * scale) };
+	SDL_RenderCopy(mRenderer, target, &drawn, NULL);
+	perfCountDraw();
+
+	drawingToTarget = false;
+}
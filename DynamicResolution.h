@@ -0,0 +1,90 @@
+/*
+Title:	DynamicResolution.h
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: header file for DynamicResolution class for my game engine. Keeps frame rate steady on CPU renderers by drawing the
+	scene at a lower resolution when frames run over budget, then stretching it to the window. Scale drops quickly once the
+	smoothed frame time stays over budget, and only climbs back after a long stretch well under it, so it doesn't flip back
+	and forth. SDL drawing goes to an offscreen target at the reduced size, and the CPU renderer draws into part of its own
+	framebuffer instead.
+ */
+
+#pragma once
+#ifndef DYNAMICRESOLUTION_H
+#define DYNAMICRESOLUTION_H
+
+#include <SDL.h>
+#include "SoftRenderer.h"
+
+//dynamic resolution constants
+const float RES_MIN_SCALE = 0.5f;
+const float RES_DROP_STEP = 0.125f;
+const float RES_RAISE_STEP = 0.0625f;
+const float RES_HIGH_FRACTION = 0.9f;	//of budget, smoothed frame time over this drops scale
+const float RES_LOW_FRACTION = 0.65f;	//of budget, smoothed frame time under this raises scale
+const float RES_DRAW_SHARE = 0.25f;		//drawing must be at least this much of frame for scale to help
+const float RES_SMOOTHING = 0.1f;		//weight of newest frame in smoothed times
+const int RES_DROP_FRAMES = 10;			//frames over budget before dropping
+const int RES_RAISE_FRAMES = 90;		//frames under budget before raising
+const int RES_SETTLE_FRAMES = 20;		//frames after a change before another
+
+class DynamicResolution
+{
+public:
+	//initialize variables
+	DynamicResolution();
+
+	//destructor
+	~DynamicResolution();
+
+	//start scaling drawing to renderer's width x height to keep frames under budgetMs. If softRenderer is set it is scaled
+	//itself, otherwise an offscreen target is made
+	bool init(SDL_Renderer* renderer, int width, int height, float budgetMs, SoftRenderer* softRenderer);
+
+	//deallocates resources
+	void free();
+
+	//add ms spent on last frame, not counting time waiting for next one, and ms of that spent drawing
+	void addFrame(float frameMs, float drawMs);
+
+	//send drawing to current scale, call before drawing a frame
+	void begin();
+
+	//stretch what was drawn over window
+	void end();
+
+	//getters
+	bool isActive() const { return active; }
+	float getScale() const { return scale; }
+	int getChanges() const { return changes; }			//get times scale has changed
+	float getFrameMs() const { return frameMs; }		//get smoothed frame time
+
+private:
+	SDL_Renderer* mRenderer;
+
+	//scene drawn at reduced scale, NULL when CPU renderer is scaled instead
+	SDL_Texture* target;
+	SoftRenderer* softRenderer;
+
+	//full size
+	int width;
+	int height;
+
+	//scale frames are drawn at, and if current frame went to target
+	float scale;
+	bool drawingToTarget;
+
+	//smoothed times
+	float budgetMs;
+	float frameMs;
+	float drawMs;
+
+	//frames in a row over or under budget, and since last change
+	int overFrames;
+	int underFrames;
+	int settleFrames;
+	int changes;
+
+	bool active;
+};
+#endif
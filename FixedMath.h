@@ -0,0 +1,86 @@
+/*
+Title:	FixedMath.h
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: header file for fixed point math in my game engine. Simulation state is kept in integers so every build on every
+	CPU steps the same game from the same inputs, which replays and lockstep networking depend on. Floating point only stays
+	the same until a compiler fuses a multiply and add or a math library rounds a sine differently, so simulation code uses
+	these instead of float, double and the C math library.
+
+	Fixed is a 16.16 fraction in a Sint32 and angles are FixedAngle, 65536ths of a turn, so they wrap on their own. Sine,
+	cosine and arctangent come from tables built into the program and interpolated with integer math, never from sin or
+	atan2. Everything is plain 32 bit integer work on values laid out side by side, so loops over arrays of them vectorize.
+ */
+
+#pragma once
+#ifndef FIXEDMATH_H
+#define FIXEDMATH_H
+
+#include <SDL.h>
+
+//16.16 fixed point number
+typedef Sint32 Fixed;
+
+//angle in 65536ths of a turn, 0 along positive x and a quarter turn along positive y
+typedef Uint16 FixedAngle;
+
+//fixed point constants
+const int FIXED_SHIFT = 16;
+const Fixed FIXED_ONE = 1 << FIXED_SHIFT;
+const Fixed FIXED_HALF = FIXED_ONE / 2;
+const int FIXED_ANGLE_TURN = 65536;
+const FixedAngle FIXED_ANGLE_QUARTER = 16384;
+const int FIXED_INT_MIN = -32768;				//whole numbers that fit in 16.16
+const int FIXED_INT_MAX = 32767;
+
+//convert whole numbers. Only FIXED_INT_MIN to FIXED_INT_MAX fit, anything past them saturates instead of wrapping
+inline Fixed fixedFromInt(int value) { return (value < FIXED_INT_MIN ? FIXED_INT_MIN : value > FIXED_INT_MAX ? FIXED_INT_MAX : value) * FIXED_ONE; }
+inline int fixedFloor(Fixed value) { return value >> FIXED_SHIFT; }
+inline int fixedTrunc(Fixed value) { return (int)(value >= 0 ? value >> FIXED_SHIFT : -(-(Sint64)value >> FIXED_SHIFT)); }	//toward 0 like casting a float
+inline int fixedRound(Fixed value) { return (int)(((Sint64)value + FIXED_HALF) >> FIXED_SHIFT); }
+
+//convert floats, only for settings loaded from files and for things drawn that don't feed back into simulation
+inline Fixed fixedFromFloat(float value) { return (Fixed)(value * FIXED_ONE + (value >= 0 ? 0.5f : -0.5f)); }
+inline float fixedToFloat(Fixed value) { return value / (float)FIXED_ONE; }
+inline double fixedAngleToDegrees(FixedAngle angle) { return angle * 360.0 / FIXED_ANGLE_TURN; }
+inline double fixedAngleToRadians(FixedAngle angle) { return angle * (2 * M_PI) / FIXED_ANGLE_TURN; }
+
+//multiply and divide through 64 bits so nothing is lost before shifting back. Division by 0 is left to caller
+inline Fixed fixedMul(Fixed a, Fixed b) { return (Fixed)(((Sint64)a * b) >> FIXED_SHIFT); }
+inline Fixed fixedDiv(Fixed a, Fixed b) { return (Fixed)(((Sint64)a * FIXED_ONE) / b); }
+
+//clamp a 64 bit intermediate into Fixed's range instead of wrapping
+inline Fixed fixedSaturate(Sint64 value) { return value < SDL_MIN_SINT32 ? SDL_MIN_SINT32 : value > SDL_MAX_SINT32 ? SDL_MAX_SINT32 : (Fixed)value; }
+
+//square root, 0 for negatives
+Fixed fixedSqrt(Fixed value);
+
+//sine and cosine, within 2/65536 of exact
+Fixed fixedSin(FixedAngle angle);
+inline Fixed fixedCos(FixedAngle angle) { return fixedSin((FixedAngle)(angle + FIXED_ANGLE_QUARTER)); }
+
+//angle of vector from origin to x, y in any units, within two steps of exact. 0 for a zero vector
+FixedAngle fixedAtan2(Sint32 y, Sint32 x);
+
+//2D vector, packed as two 32 bit lanes
+struct FixedVec2
+{
+	Fixed x;
+	Fixed y;
+};
+
+//vector arithmetic
+inline FixedVec2 fixedAdd(FixedVec2 a, FixedVec2 b) { return { a.x + b.x, a.y + b.y }; }
+inline FixedVec2 fixedSub(FixedVec2 a, FixedVec2 b) { return { a.x - b.x, a.y - b.y }; }
+inline FixedVec2 fixedScale(FixedVec2 v, Fixed scale) { return { fixedMul(v.x, scale), fixedMul(v.y, scale) }; }
+inline Fixed fixedDot(FixedVec2 a, FixedVec2 b) { return (Fixed)(((Sint64)a.x * b.x + (Sint64)a.y * b.y) >> FIXED_SHIFT); }
+
+//unit vector pointing at angle
+inline FixedVec2 fixedFromAngle(FixedAngle angle) { return { fixedCos(angle), fixedSin(angle) }; }
+
+//length of vector, without overflowing for any vector whose components fit
+Fixed fixedLength(FixedVec2 v);
+
+//vector of length 1 in same direction, zero vector stays zero
+FixedVec2 fixedNormalize(FixedVec2 v);
+#endif
@@ -0,0 +1,393 @@
+/*
+Title:	FlowField.cpp
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: implementation file for FlowField class for my game engine
+ */
+
+#include "FlowField.h"
+#include "TileMap.h"
+#include <algorithm>
+
+//neighbor offsets, orthogonal first so straight steps win ties
+static const int NEIGHBOR_X[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+static const int NEIGHBOR_Y[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+
+//repair marks
+const Uint8 FLOW_MARK_CLEARED = 1;		//every shortest path ran to a source that moved away
+const Uint8 FLOW_MARK_QUEUED = 2;		//waiting to be checked for clearing
+const Uint8 FLOW_MARK_CHANGED = 4;		//distance changed, so it and its neighbors pick next step again
+
+FlowField::FlowField()
+{
+	//initialize variables
+	columns = 0;
+	rows = 0;
+	sourceCount = 0;
+	obstacles = NULL;
+	obstacleRevision = 0;
+	rebuilds = 0;
+	repairs = 0;
+}
+
+void FlowField::init(int width, int height)
+{
+	columns = (width + FLOW_CELL_SIZE - 1) / FLOW_CELL_SIZE;
+	rows = (height + FLOW_CELL_SIZE - 1) / FLOW_CELL_SIZE;
+
+	int cells = columns * rows;
+	blocked.assign(cells, 0);
+	distance.assign(cells, FLOW_UNREACHED);
+	next.assign(cells, -1);
+	queue.resize(cells);
+	marks.assign(cells, 0);
+	changedCells.reserve(cells);
+	seeds.reserve(cells);
+
+	//force search on next update
+	sourceCount = 0;
+	obstacleRevision = 0;
+}
+
+void FlowField::update(const SDL_Point* sources, int sourceCount)
+{
+	sourceCount = std::min(sourceCount, FLOW_MAX_SOURCES);
+
+	//search everything again if players joined or left
+	bool recount = sourceCount != this->sourceCount;
+
+	//otherwise repair if any player crossed into another cell
+	int oldCells[FLOW_MAX_SOURCES];
+	bool moved = false;
+	for(int i = 0; i < sourceCount; i++)
+	{
+		int cell = cellAt(sources[i]);
+		oldCells[i] = sourceCells[i];
+		moved = moved || cell != sourceCells[i];
+
+		sourcePoints[i] = sources[i];
+		sourceCells[i] = cell;
+	}
+	this->sourceCount = sourceCount;
+
+	//or if tile map streamed chunks in or out
+	if(obstacles != NULL && obstacles->getRevision() != obstacleRevision)
+	{
+		readObstacles();
+		recount = true;
+	}
+
+	if(recount)
+	{
+		rebuild();
+	}
+	else if(moved)
+	{
+		repair(oldCells);
+	}
+}
+
+SDL_Point FlowField::steer(SDL_Point from) const
+{
+	//no players, stay put
+	if(sourceCount == 0 || columns == 0)
+	{
+		return from;
+	}
+
+	int cell = cellAt(from);
+
+	//blocked or cut off cells head straight for first player
+	if(distance[cell] == FLOW_UNREACHED)
+	{
+		return sourcePoints[0];
+	}
+
+	//in or next to player's cell, go straight for player
+	if(distance[cell] <= 1)
+	{
+		return sourcePoints[std::max(sourceIn(next[cell]), 0)];
+	}
+
+	//otherwise head for center of next cell
+	int step = next[cell];
+	return { (step % columns) * FLOW_CELL_SIZE + FLOW_CELL_SIZE / 2, (step / columns) * FLOW_CELL_SIZE + FLOW_CELL_SIZE / 2 };
+}
+
+int FlowField::cellAt(SDL_Point at) const
+{
+	int column = std::clamp(at.x / FLOW_CELL_SIZE, 0, columns - 1);
+	int row = std::clamp(at.y / FLOW_CELL_SIZE, 0, rows - 1);
+
+	return row * columns + column;
+}
+
+void FlowField::readObstacles()
+{
+	obstacleRevision = obstacles->getRevision();
+
+	//cell is blocked if tile under its center is solid
+	for(int row = 0; row < rows; row++)
+	{
+		for(int column = 0; column < columns; column++)
+		{
+			blocked[row * columns + column] = obstacles->isSolidAt(column * FLOW_CELL_SIZE + FLOW_CELL_SIZE / 2, row * FLOW_CELL_SIZE + FLOW_CELL_SIZE / 2);
+		}
+	}
+}
+
+int FlowField::stepTo(int cell, int direction) const
+{
+	int column = cell % columns;
+	int row = cell / columns;
+	int x = column + NEIGHBOR_X[direction];
+	int y = row + NEIGHBOR_Y[direction];
+
+	if(x < 0 || y < 0 || x >= columns || y >= rows || blocked[y * columns + x])
+	{
+		return -1;
+	}
+
+	//diagonal steps need both sides open so enemies don't clip solid corners
+	if(NEIGHBOR_X[direction] != 0 && NEIGHBOR_Y[direction] != 0 && (blocked[row * columns + x] || blocked[y * columns + column]))
+	{
+		return -1;
+	}
+
+	return y * columns + x;
+}
+
+int FlowField::stepFrom(int cell, int direction) const
+{
+	int column = cell % columns;
+	int row = cell / columns;
+	int x = column + NEIGHBOR_X[direction];
+	int y = row + NEIGHBOR_Y[direction];
+
+	//only players stand in blocked cells, and nothing steps into them. Neighbor may be blocked if a player is there
+	if(x < 0 || y < 0 || x >= columns || y >= rows || blocked[cell])
+	{
+		return -1;
+	}
+
+	if(NEIGHBOR_X[direction] != 0 && NEIGHBOR_Y[direction] != 0 && (blocked[row * columns + x] || blocked[y * columns + column]))
+	{
+		return -1;
+	}
+
+	return y * columns + x;
+}
+
+void FlowField::pickNext(int cell)
+{
+	if(distance[cell] == FLOW_UNREACHED)
+	{
+		next[cell] = -1;
+		return;
+	}
+
+	if(distance[cell] == 0)
+	{
+		next[cell] = cell;
+		return;
+	}
+
+	//first neighbor in fixed order, not whichever search reached first, so full and repaired fields agree
+	next[cell] = -1;
+	for(int i = 0; i < 8; i++)
+	{
+		int neighbor = stepFrom(cell, i);
+		if(neighbor >= 0 && distance[neighbor] == distance[cell] - 1)
+		{
+			next[cell] = neighbor;
+			return;
+		}
+	}
+}
+
+int FlowField::sourceIn(int cell) const
+{
+	for(int i = 0; i < sourceCount; i++)
+	{
+		if (sourceCells[i] == cell) { return i; }
+	}
+
+	return -1;
+}
+
+void FlowField::rebuild()
+{
+	std::fill(distance.begin(), distance.end(), FLOW_UNREACHED);
+
+	int head = 0;
+	int tail = 0;
+
+	//seed search with every player's cell
+	for(int i = 0; i < sourceCount; i++)
+	{
+		int cell = sourceCells[i];
+
+		if(distance[cell] == FLOW_UNREACHED)
+		{
+			distance[cell] = 0;
+			queue[tail++] = cell;
+		}
+	}
+
+	//breadth first search over open cells, 8 way without cutting blocked corners
+	while(head < tail)
+	{
+		int cell = queue[head++];
+
+		for(int i = 0; i < 8; i++)
+		{
+			int neighbor = stepTo(cell, i);
+
+			//first visit is shortest
+			if(neighbor >= 0 && distance[neighbor] == FLOW_UNREACHED)
+			{
+				distance[neighbor] = distance[cell] + 1;
+				queue[tail++] = neighbor;
+			}
+		}
+	}
+
+	for (int cell = 0; cell < columns * rows; cell++) { pickNext(cell); }
+
+	rebuilds++;
+}
+
+void FlowField::repair(const int* oldCells)
+{
+	int head = 0;
+	int tail = 0;
+	changedCells.clear();
+	seeds.clear();
+
+	//old cells no players are in anymore start the clearing
+	for(int i = 0; i < sourceCount; i++)
+	{
+		int cell = oldCells[i];
+
+		if(sourceIn(cell) < 0 && !(marks[cell] & FLOW_MARK_QUEUED))
+		{
+			marks[cell] |= FLOW_MARK_QUEUED;
+			queue[tail++] = cell;
+		}
+	}
+
+	//clear outward in distance order. A cell is cleared once no neighbor a step closer is left standing
+	while(head < tail)
+	{
+		int cell = queue[head++];
+		bool supported = false;
+
+		if(distance[cell] > 0)
+		{
+			for(int i = 0; i < 8 && !supported; i++)
+			{
+				int neighbor = stepFrom(cell, i);
+				supported = neighbor >= 0 && distance[neighbor] == distance[cell] - 1 && !(marks[neighbor] & FLOW_MARK_CLEARED);
+			}
+		}
+
+		if(supported)
+		{
+			continue;
+		}
+
+		marks[cell] |= FLOW_MARK_CLEARED;
+		for(int i = 0; i < 8; i++)
+		{
+			int neighbor = stepTo(cell, i);
+			if(neighbor >= 0 && distance[neighbor] == distance[cell] + 1 && !(marks[neighbor] & FLOW_MARK_QUEUED))
+			{
+				marks[neighbor] |= FLOW_MARK_QUEUED;
+				queue[tail++] = neighbor;
+			}
+		}
+	}
+
+	//cleared cells are filled back in from standing neighbors around them
+	for(int i = 0; i < tail; i++)
+	{
+		int cell = queue[i];
+		if (!(marks[cell] & FLOW_MARK_CLEARED)) { continue; }
+
+		for(int j = 0; j < 8; j++)
+		{
+			int neighbor = stepFrom(cell, j);
+			if (neighbor >= 0 && distance[neighbor] != FLOW_UNREACHED && !(marks[neighbor] & FLOW_MARK_CLEARED)) { seeds.push_back({ distance[neighbor], neighbor }); }
+		}
+	}
+
+	for(int i = 0; i < tail; i++)
+	{
+		int cell = queue[i];
+		if(marks[cell] & FLOW_MARK_CLEARED)
+		{
+			distance[cell] = FLOW_UNREACHED;
+			marks[cell] |= FLOW_MARK_CHANGED;
+			changedCells.push_back(cell);
+		}
+		marks[cell] &= ~(FLOW_MARK_CLEARED | FLOW_MARK_QUEUED);
+	}
+
+	//and from cells players moved into
+	for(int i = 0; i < sourceCount; i++)
+	{
+		int cell = sourceCells[i];
+		if (distance[cell] == 0) { continue; }
+
+		distance[cell] = 0;
+		if (!(marks[cell] & FLOW_MARK_CHANGED)) { marks[cell] |= FLOW_MARK_CHANGED; changedCells.push_back(cell); }
+		seeds.push_back({ 0, cell });
+	}
+
+	//search from starting cells in distance order, merging sorted starts with the queue so both go out nearest first.
+	//Steps only ever shorten a cell's distance, which also carries new cells' pull into fields of players that didn't move
+	std::sort(seeds.begin(), seeds.end());
+	size_t seed = 0;
+	head = 0;
+	tail = 0;
+	while(seed < seeds.size() || head < tail)
+	{
+		int cell;
+		if(head == tail || (seed < seeds.size() && seeds[seed].first <= distance[queue[head]]))
+		{
+			//starting cells beaten by a nearer one already went out from there
+			cell = seeds[seed].second;
+			if (distance[cell] != seeds[seed++].first) { continue; }
+		}
+		else
+		{
+			cell = queue[head++];
+		}
+
+		for(int i = 0; i < 8; i++)
+		{
+			int neighbor = stepTo(cell, i);
+			if(neighbor >= 0 && distance[cell] + 1 < distance[neighbor])
+			{
+				distance[neighbor] = distance[cell] + 1;
+				if (!(marks[neighbor] & FLOW_MARK_CHANGED)) { marks[neighbor] |= FLOW_MARK_CHANGED; changedCells.push_back(neighbor); }
+				queue[tail++] = neighbor;
+			}
+		}
+	}
+
+	//changed cells and their neighbors pick next step again
+	for(int cell : changedCells)
+	{
+		pickNext(cell);
+		for(int i = 0; i < 8; i++)
+		{
+			int neighbor = stepTo(cell, i);
+			if (neighbor >= 0) { pickNext(neighbor); }
+		}
+	}
+
+	for (int cell : changedCells) { marks[cell] = 0; }
+
+	repairs++;
+}
@@ -0,0 +1,109 @@
+/*
+Title:	FlowField.h
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: header file for FlowField class for my game engine. Splits the play area into a grid and searches out from every
+	player, so every enemy steers with a single cell lookup instead of searching for players itself. Solid tiles from the tile
+	map block cells, and enemies path around them.
+
+	When a player changes cell only the part of the field that depended on where they were is searched again: cells whose
+	shortest paths all ran to the old cell are cleared, then filled back in from the cleared area's edge and the new cell.
+	Each cell's next step is the first neighbor in a fixed order that is one step closer, so a repaired field is exactly the
+	one a full search would build and replays don't depend on which of the two ran.
+ */
+
+#pragma once
+#ifndef FLOWFIELD_H
+#define FLOWFIELD_H
+
+#include <SDL.h>
+#include <vector>
+
+//flow field constants
+const int FLOW_CELL_SIZE = 32;			//cell edge in pixels
+const int FLOW_MAX_SOURCES = 32;		//most players field is built from
+const Uint16 FLOW_UNREACHED = 0xFFFF;	//distance of blocked or unreachable cells
+
+//forward declaration
+class TileMap;
+
+class FlowField
+{
+public:
+	//initialize variables
+	FlowField();
+
+	//size grid to cover area in pixels
+	void init(int width, int height);
+
+	//set tile map solid tiles are read from, NULL for none
+	void setObstacles(const TileMap* map) { obstacles = map; obstacleRevision = 0; }
+
+	//update field for player centers. Field is repaired when players change cell, searched again in full when number of
+	//players or obstacles change
+	void update(const SDL_Point* sources, int sourceCount);
+
+	//point an enemy at from should head for. Next cell's center, or the player itself once close
+	SDL_Point steer(SDL_Point from) const;
+
+	//getters
+	int getRebuilds() const { return rebuilds; }	//get number of times full search has run
+	int getRepairs() const { return repairs; }		//get number of times field was repaired around moved players
+	Uint16 getDistance(SDL_Point at) const { return distance[cellAt(at)]; }	//get distance in cells from nearest player
+
+private:
+	//index of cell holding point, clamped to grid
+	int cellAt(SDL_Point at) const;
+
+	//read blocked cells from tile map
+	void readObstacles();
+
+	//search out from source cells and pick each cell's next step
+	void rebuild();
+
+	//search again only around source cells that changed, given cells sources were in before
+	void repair(const int* oldCells);
+
+	//neighbor of cell in direction if it can be stepped to, -1 if off grid, blocked or cutting a corner
+	int stepTo(int cell, int direction) const;
+
+	//neighbor of cell in direction if cell can be stepped to from it, -1 if not. Differs from stepTo at blocked cells
+	int stepFrom(int cell, int direction) const;
+
+	//pick first neighbor one step closer to a source
+	void pickNext(int cell);
+
+	//index of first source in cell, -1 if none
+	int sourceIn(int cell) const;
+
+	//grid size in cells
+	int columns;
+	int rows;
+
+	//per cell blocked flag, distance to nearest source and next cell toward it
+	std::vector<Uint8> blocked;
+	std::vector<Uint16> distance;
+	std::vector<int> next;
+
+	//search queue, kept to avoid allocating each rebuild
+	std::vector<int> queue;
+
+	//repair scratch, kept like queue. Per cell FLOW_MARK_ bits, cells whose distance changed and sorted starting cells
+	std::vector<Uint8> marks;
+	std::vector<int> changedCells;
+	std::vector<std::pair<Uint16, int>> seeds;
+
+	//current source points and the cells they were last searched from
+	SDL_Point sourcePoints[FLOW_MAX_SOURCES];
+	int sourceCells[FLOW_MAX_SOURCES];
+	int sourceCount;
+
+	//tile map obstacles come from and its revision when last read
+	const TileMap* obstacles;
+	Uint32 obstacleRevision;
+
+	//number of full searches and repairs run
+	int rebuilds;
+	int repairs;
+};
+#endif
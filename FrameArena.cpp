@@ -0,0 +1,125 @@
+/*
+Title:	FrameArena.cpp
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: implementation file for FrameArena class for my game engine
+ */
+
+#include "FrameArena.h"
+#include "MemTrack.h"
+#include <algorithm>
+#include <cstdint>
+
+FrameArena frameArena;
+
+FrameArena::FrameArena()
+{
+	//initialize variables
+	block = NULL;
+	capacity = 0;
+	used = 0;
+	frameBytes = 0;
+	peak = 0;
+	overflows = 0;
+}
+
+FrameArena::~FrameArena()
+{
+	free();
+}
+
+bool FrameArena::init(size_t capacity)
+{
+	free();
+
+	block = (Uint8*)SDL_SIMDAlloc(capacity);
+	if(block == NULL)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Unable to allocate %zu byte frame arena!\n", capacity);
+		return false;
+	}
+
+	memTrackAlloc(MEM_ARENA, capacity);
+	this->capacity = capacity;
+
+	//room to note overflows without growing mid frame
+	overflow.reserve(64);
+
+	return true;
+}
+
+void FrameArena::free()
+{
+	for (void* pointer : overflow) { SDL_SIMDFree(pointer); }
+	overflow.clear();
+
+	if(block != NULL)
+	{
+		memTrackFree(MEM_ARENA, capacity);
+	}
+
+	SDL_SIMDFree(block);
+	block = NULL;
+	capacity = 0;
+	used = 0;
+	frameBytes = 0;
+	peak = 0;
+	overflows = 0;
+}
+
+void* FrameArena::alloc(size_t bytes, size_t align)
+{
+	frameBytes += bytes + align - 1;
+
+	//align address, block may be aligned less than asked
+	if(block != NULL)
+	{
+		uintptr_t start = ((uintptr_t)(block + used) + align - 1) & ~(uintptr_t)(align - 1);
+		if(start + bytes <= (uintptr_t)(block + capacity))
+		{
+			used = start + bytes - (uintptr_t)block;
+			return (void*)start;
+		}
+	}
+
+	//SIMD alignment covers any type's
+	void* pointer = SDL_SIMDAlloc(std::max(bytes, (size_t)1));
+	overflow.push_back(pointer);
+	overflows++;
+
+	return pointer;
+}
+
+void FrameArena::release(void* pointer, size_t bytes)
+{
+	//last allocation can be handed out again, such as a temporary finished with before anything else was allocated
+	if (block != NULL && (Uint8*)pointer + bytes == block + used) { used -= bytes; }
+}
+
+void FrameArena::reset()
+{
+	for (void* pointer : overflow) { SDL_SIMDFree(pointer); }
+
+	//grow so all of a frame like this one fits next time, block is empty now
+	if(!overflow.empty() && block != NULL)
+	{
+		size_t grown = std::max(capacity * 2, frameBytes);
+		Uint8* larger = (Uint8*)SDL_SIMDAlloc(grown);
+
+		if(larger != NULL)
+		{
+			SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_WARN, "Frame arena overflowed %zu bytes, growing to %zu\n", capacity, grown);
+
+			memTrackFree(MEM_ARENA, capacity);
+			memTrackAlloc(MEM_ARENA, grown);
+			SDL_SIMDFree(block);
+			block = larger;
+			capacity = grown;
+		}
+	}
+
+	overflow.clear();
+	peak = std::max(peak, frameBytes);
+	used = 0;
+	frameBytes = 0;
+}
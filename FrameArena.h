@@ -0,0 +1,101 @@
+/*
+Title:	FrameArena.h
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: header file for FrameArena class for my game engine. A linear allocator for data that only lives for one frame.
+	Allocating bumps a pointer through one block and freeing does nothing, the whole block is reset at the end of the frame.
+	Anything that doesn't fit comes from the heap until reset, which then grows the block so it fits next time. FrameAllocator
+	lets STL containers allocate from it, so frame temporaries don't touch the heap once play has settled. Main thread only.
+ */
+
+#pragma once
+#ifndef FRAMEARENA_H
+#define FRAMEARENA_H
+
+#include <SDL.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+//frame arena constants
+const size_t FRAME_ARENA_BYTES = 256 * 1024;	//starting block size
+
+class FrameArena
+{
+public:
+	//initialize variables
+	FrameArena();
+
+	//destructor
+	~FrameArena();
+
+	//allocate block of capacity bytes
+	bool init(size_t capacity);
+
+	//deallocates resources
+	void free();
+
+	//get bytes aligned to align, a power of 2, good until next reset
+	void* alloc(size_t bytes, size_t align = alignof(std::max_align_t));
+
+	//give back bytes from alloc, only reclaimed if nothing was allocated after them
+	void release(void* pointer, size_t bytes);
+
+	//free everything allocated this frame, call once at end of each frame
+	void reset();
+
+	//getters
+	size_t getCapacity() const { return capacity; }
+	size_t getUsed() const { return used; }
+	size_t getPeak() const { return peak; }				//get most bytes asked for in one frame
+	int getOverflows() const { return overflows; }		//get allocations that didn't fit since init
+
+private:
+	//block allocations come from, and bytes of it used this frame
+	Uint8* block;
+	size_t capacity;
+	size_t used;
+
+	//bytes asked for this frame including ones that didn't fit, and most of any frame
+	size_t frameBytes;
+	size_t peak;
+
+	//heap allocations made when block was full, freed at reset
+	std::vector<void*> overflow;
+	int overflows;
+};
+
+//arena reset at end of every frame
+extern FrameArena frameArena;
+
+//STL allocator drawing from frame arena. Containers using it must not outlive the frame
+template <typename T>
+class FrameAllocator
+{
+public:
+	typedef T value_type;
+
+	FrameAllocator(FrameArena* arena = &frameArena) : arena(arena) {}
+	template <typename U>
+	FrameAllocator(const FrameAllocator<U>& other) : arena(other.getArena()) {}
+
+	T* allocate(size_t count) { return (T*)arena->alloc(count * sizeof(T), alignof(T)); }
+	void deallocate(T* pointer, size_t count) { arena->release(pointer, count * sizeof(T)); }
+
+	FrameArena* getArena() const { return arena; }
+
+	template <typename U>
+	bool operator==(const FrameAllocator<U>& other) const { return arena == other.getArena(); }
+	template <typename U>
+	bool operator!=(const FrameAllocator<U>& other) const { return arena != other.getArena(); }
+
+private:
+	FrameArena* arena;
+};
+
+//containers for frame temporaries
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+typedef std::basic_string<char, std::char_traits<char>, FrameAllocator<char>> FrameString;
+
+#endif
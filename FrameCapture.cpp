@@ -0,0 +1,270 @@
+/*
+Title:	FrameCapture.cpp
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: implementation file for FrameCapture class for my game engine
+ */
+
+#include "FrameCapture.h"
+#include "MemTrack.h"
+#include <SDL_image.h>
+#include <algorithm>
+
+FrameCapture::FrameCapture()
+{
+	//initialize variables
+	for(Uint32 i = 0; i < CAPTURE_BUFFERS; i++)
+	{
+		buffers[i] = NULL;
+		frameNumbers[i] = 0;
+	}
+	head = 0;
+	tail = 0;
+	stopping = false;
+	y4m = false;
+	stream = NULL;
+	planes = NULL;
+	width = 0;
+	height = 0;
+	every = 1;
+	frame = 0;
+	written = 0;
+	dropped = 0;
+	readCounts = 0;
+	reads = 0;
+}
+
+FrameCapture::~FrameCapture()
+{
+	stop();
+}
+
+bool FrameCapture::start(std::string path, int width, int height, int fps, int every)
+{
+	stop();
+
+	this->path = path;
+	this->width = width;
+	this->height = height;
+	this->every = every > 0 ? every : 1;
+	y4m = path.size() >= 4 && path.compare(path.size() - 4, 4, ".y4m") == 0;
+
+	//raw stream gets its header now, frames are appended as they are written
+	if(y4m)
+	{
+		stream = fopen(path.c_str(), "wb");
+		if(stream == NULL)
+		{
+			SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Unable to open capture file %s!\n", path.c_str());
+			return false;
+		}
+
+		//full range BT.601, chroma halved both ways
+		fprintf(stream, "YUV4MPEG2 W%d H%d F%d:%d Ip A1:1 C420jpeg\n", width, height, fps, this->every);
+
+		planes = new Uint8[(size_t)width * height + 2 * (size_t)((width + 1) / 2) * ((height + 1) / 2)];
+	}
+
+	//all buffers up front so capturing never allocates
+	for(Uint32 i = 0; i < CAPTURE_BUFFERS; i++)
+	{
+		buffers[i] = new Uint32[(size_t)width * height];
+	}
+	memTrackAlloc(MEM_CAPTURE, (size_t)width * height * sizeof(Uint32) * CAPTURE_BUFFERS);
+
+	head = 0;
+	tail = 0;
+	stopping = false;
+	frame = 0;
+	written = 0;
+	dropped = 0;
+	readCounts = 0;
+	reads = 0;
+
+	writer = std::thread(&FrameCapture::writerLoop, this);
+
+	SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "Capturing every %d frames to %s\n", this->every, path.c_str());
+
+	return true;
+}
+
+void FrameCapture::stop()
+{
+	if(!isActive())
+	{
+		return;
+	}
+
+	//writer exits once ring is empty
+	{
+		std::lock_guard<std::mutex> lock(writerMutex);
+		stopping = true;
+	}
+	frameReady.notify_one();
+	writer.join();
+
+	if(stream != NULL)
+	{
+		fclose(stream);
+		stream = NULL;
+	}
+
+	double readMs = reads > 0 ? readCounts * 1000.0 / SDL_GetPerformanceFrequency() / reads : 0;
+	SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "Captured %u frames to %s, %u dropped, %.3f ms average readback\n",
+		getWritten(), path.c_str(), dropped, readMs);
+
+	for(Uint32 i = 0; i < CAPTURE_BUFFERS; i++)
+	{
+		delete[] buffers[i];
+		buffers[i] = NULL;
+	}
+	memTrackFree(MEM_CAPTURE, (size_t)width * height * sizeof(Uint32) * CAPTURE_BUFFERS);
+
+	delete[] planes;
+	planes = NULL;
+}
+
+void FrameCapture::capture(SDL_Renderer* renderer)
+{
+	if(!isActive())
+	{
+		return;
+	}
+
+	//only every nth frame
+	Uint32 frameNumber = frame++;
+	if(frameNumber % every != 0)
+	{
+		return;
+	}
+
+	//drop frame rather than wait on writer
+	Uint32 slot = head.load(std::memory_order_relaxed);
+	if(slot - tail.load(std::memory_order_acquire) >= CAPTURE_BUFFERS)
+	{
+		dropped++;
+		return;
+	}
+
+	Uint64 startCount = SDL_GetPerformanceCounter();
+
+	Uint32 index = slot & (CAPTURE_BUFFERS - 1);
+	if(SDL_RenderReadPixels(renderer, NULL, SDL_PIXELFORMAT_ARGB8888, buffers[index], width * sizeof(Uint32)) != 0)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_WARN, "Unable to read back frame! SDL Error: %s\n", SDL_GetError());
+		dropped++;
+		return;
+	}
+	frameNumbers[index] = frameNumber;
+
+	readCounts += SDL_GetPerformanceCounter() - startCount;
+	reads++;
+
+	//publish buffer, then wake writer. Taking the lock makes sure writer isn't between checking and sleeping
+	head.store(slot + 1, std::memory_order_release);
+	{
+		std::lock_guard<std::mutex> lock(writerMutex);
+	}
+	frameReady.notify_one();
+}
+
+void FrameCapture::writerLoop()
+{
+	while(true)
+	{
+		Uint32 slot = tail.load(std::memory_order_relaxed);
+
+		{
+			std::unique_lock<std::mutex> lock(writerMutex);
+
+			//sleep until a frame is waiting or capture is stopping
+			frameReady.wait(lock, [this, slot] { return stopping || head.load(std::memory_order_acquire) != slot; });
+
+			//exit only after ring has drained
+			if(head.load(std::memory_order_acquire) == slot)
+			{
+				return;
+			}
+		}
+
+		//encode outside of lock
+		Uint32 index = slot & (CAPTURE_BUFFERS - 1);
+		bool success = y4m ? writeY4m(buffers[index]) : writePng(buffers[index], frameNumbers[index]);
+		if (success) { written.fetch_add(1, std::memory_order_relaxed); }
+
+		//hand buffer back to game thread
+		tail.store(slot + 1, std::memory_order_release);
+	}
+}
+
+bool FrameCapture::writePng(const Uint32* pixels, Uint32 frameNumber)
+{
+	char fileName[32];
+	snprintf(fileName, sizeof(fileName), "_%06u.png", frameNumber);
+
+	//wrap buffer without copying. Alpha is ignored since cleared areas of a frame aren't always opaque
+	SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormatFrom((void*)pixels, width, height, 32, width * sizeof(Uint32), SDL_PIXELFORMAT_RGB888);
+	if(surface == NULL)
+	{
+		return false;
+	}
+
+	bool success = IMG_SavePNG(surface, (path + fileName).c_str()) == 0;
+	if(!success)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Unable to save %s%s! SDL Error: %s\n", path.c_str(), fileName, IMG_GetError());
+	}
+
+	SDL_FreeSurface(surface);
+	return success;
+}
+
+bool FrameCapture::writeY4m(const Uint32* pixels)
+{
+	int chromaWidth = (width + 1) / 2;
+	int chromaHeight = (height + 1) / 2;
+	Uint8* lumaPlane = planes;
+	Uint8* bluePlane = planes + width * height;
+	Uint8* redPlane = bluePlane + chromaWidth * chromaHeight;
+
+	//luma for every pixel
+	for(int i = 0; i < width * height; i++)
+	{
+		int red = (pixels[i] >> 16) & 0xFF, green = (pixels[i] >> 8) & 0xFF, blue = pixels[i] & 0xFF;
+		lumaPlane[i] = (Uint8)((77 * red + 150 * green + 29 * blue + 128) >> 8);
+	}
+
+	//chroma from average of each 2x2 block, repeating last row and column when size is odd
+	for(int y = 0; y < chromaHeight; y++)
+	{
+		const Uint32* top = pixels + (2 * y) * width;
+		const Uint32* bottom = pixels + std::min(2 * y + 1, height - 1) * width;
+
+		for(int x = 0; x < chromaWidth; x++)
+		{
+			int left = 2 * x, right = std::min(2 * x + 1, width - 1);
+			Uint32 block[4] = { top[left], top[right], bottom[left], bottom[right] };
+			int red = 0, green = 0, blue = 0;
+
+			for(Uint32 pixel : block)
+			{
+				red += (pixel >> 16) & 0xFF;
+				green += (pixel >> 8) & 0xFF;
+				blue += pixel & 0xFF;
+			}
+
+			//sums are 4x, folded into the shift
+			bluePlane[y * chromaWidth + x] = (Uint8)(((-43 * red - 85 * green + 128 * blue + 512) >> 10) + 128);
+			redPlane[y * chromaWidth + x] = (Uint8)(((128 * red - 107 * green - 21 * blue + 512) >> 10) + 128);
+		}
+	}
+
+	size_t size = (size_t)width * height + 2 * (size_t)chromaWidth * chromaHeight;
+	if(fputs("FRAME\n", stream) < 0 || fwrite(planes, 1, size, stream) != size)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Unable to write frame to %s!\n", path.c_str());
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,90 @@
+/*
+Title:	FrameCapture.h
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: header file for FrameCapture class for my game engine. Records rendered frames for reviewing perf regressions and
+	visual diffs offline. The game thread only copies each captured frame into a free buffer of a preallocated ring, and a
+	writer thread encodes it to a numbered PNG or appends it to a raw Y4M stream. When the writer falls behind, frames are
+	dropped instead of stalling the game.
+ */
+
+#pragma once
+#ifndef FRAMECAPTURE_H
+#define FRAMECAPTURE_H
+
+#include <SDL.h>
+#include <string>
+#include <cstdio>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+//capture constants
+const Uint32 CAPTURE_BUFFERS = 4;	//frames waiting to be written, must be a power of 2
+
+class FrameCapture
+{
+public:
+	//initialize variables
+	FrameCapture();
+
+	//destructor
+	~FrameCapture();
+
+	//start capturing every nth frame of a width x height renderer running at fps. A path ending in .y4m is written as
+	//one raw video stream, any other path is a prefix for PNGs numbered by frame
+	bool start(std::string path, int width, int height, int fps, int every = 1);
+
+	//write out waiting frames and stop writer thread
+	void stop();
+
+	//read back frame drawn to renderer, call before presenting it
+	void capture(SDL_Renderer* renderer);
+
+	//getters
+	bool isActive() const { return writer.joinable(); }
+	Uint32 getWritten() const { return written.load(std::memory_order_relaxed); }	//get frames written out
+	Uint32 getDropped() const { return dropped; }									//get frames lost to a full ring
+
+private:
+	//loop writer thread runs until stopped
+	void writerLoop();
+
+	//encode frame and write it out, returns false on error
+	bool writePng(const Uint32* pixels, Uint32 frameNumber);
+	bool writeY4m(const Uint32* pixels);
+
+	//frame buffers, ARGB with width pixels per row, and frame number each holds
+	Uint32* buffers[CAPTURE_BUFFERS];
+	Uint32 frameNumbers[CAPTURE_BUFFERS];
+
+	//next buffer game thread fills and writer writes, only ever increase
+	alignas(64) std::atomic<Uint32> head;
+	alignas(64) std::atomic<Uint32> tail;
+
+	//writer thread and what wakes it
+	std::thread writer;
+	std::mutex writerMutex;
+	std::condition_variable frameReady;
+	bool stopping;
+
+	//output
+	std::string path;
+	bool y4m;
+	FILE* stream;
+	Uint8* planes;	//Y, U and V planes of frame being written to stream
+
+	//frame size and how often to capture
+	int width;
+	int height;
+	int every;
+	Uint32 frame;
+
+	//stats
+	std::atomic<Uint32> written;
+	Uint32 dropped;
+	Uint64 readCounts;
+	Uint32 reads;
+};
+#endif
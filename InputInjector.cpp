@@ -0,0 +1,116 @@
+/*
+Title:	InputInjector.cpp
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: implementation file for InputInjector class for my game engine
+ */
+
+#include "InputInjector.h"
+#include "Scene.h"
+
+//keys injector presses, movement ones so the player visibly responds
+static const SDL_Scancode INJECTED_KEYS[4] = { SDL_SCANCODE_W, SDL_SCANCODE_A, SDL_SCANCODE_S, SDL_SCANCODE_D };
+
+InputInjector::InputInjector()
+{
+	//initialize variables
+	running.store(false);
+	injected.store(0);
+	intervalMs = 1;
+	buttonHeld = false;
+	for (bool& held : keysHeld) { held = false; }
+}
+
+InputInjector::~InputInjector()
+{
+	stop();
+}
+
+void InputInjector::start(int intervalMs, Uint64 seed)
+{
+	//don't start twice
+	if(running.load())
+	{
+		return;
+	}
+
+	this->intervalMs = intervalMs > 0 ? intervalMs : 1;
+	rng.seed(seed);
+	injected.store(0);
+	running.store(true);
+
+	thread = std::thread(&InputInjector::injectLoop, this);
+}
+
+void InputInjector::stop()
+{
+	running.store(false);
+
+	if(thread.joinable())
+	{
+		thread.join();
+	}
+}
+
+void InputInjector::injectLoop()
+{
+	while(running.load())
+	{
+		injectOne();
+
+		//anywhere from no wait to twice interval, so events don't line up with frames
+		SDL_Delay((Uint32)rng.range(intervalMs * 2 + 1));
+	}
+
+	//let go of anything held so game isn't left moving or firing
+	for(int i = 0; i < 4; i++)
+	{
+		if (!keysHeld[i]) { continue; }
+
+		SDL_Event event = {};
+		event.type = SDL_KEYUP;
+		event.key.keysym.scancode = INJECTED_KEYS[i];
+		SDL_PushEvent(&event);
+		keysHeld[i] = false;
+	}
+
+	if(buttonHeld)
+	{
+		SDL_Event event = {};
+		event.type = SDL_MOUSEBUTTONUP;
+		event.button.button = SDL_BUTTON_LEFT;
+		SDL_PushEvent(&event);
+		buttonHeld = false;
+	}
+}
+
+void InputInjector::injectOne()
+{
+	SDL_Event event = {};
+	int pick = rng.range(10);
+
+	if(pick < 6)
+	{
+		//aim somewhere on screen
+		event.type = SDL_MOUSEMOTION;
+		event.motion.x = rng.range(SCREEN_WIDTH);
+		event.motion.y = rng.range(SCREEN_HEIGHT);
+	}
+	else if(pick < 9)
+	{
+		//press or release a movement key
+		int key = rng.range(4);
+		event.type = keysHeld[key] ? SDL_KEYUP : SDL_KEYDOWN;
+		event.key.keysym.scancode = INJECTED_KEYS[key];
+		keysHeld[key] = !keysHeld[key];
+	}
+	else
+	{
+		//press or release fire
+		event.type = buttonHeld ? SDL_MOUSEBUTTONUP : SDL_MOUSEBUTTONDOWN;
+		event.button.button = SDL_BUTTON_LEFT;
+		buttonHeld = !buttonHeld;
+	}
+
+	if (SDL_PushEvent(&event) == 1) { injected++; }
+}
@@ -0,0 +1,57 @@
+/*
+Title:	InputInjector.h
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: header file for InputInjector class for my game engine. Pushes synthetic keyboard and mouse events into SDL from a
+	thread of its own at jittered times, so they arrive at any point in a frame the way a real device's do. Events go through
+	SDL's queue and the scene's event watch like real ones, so input to present latency can be measured headless.
+ */
+
+#pragma once
+#ifndef INPUTINJECTOR_H
+#define INPUTINJECTOR_H
+
+#include <SDL.h>
+#include <atomic>
+#include <thread>
+#include "Random.h"
+
+class InputInjector
+{
+public:
+	//initialize variables
+	InputInjector();
+
+	//destructor
+	~InputInjector();
+
+	//start pushing an event every intervalMs on average
+	void start(int intervalMs, Uint64 seed);
+
+	//stop pushing and join thread
+	void stop();
+
+	//getters
+	bool isRunning() const { return running.load(); }
+	Uint32 getInjected() const { return injected.load(); }	//get events pushed since start
+
+private:
+	//loop thread runs until stopped
+	void injectLoop();
+
+	//push one event, moving mouse most of the time and otherwise pressing or releasing a key or button
+	void injectOne();
+
+	std::thread thread;
+	std::atomic<bool> running;
+	std::atomic<Uint32> injected;
+	int intervalMs;
+
+	//picks events and delays, only used by thread
+	Random rng;
+
+	//keys and button injector is holding
+	bool keysHeld[4];
+	bool buttonHeld;
+};
+#endif
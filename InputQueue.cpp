@@ -0,0 +1,83 @@
+/*
+Title:	InputQueue.cpp
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: implementation file for InputQueue class for my game engine
+ */
+
+#include "InputQueue.h"
+
+InputQueue::InputQueue()
+{
+	//initialize variables
+	head.store(0);
+	tail.store(0);
+	dropped.store(0);
+	pushLock = 0;
+}
+
+bool InputQueue::push(const SDL_Event& event)
+{
+	//one producer at a time
+	SDL_AtomicLock(&pushLock);
+
+	Uint32 writeIndex = head.load(std::memory_order_relaxed);
+
+	//full when producer is a whole ring ahead of consumer
+	if(writeIndex - tail.load(std::memory_order_acquire) >= INPUT_QUEUE_SIZE)
+	{
+		SDL_AtomicUnlock(&pushLock);
+		dropped.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	InputEvent& slot = events[writeIndex & (INPUT_QUEUE_SIZE - 1)];
+	slot.event = event;
+	slot.time = SDL_GetPerformanceCounter();
+
+	//publish slot to consumer
+	head.store(writeIndex + 1, std::memory_order_release);
+	SDL_AtomicUnlock(&pushLock);
+
+	return true;
+}
+
+bool InputQueue::pop(InputEvent& out)
+{
+	Uint32 readIndex = tail.load(std::memory_order_relaxed);
+
+	if(readIndex == head.load(std::memory_order_acquire))
+	{
+		return false;
+	}
+
+	out = events[readIndex & (INPUT_QUEUE_SIZE - 1)];
+
+	//hand slot back to producer
+	tail.store(readIndex + 1, std::memory_order_release);
+
+	return true;
+}
+
+int InputQueue::eventWatch(void* userdata, SDL_Event* event)
+{
+	//only events the game handles are queued
+	switch(event->type)
+	{
+	case SDL_QUIT:
+	case SDL_WINDOWEVENT:
+	case SDL_KEYDOWN:
+	case SDL_KEYUP:
+	case SDL_MOUSEMOTION:
+	case SDL_MOUSEBUTTONDOWN:
+	case SDL_MOUSEBUTTONUP:
+		((InputQueue*)userdata)->push(*event);
+		break;
+
+	default:
+		break;
+	}
+
+	//return value is ignored for watches
+	return 0;
+}
@@ -0,0 +1,62 @@
+/*
+Title:	InputQueue.h
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: header file for InputQueue class for my game engine. A fixed size single producer, single consumer ring of input events
+	stamped with the performance counter when SDL first sees them. The producer is an SDL event watch, which runs as events are
+	pumped, so events that arrive while the frame cap is waiting are caught then instead of at the start of the next frame.
+	The consumer takes no locks, so a producer on another thread never blocks the game loop. Events can be pushed from more
+	than one thread, e.g. SDL's and the synthetic input injector's, so producers take turns through a spin lock.
+ */
+
+#pragma once
+#ifndef INPUTQUEUE_H
+#define INPUTQUEUE_H
+
+#include <SDL.h>
+#include <atomic>
+
+//queue constants
+const Uint32 INPUT_QUEUE_SIZE = 1024;	//must be a power of 2
+const int INPUT_PEEP_BATCH = 16;			//events taken at once when clearing SDL's own queue
+
+//an event and when it was captured
+struct InputEvent
+{
+	SDL_Event event;
+	Uint64 time;	//performance counter when captured
+};
+
+class InputQueue
+{
+public:
+	//initialize variables
+	InputQueue();
+
+	//producer side, any thread. Stamps and adds event, returns false and counts a drop if full
+	bool push(const SDL_Event& event);
+
+	//consumer side. Takes oldest event, returns false if empty
+	bool pop(InputEvent& out);
+
+	//getters
+	Uint32 getDropped() const { return dropped.load(std::memory_order_relaxed); }	//get number of events lost to a full queue
+
+	//SDL event watch callback that pushes into queue passed as userdata
+	static int eventWatch(void* userdata, SDL_Event* event);
+
+private:
+	//event slots
+	InputEvent events[INPUT_QUEUE_SIZE];
+
+	//next slot producer writes and consumer reads, only ever increase. Kept on separate cache lines so sides don't contend
+	alignas(64) std::atomic<Uint32> head;
+	alignas(64) std::atomic<Uint32> tail;
+
+	//events lost to a full queue
+	std::atomic<Uint32> dropped;
+
+	//held by producer pushing, consumer never takes it
+	SDL_SpinLock pushLock;
+};
+#endif
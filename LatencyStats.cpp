@@ -0,0 +1,62 @@
+/*
+Title:	LatencyStats.cpp
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: implementation file for LatencyStats class for my game engine
+ */
+
+#include "LatencyStats.h"
+#include <algorithm>
+
+LatencyStats::LatencyStats()
+{
+	clear();
+}
+
+void LatencyStats::add(float ms)
+{
+	//negative times come from clocks read out of order, count them as no wait
+	ms = std::max(ms, 0.0f);
+
+	int bucket = std::min((int)(ms / LATENCY_BUCKET_MS), LATENCY_BUCKETS - 1);
+	buckets[bucket]++;
+
+	count++;
+	totalMs += ms;
+	maxMs = std::max(maxMs, ms);
+}
+
+void LatencyStats::clear()
+{
+	for (Uint32& bucket : buckets) { bucket = 0; }
+
+	count = 0;
+	totalMs = 0;
+	maxMs = 0;
+}
+
+float LatencyStats::percentile(float fraction) const
+{
+	if(count == 0)
+	{
+		return 0;
+	}
+
+	//walk buckets until enough samples are under
+	Sint64 wanted = std::max((Sint64)(fraction * count + 0.5f), (Sint64)1);
+	Sint64 seen = 0;
+	for(int bucket = 0; bucket < LATENCY_BUCKETS - 1; bucket++)
+	{
+		seen += buckets[bucket];
+		if (seen >= wanted) { return std::min((bucket + 1) * LATENCY_BUCKET_MS, maxMs); }
+	}
+
+	//only overflow bucket is left
+	return maxMs;
+}
+
+void LatencyStats::report(const char* name) const
+{
+	SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "%s over %lld samples: p50 %.2f ms  p95 %.2f ms  p99 %.2f ms  max %.2f ms\n",
+		name, (long long)count, percentile(0.5f), percentile(0.95f), percentile(0.99f), maxMs);
+}
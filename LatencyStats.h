@@ -0,0 +1,51 @@
+/*
+Title:	LatencyStats.h
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: header file for LatencyStats class for my game engine. Collects latencies into fixed width buckets so any number of
+	samples can be kept without allocating, and percentiles can be read off at any time. Percentiles are reported as the top
+	of the bucket they fall in, so they are never under the real value by more than one bucket's width.
+ */
+
+#pragma once
+#ifndef LATENCYSTATS_H
+#define LATENCYSTATS_H
+
+#include <SDL.h>
+
+//latency constants
+const float LATENCY_BUCKET_MS = 0.25f;		//width of each bucket
+const int LATENCY_BUCKETS = 1024;			//last bucket also holds everything past the rest
+
+class LatencyStats
+{
+public:
+	//initialize variables
+	LatencyStats();
+
+	//add a latency in ms
+	void add(float ms);
+
+	//forget every sample
+	void clear();
+
+	//latency at or under which fraction of samples fall, from 0 to 1. 0 if there are none
+	float percentile(float fraction) const;
+
+	//log count, p50, p95, p99 and worst under name
+	void report(const char* name) const;
+
+	//getters
+	Sint64 getCount() const { return count; }
+	float getMax() const { return maxMs; }
+	float getMean() const { return count > 0 ? (float)(totalMs / count) : 0; }
+
+private:
+	//samples in each bucket
+	Uint32 buckets[LATENCY_BUCKETS];
+
+	Sint64 count;
+	double totalMs;
+	float maxMs;
+};
+#endif
@@ -0,0 +1,497 @@
+/*
+Title:	Lighting.cpp
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: implementation file for Lighting class for my game engine
+ */
+
+#include "Lighting.h"
+#include "PerfOverlay.h"
+#include "FrameArena.h"
+#include <algorithm>
+#include <cmath>
+
+//rays either side of an occluder corner, so light passes it on one side and stops on the other
+const float LIGHT_CORNER_NUDGE = 0.0001f;
+
+//battery levels light is quantized to, so a draining battery doesn't recast every frame
+const float LIGHT_POWER_STEPS = 64.0f;
+
+Lighting::Lighting()
+{
+	//initialize variables
+	map = NULL;
+	mapRevision = 0;
+	window = { 0, 0, 0, 0 };
+	edgeRebuilds = 0;
+	origin = { 0, 0 };
+	angle = 0;
+	directionX = 1;
+	directionY = 0;
+	cosOuter = cosf(LIGHT_HALF_ANGLE);
+	invSoftCos = 1.0f / (cosf(LIGHT_HALF_ANGLE * (1 - LIGHT_SOFT_EDGE)) - cosOuter);
+	castValid = false;
+	casts = 0;
+	rowsValid = false;
+	rowScale = 1;
+	shadeOrigin = { 0, 0 };
+	shadeRange = 0;
+
+	power = 0;
+	range = 0;
+	brightness = 0;
+	setPower(1);
+}
+
+void Lighting::setOccluders(const TileMap* map)
+{
+	this->map = map;
+
+	//gather again on next update
+	edges.clear();
+	window = { 0, 0, 0, 0 };
+	castValid = false;
+}
+
+void Lighting::setPower(float power)
+{
+	power = std::round(std::min(std::max(power, 0.0f), 1.0f) * LIGHT_POWER_STEPS) / LIGHT_POWER_STEPS;
+	if(power == this->power)
+	{
+		return;
+	}
+
+	this->power = power;
+	range = LIGHT_MIN_RANGE + (LIGHT_RANGE - LIGHT_MIN_RANGE) * power;
+	brightness = (1 - LIGHT_AMBIENT) * power;
+	castValid = false;
+}
+
+void Lighting::update(SDL_FPoint origin, float angle)
+{
+	//gather edges again if tiles changed or light's full reach has left area they cover
+	if(map != NULL && map->isLoaded())
+	{
+		int tileSize = map->getTileSize();
+		int left = (int)floorf((origin.x - LIGHT_RANGE) / tileSize);
+		int top = (int)floorf((origin.y - LIGHT_RANGE) / tileSize);
+		int right = (int)floorf((origin.x + LIGHT_RANGE) / tileSize);
+		int bottom = (int)floorf((origin.y + LIGHT_RANGE) / tileSize);
+
+		if(map->getRevision() != mapRevision || left < window.x || top < window.y || right >= window.x + window.w || bottom >= window.y + window.h)
+		{
+			gatherEdges(origin);
+			castValid = false;
+		}
+	}
+
+	if(origin.x != this->origin.x || origin.y != this->origin.y || angle != this->angle)
+	{
+		this->origin = origin;
+		this->angle = angle;
+		directionX = cosf(angle);
+		directionY = sinf(angle);
+		castValid = false;
+	}
+
+	if (!castValid) { castRays(); }
+}
+
+void Lighting::gatherEdges(SDL_FPoint origin)
+{
+	int tileSize = map->getTileSize();
+	int reach = (int)ceilf(LIGHT_RANGE / tileSize) + LIGHT_WINDOW_MARGIN;
+
+	window = { (int)floorf(origin.x / tileSize) - reach, (int)floorf(origin.y / tileSize) - reach, 2 * reach + 1, 2 * reach + 1 };
+	mapRevision = map->getRevision();
+	edges.clear();
+	edgeRebuilds++;
+
+	//solid flags of window plus a border, so edges at window sides know what is past them
+	int gridWidth = window.w + 2;
+	FrameVector<Uint8> solid((size_t)gridWidth * (window.h + 2));
+	for(int row = 0; row < window.h + 2; row++)
+	{
+		for(int column = 0; column < gridWidth; column++)
+		{
+			solid[row * gridWidth + column] = map->isSolidAt((window.x + column - 1) * tileSize, (window.y + row - 1) * tileSize);
+		}
+	}
+
+	//kind of boundary between two tiles: 0 none, 1 open past second tile, 2 open past first tile
+	auto boundary = [](bool first, bool second) { return first && !second ? 1 : (!first && second ? 2 : 0); };
+
+	//horizontal edges along top of each tile row, merged into runs of same kind
+	for(int row = 1; row <= window.h + 1; row++)
+	{
+		int runStart = 0;
+		int runKind = 0;
+
+		for(int column = 1; column <= window.w + 1; column++)
+		{
+			int kind = column <= window.w ? boundary(solid[(row - 1) * gridWidth + column], solid[row * gridWidth + column]) : 0;
+			if(kind == runKind)
+			{
+				continue;
+			}
+
+			float y = (float)(window.y + row - 1) * tileSize;
+			float startX = (float)(window.x + runStart - 1) * tileSize;
+			float endX = (float)(window.x + column - 1) * tileSize;
+
+			//open below runs left to right, open above runs right to left
+			if (runKind == 1) { edges.push_back({ startX, y, endX, y }); }
+			else if (runKind == 2) { edges.push_back({ endX, y, startX, y }); }
+
+			runStart = column;
+			runKind = kind;
+		}
+	}
+
+	//vertical edges along left of each tile column
+	for(int column = 1; column <= window.w + 1; column++)
+	{
+		int runStart = 0;
+		int runKind = 0;
+
+		for(int row = 1; row <= window.h + 1; row++)
+		{
+			int kind = row <= window.h ? boundary(solid[row * gridWidth + column - 1], solid[row * gridWidth + column]) : 0;
+			if(kind == runKind)
+			{
+				continue;
+			}
+
+			float x = (float)(window.x + column - 1) * tileSize;
+			float startY = (float)(window.y + runStart - 1) * tileSize;
+			float endY = (float)(window.y + row - 1) * tileSize;
+
+			//open to right runs bottom to top, open to left runs top to bottom
+			if (runKind == 1) { edges.push_back({ x, endY, x, startY }); }
+			else if (runKind == 2) { edges.push_back({ x, startY, x, endY }); }
+
+			runStart = row;
+			runKind = kind;
+		}
+	}
+}
+
+void Lighting::castRays()
+{
+	castValid = true;
+	rowsValid = false;
+	casts++;
+
+	//only edges light can reach and see the open side of can block it
+	facing.clear();
+	for(const Edge& edge : edges)
+	{
+		if((edge.x2 - edge.x1) * (origin.y - edge.y1) - (edge.y2 - edge.y1) * (origin.x - edge.x1) <= 0)
+		{
+			continue;
+		}
+
+		float dx = std::max({ std::min(edge.x1, edge.x2) - origin.x, origin.x - std::max(edge.x1, edge.x2), 0.0f });
+		float dy = std::max({ std::min(edge.y1, edge.y2) - origin.y, origin.y - std::max(edge.y1, edge.y2), 0.0f });
+		if (dx * dx + dy * dy <= range * range) { facing.push_back(edge); }
+	}
+
+	//evenly spaced rays give cone its arc
+	rays.clear();
+	for(int i = 0; i <= LIGHT_ARC_RAYS; i++)
+	{
+		rays.push_back({ LIGHT_HALF_ANGLE * (2.0f * i / LIGHT_ARC_RAYS - 1), 0, 0, 0 });
+	}
+
+	//rays at and just past each corner in cone, where polygon changes direction
+	for(const Edge& edge : facing)
+	{
+		for(SDL_FPoint corner : { SDL_FPoint{ edge.x1, edge.y1 }, SDL_FPoint{ edge.x2, edge.y2 } })
+		{
+			float offset = atan2f(corner.y - origin.y, corner.x - origin.x) - angle;
+			offset = remainderf(offset, 2 * (float)M_PI);
+			if(fabsf(offset) > LIGHT_HALF_ANGLE)
+			{
+				continue;
+			}
+
+			rays.push_back({ std::max(offset - LIGHT_CORNER_NUDGE, -LIGHT_HALF_ANGLE), 0, 0, 0 });
+			rays.push_back({ offset, 0, 0, 0 });
+			rays.push_back({ std::min(offset + LIGHT_CORNER_NUDGE, LIGHT_HALF_ANGLE), 0, 0, 0 });
+		}
+	}
+
+	std::sort(rays.begin(), rays.end(), [](const Ray& a, const Ray& b) { return a.offset < b.offset; });
+
+	//each ray stops at nearest edge it crosses, or at range
+	for(Ray& ray : rays)
+	{
+		float rayX = cosf(angle + ray.offset);
+		float rayY = sinf(angle + ray.offset);
+		ray.distance = range;
+
+		for(const Edge& edge : facing)
+		{
+			float edgeX = edge.x2 - edge.x1;
+			float edgeY = edge.y2 - edge.y1;
+			float denominator = rayX * edgeY - rayY * edgeX;
+			if(denominator == 0)
+			{
+				continue;
+			}
+
+			//distance along ray and fraction along edge where they cross
+			float toX = edge.x1 - origin.x;
+			float toY = edge.y1 - origin.y;
+			float distance = (toX * edgeY - toY * edgeX) / denominator;
+			float along = (toX * rayY - toY * rayX) / denominator;
+
+			if (distance >= 0 && distance < ray.distance && along >= 0 && along <= 1) { ray.distance = distance; }
+		}
+
+		ray.x = origin.x + rayX * ray.distance;
+		ray.y = origin.y + rayY * ray.distance;
+	}
+}
+
+void Lighting::buildRows(int height, float scale)
+{
+	rowsValid = true;
+	rowScale = scale;
+
+	rowCrossings.resize(height);
+	for (std::vector<float>& crossings : rowCrossings) { crossings.clear(); }
+
+	//polygon runs from origin out along each ray and back
+	int pointCount = (int)rays.size() + 1;
+	for(int i = 0; i < pointCount; i++)
+	{
+		SDL_FPoint a = i == 0 ? origin : SDL_FPoint{ rays[i - 1].x, rays[i - 1].y };
+		SDL_FPoint b = i + 1 == pointCount ? origin : SDL_FPoint{ rays[i].x, rays[i].y };
+		a = { a.x * scale, a.y * scale };
+		b = { b.x * scale, b.y * scale };
+		if(a.y == b.y)
+		{
+			continue;
+		}
+
+		//rows whose pixel centers are within edge's span, lower end included
+		float low = std::min(a.y, b.y);
+		float high = std::max(a.y, b.y);
+		int first = std::max((int)ceilf(low - 0.5f), 0);
+		int last = std::min((int)ceilf(high - 0.5f), height);
+
+		for(int row = first; row < last; row++)
+		{
+			rowCrossings[row].push_back(a.x + (row + 0.5f - a.y) * (b.x - a.x) / (b.y - a.y));
+		}
+	}
+
+	for (std::vector<float>& crossings : rowCrossings) { std::sort(crossings.begin(), crossings.end()); }
+}
+
+float Lighting::levelAt(float x, float y) const
+{
+	float dx = x - origin.x;
+	float dy = y - origin.y;
+	float squared = dx * dx + dy * dy;
+
+	//falls off with square of distance, reaching ambient at range
+	float radial = std::max(1 - squared / (range * range), 0.0f);
+	radial *= radial;
+
+	//fades across soft part of cone sides
+	float cosine = (dx * directionX + dy * directionY) / sqrtf(std::max(squared, 1.0f));
+	float angular = std::min(std::max((cosine - cosOuter) * invSoftCos, 0.0f), 1.0f);
+
+	return LIGHT_AMBIENT + brightness * radial * angular;
+}
+
+void Lighting::draw(SDL_Renderer* renderer, int width, int height)
+{
+	if(rays.empty())
+	{
+		return;
+	}
+
+	vertices.clear();
+	indices.clear();
+
+	//black with alpha hiding all but level of what is under it
+	auto shadow = [](float level) { return SDL_Color{ 0, 0, 0, (Uint8)(255 * (1 - std::min(level, 1.0f)) + 0.5f) }; };
+	SDL_Color ambient = shadow(LIGHT_AMBIENT);
+
+	//far enough that a triangle between two rays up to 120 degrees apart still covers screen
+	float far = 2 * sqrtf((float)width * width + (float)height * height);
+
+	//lit fan, with rings along each ray so falloff is interpolated. Origin is lit as if on center of cone
+	vertices.push_back({ origin, shadow(LIGHT_AMBIENT + brightness), { 0, 0 } });
+	for(const Ray& ray : rays)
+	{
+		for(int ring = 1; ring <= LIGHT_RINGS; ring++)
+		{
+			float fraction = (float)ring / LIGHT_RINGS;
+			SDL_FPoint point = { origin.x + (ray.x - origin.x) * fraction, origin.y + (ray.y - origin.y) * fraction };
+			vertices.push_back({ point, shadow(levelAt(point.x, point.y)), { 0, 0 } });
+		}
+	}
+
+	for(int i = 0; i + 1 < (int)rays.size(); i++)
+	{
+		int a = 1 + i * LIGHT_RINGS;
+		int b = a + LIGHT_RINGS;
+		indices.insert(indices.end(), { 0, a, b });
+
+		for (int ring = 0; ring + 1 < LIGHT_RINGS; ring++) { indices.insert(indices.end(), { a + ring, b + ring, a + ring + 1, b + ring, b + ring + 1, a + ring + 1 }); }
+	}
+
+	//shadow past where each ray stopped
+	int shadowStart = (int)vertices.size();
+	for(const Ray& ray : rays)
+	{
+		float rayX = cosf(angle + ray.offset);
+		float rayY = sinf(angle + ray.offset);
+		vertices.push_back({ { ray.x, ray.y }, ambient, { 0, 0 } });
+		vertices.push_back({ { origin.x + rayX * far, origin.y + rayY * far }, ambient, { 0, 0 } });
+	}
+
+	for(int i = 0; i + 1 < (int)rays.size(); i++)
+	{
+		int a = shadowStart + i * 2;
+		indices.insert(indices.end(), { a, a + 2, a + 1, a + 2, a + 3, a + 1 });
+	}
+
+	//fan over everything behind cone
+	int behindStart = (int)vertices.size();
+	vertices.push_back({ origin, ambient, { 0, 0 } });
+	for(int step = 0; step <= LIGHT_OUTSIDE_STEPS; step++)
+	{
+		float behind = angle + LIGHT_HALF_ANGLE + (2 * (float)M_PI - 2 * LIGHT_HALF_ANGLE) * step / LIGHT_OUTSIDE_STEPS;
+		vertices.push_back({ { origin.x + cosf(behind) * far, origin.y + sinf(behind) * far }, ambient, { 0, 0 } });
+	}
+
+	for (int step = 0; step < LIGHT_OUTSIDE_STEPS; step++) { indices.insert(indices.end(), { behindStart, behindStart + 1 + step, behindStart + 2 + step }); }
+
+	//untextured geometry blends with draw blend mode
+	SDL_BlendMode previous;
+	SDL_GetRenderDrawBlendMode(renderer, &previous);
+	SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+	SDL_RenderGeometry(renderer, NULL, vertices.data(), (int)vertices.size(), indices.data(), (int)indices.size());
+	perfCountDraw();
+	SDL_SetRenderDrawBlendMode(renderer, previous);
+}
+
+void Lighting::drawSoft(SoftRenderer& renderer)
+{
+	if(rays.empty())
+	{
+		return;
+	}
+
+	//framebuffer may be drawn at reduced scale
+	float scale = renderer.getScale();
+	if (!rowsValid || rowScale != scale || (int)rowCrossings.size() != renderer.getViewHeight()) { buildRows(renderer.getViewHeight(), scale); }
+	shadeOrigin = { origin.x * scale, origin.y * scale };
+	shadeRange = range * scale;
+
+	//tiles darken their own part of each row, lit between pairs of crossings
+	renderer.shade([this](Uint32* pixels, int pitch, const SDL_Rect& clip)
+	{
+		for(int row = clip.y; row < clip.y + clip.h; row++)
+		{
+			const std::vector<float>& crossings = rowCrossings[row];
+			Uint32* line = pixels + row * pitch;
+			int x = clip.x;
+			int right = clip.x + clip.w;
+
+			for(size_t i = 0; i + 1 < crossings.size(); i += 2)
+			{
+				int start = std::min(std::max((int)ceilf(crossings[i] - 0.5f), x), right);
+				int end = std::min(std::max((int)ceilf(crossings[i + 1] - 0.5f), start), right);
+
+				shadeSpan(line, x, row, start - x, false);
+				shadeSpan(line, start, row, end - start, true);
+				x = end;
+			}
+
+			shadeSpan(line, x, row, right - x, false);
+		}
+	});
+}
+
+void Lighting::shadeSpan(Uint32* pixels, int x, int y, int count, bool lit) const
+{
+	if(count <= 0)
+	{
+		return;
+	}
+
+	//brightness of each pixel in 256ths. Spans never cross a tile, and lit ones are filled a whole vector at a time
+	Sint32 scales[SOFT_TILE_SIZE + 8];
+	int i = 0;
+
+	if(!lit)
+	{
+		std::fill_n(scales, count, (Sint32)(LIGHT_AMBIENT * 256));
+	}
+	else
+	{
+#if SOFT_LANES > 1
+		//same steps as levelAt in framebuffer pixels, four pixels at a time
+		__m128 lanes = _mm_setr_ps(0, 1, 2, 3);
+		__m128 dy = _mm_set1_ps(y + 0.5f - shadeOrigin.y);
+		__m128 dySquared = _mm_mul_ps(dy, dy);
+		__m128 dyDirection = _mm_mul_ps(dy, _mm_set1_ps(directionY));
+		__m128 one = _mm_set1_ps(1);
+		__m128 zero = _mm_setzero_ps();
+
+		for(; i < count; i += 4)
+		{
+			__m128 dx = _mm_add_ps(_mm_set1_ps(x + i + 0.5f - shadeOrigin.x), lanes);
+			__m128 squared = _mm_add_ps(_mm_mul_ps(dx, dx), dySquared);
+
+			__m128 radial = _mm_max_ps(_mm_sub_ps(one, _mm_div_ps(squared, _mm_set1_ps(shadeRange * shadeRange))), zero);
+			radial = _mm_mul_ps(radial, radial);
+
+			__m128 cosine = _mm_div_ps(_mm_add_ps(_mm_mul_ps(dx, _mm_set1_ps(directionX)), dyDirection), _mm_sqrt_ps(_mm_max_ps(squared, one)));
+			__m128 angular = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_sub_ps(cosine, _mm_set1_ps(cosOuter)), _mm_set1_ps(invSoftCos)), zero), one);
+
+			__m128 level = _mm_add_ps(_mm_set1_ps(LIGHT_AMBIENT), _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(brightness), radial), angular));
+			_mm_storeu_si128((__m128i*)(scales + i), _mm_cvttps_epi32(_mm_mul_ps(level, _mm_set1_ps(256))));
+		}
+		i = 0;
+#else
+		for (int j = 0; j < count; j++) { scales[j] = (Sint32)(levelAt((x + j + 0.5f) / rowScale, (y + 0.5f) / rowScale) * 256); }
+#endif
+	}
+
+	Uint32* pixel = pixels + x;
+
+#if SOFT_LANES > 1
+	//scale channels of four pixels, two at a time in 16 bit lanes. Framebuffer stays opaque
+	__m128i zero = _mm_setzero_si128();
+	__m128i alpha = _mm_set1_epi32((int)0xFF000000);
+	for(; i + 4 <= count; i += 4)
+	{
+		__m128i colors = _mm_loadu_si128((const __m128i*)(pixel + i));
+		__m128i scale = _mm_loadu_si128((const __m128i*)(scales + i));
+
+		//spread each pixel's scale over its four channels
+		scale = _mm_packs_epi32(scale, scale);
+		scale = _mm_unpacklo_epi16(scale, scale);
+		__m128i scaleLow = _mm_unpacklo_epi32(scale, scale);
+		__m128i scaleHigh = _mm_unpackhi_epi32(scale, scale);
+
+		__m128i low = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(colors, zero), scaleLow), 8);
+		__m128i high = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(colors, zero), scaleHigh), 8);
+		_mm_storeu_si128((__m128i*)(pixel + i), _mm_or_si128(_mm_packus_epi16(low, high), alpha));
+	}
+#endif
+
+	for(; i < count; i++)
+	{
+		Uint32 color = pixel[i];
+		Uint32 scale = (Uint32)scales[i];
+		pixel[i] = 0xFF000000 | (((color >> 16 & 0xFF) * scale >> 8) << 16) | (((color >> 8 & 0xFF) * scale >> 8) << 8) | ((color & 0xFF) * scale >> 8);
+	}
+}
@@ -0,0 +1,134 @@
+/*
+Title:	Lighting.h
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: header file for Lighting class for my game engine. Darkens the scene outside the player's flashlight. Solid tile edges
+	near the light are gathered into merged occluder segments, and rays cast through the cone at their corners build a
+	visibility polygon. The scene is then darkened with radial falloff and soft cone sides, either as one batched geometry
+	call over the SDL renderer or per pixel with SIMD in the CPU renderer's tiles. Edges are only gathered again when the
+	light leaves the area they cover or tiles change, and the polygon only when the light moves or turns.
+ */
+
+#pragma once
+#ifndef LIGHTING_H
+#define LIGHTING_H
+
+#include <SDL.h>
+#include <vector>
+#include "TileMap.h"
+#include "SoftRenderer.h"
+
+//lighting constants
+const float LIGHT_RANGE = 560.0f;			//reach of full flashlight in pixels
+const float LIGHT_MIN_RANGE = 140.0f;		//reach of dead flashlight
+const float LIGHT_HALF_ANGLE = 0.55f;		//radians either side of aim, about 31 degrees
+const float LIGHT_SOFT_EDGE = 0.35f;		//part of half angle faded at cone sides
+const float LIGHT_AMBIENT = 0.12f;			//brightness outside light
+const int LIGHT_ARC_RAYS = 48;				//rays across cone, more where edges are
+const int LIGHT_RINGS = 6;					//vertices along each ray for falloff in geometry mask
+const int LIGHT_OUTSIDE_STEPS = 8;			//triangles darkening area behind cone
+const int LIGHT_WINDOW_MARGIN = 4;			//tiles of edges gathered past light's reach, so small moves reuse them
+
+class Lighting
+{
+public:
+	//initialize variables
+	Lighting();
+
+	//set tile map whose solid tiles block light, NULL for none. Map is not owned
+	void setOccluders(const TileMap* map);
+
+	//set flashlight battery from 0 dead to 1 full, shrinking its reach and brightness
+	void setPower(float power);
+
+	//aim light from origin at angle in radians, recasting visibility if anything changed
+	void update(SDL_FPoint origin, float angle);
+
+	//darken renderer with one geometry call
+	void draw(SDL_Renderer* renderer, int width, int height);
+
+	//darken CPU renderer's framebuffer, after anything it has recorded
+	void drawSoft(SoftRenderer& renderer);
+
+	//getters
+	float getPower() const { return power; }
+	int getEdgeCount() const { return (int)edges.size(); }		//get occluder segments gathered around light
+	int getRayCount() const { return (int)rays.size(); }		//get rays in visibility polygon
+	int getEdgeRebuilds() const { return edgeRebuilds; }		//get times occluder segments were gathered
+	int getCasts() const { return casts; }						//get times visibility polygon was cast
+
+private:
+	//occluder segment, pointing so open side is on its right on screen
+	struct Edge
+	{
+		float x1, y1;
+		float x2, y2;
+	};
+
+	//ray of visibility polygon
+	struct Ray
+	{
+		float offset;		//angle from aim
+		float distance;		//to nearest occluder or range
+		float x, y;			//where it stops
+	};
+
+	//gather edges between solid and open tiles around light, merging runs along rows and columns
+	void gatherEdges(SDL_FPoint origin);
+
+	//cast rays through cone against edges facing light
+	void castRays();
+
+	//build sorted polygon crossings of each framebuffer row, drawn at scale
+	void buildRows(int height, float scale);
+
+	//get brightness at a point inside visibility polygon
+	float levelAt(float x, float y) const;
+
+	//darken span of a row, lit inside polygon
+	void shadeSpan(Uint32* pixels, int x, int y, int count, bool lit) const;
+
+	//tile map solid tiles are read from
+	const TileMap* map;
+	Uint32 mapRevision;
+
+	//edges and tile area they were gathered over
+	std::vector<Edge> edges;
+	SDL_Rect window;
+	int edgeRebuilds;
+
+	//edges facing light within its reach
+	std::vector<Edge> facing;
+
+	//light
+	SDL_FPoint origin;
+	float angle;
+	float power;
+	float range;
+	float brightness;	//added to ambient at center of full light
+
+	//cone direction and cosines of its edges, for per pixel falloff
+	float directionX;
+	float directionY;
+	float cosOuter;
+	float invSoftCos;
+
+	//visibility polygon, rays sorted by offset from origin
+	std::vector<Ray> rays;
+	bool castValid;
+	int casts;
+
+	//polygon crossings of each framebuffer row, in pairs, and scale they were built for
+	std::vector<std::vector<float>> rowCrossings;
+	bool rowsValid;
+	float rowScale;
+
+	//light origin and range in framebuffer pixels
+	SDL_FPoint shadeOrigin;
+	float shadeRange;
+
+	//geometry mask, reused
+	std::vector<SDL_Vertex> vertices;
+	std::vector<int> indices;
+};
+#endif
@@ -9,17 +9,25 @@ Date Modified: 10/25/2022
 
 #include "Scene.h"
 #include "Sprite.h"
+#include "TileMap.h"
+#include "MemTrack.h"
+#include "NetGame.h"
+#include "FrameCapture.h"
+#include "PerfOverlay.h"
+#include "DynamicResolution.h"
+#include "FrameArena.h"
+#include "Session.h"
+#include "BatchEnv.h"
+#include "InputInjector.h"
+#include "SelfTest.h"
 #include <cstdio>
 #include <SDL_ttf.h>
-#include <sstream>
-#include <iomanip>
+#include <cctype>
+#include <thread>
 
 //create game scene
 Scene gameScene = Scene();
 
-//create timer
-Timer gameTimer = Timer();
-
 //create variables to hold required media
 //images
 SDL_Texture* playerTexture = NULL;
@@ -27,19 +35,71 @@ SDL_Texture* enemyTexture = NULL;
 SDL_Texture* playerProjectileTexture = NULL;
 SDL_Texture* muzzleFlashTexture = NULL;
 SDL_Texture* timerFontTexture = NULL;
+SDL_Texture* tilesetTexture = NULL;
+
+//background tile map
+TileMap worldMap;
+
+//sound effects
+Mixer mixer;
+
+//CPU renderer, only used with --cpu-render
+SoftRenderer softRenderer;
+
+//records presented frames, only used with --capture
+FrameCapture frameCapture;
+
+//frame timing HUD, shown with F3
+PerfOverlay perfOverlay;
+
+//lowers drawing resolution when frames run long on a CPU renderer
+DynamicResolution dynamicResolution;
+
+//quick save slot
+Snapshot quickSave;
+const char* QUICK_SAVE_PATH = "quicksave.snap";
+
+//spawn waves used when none are given
+const char* DEFAULT_WAVES_PATH = "waves/default.wave";
+
+//states game can be in. Only top of stack runs, and only playing simulates, the rest sleep until something happens
+enum GameState
+{
+	STATE_PLAYING, STATE_PAUSED, STATE_GAME_OVER
+};
+std::vector<GameState> stateStack;
+
+//idle state on top needs drawing
+bool idleDirty = false;
+
+//longest idle states sleep between checks
+const int IDLE_WAIT_MS = 250;
 
 //fonts
 TTF_Font* timerFont = NULL;
-//font stream
-std::ostringstream fontTextStream;
 
 //color for font
 SDL_Color fontColor = { 140, 10, 30, 0 };
 //rect for rendering font
 SDL_Rect fontRenderRect = { (SCREEN_WIDTH / 2) - 100, 0, 200, 100 };
 
-//initializes SDL components
-void SDLInit();
+//soak test constants
+const int SOAK_WARMUP_FRAMES = 300;		//frames before memory is sampled
+const int SOAK_WINDOWS = 8;				//number of windows memory peaks are compared over
+const Sint64 SOAK_GROWTH_SLACK = 256 * 1024;	//growth in bytes allowed before failing
+
+//frames of play before heap allocations are flagged
+const int STEADY_STATE_FRAMES = 300;
+
+//how often hosted sessions report their rate
+const Uint32 SESSION_STATS_MS = 5000;
+
+//latency test constants
+const int LATENCY_INJECT_MS = 5;								//average time between injected events
+const float LATENCY_BUDGET_MS = 3.0f * SCREEN_TICKS_PER_FRAME;	//p99 input to present latency allowed before failing
+
+//initializes SDL components. Headless uses the dummy video driver
+void SDLInit(bool headless);
 
 //frees resources and quits SDL components
 void close();
@@ -48,14 +108,23 @@ void close();
 SDL_Texture* textureFromFile(SDL_Renderer* renderer, std::string imagePath);
 
 //load texture from TTF
-SDL_Texture* loadFromText(std::string textureText);
+SDL_Texture* loadFromText(const char* textureText);
 
 //loads required media 
 void loadMedia();
 
+//open audio and load sound effects
+void loadSounds();
+
 //renders everything to screen
 void draw();
 
+//draw background, scene and timer without presenting them. Aim is only taken again while playing
+void drawWorld(bool playing);
+
+//draw line of text in middle of screen over a black fill with alpha shade
+void drawBanner(const char* text, Uint8 shade);
+
 //tasks to start and initialize scene
 void initScene();
 
@@ -68,18 +137,78 @@ bool handleInput();
 //handle logic
 void logic();
 
+//quick save on F5, quick load on F9
+void handleSnapshotKeys();
+
+//show or hide performance overlay on F3
+void handleOverlayKey();
+
 //bool for quitting
 bool quit;
 
-//game over screen
-void gameOver(int playerHealth);
+//set when timer runs out or player dies
+bool roundOver;
+
+//add state on top of stack, or remove top one. Idle states are drawn when they come to top
+void pushState(GameState state);
+void popState();
+
+//run one frame of gameplay
+void playFrame();
+
+//sleep until input or a window change, then handle it, redrawing idle state on top if needed
+void idleFrame();
+
+//draw idle state on top and present it
+void drawIdle();
+
+//pause or resume on P or Escape, returns true on a fresh press
+bool pausePressed();
+
+//get ms since performance counter read start
+float msSince(Uint64 start);
+
+//close out frame counters and free frame arena. Heap allocations are flagged once frames have been steady for a while
+void endFrame(bool steady);
+
+//run headless with synthetic input for a number of frames, returns failure if memory keeps growing
+int runSoak(int frames);
+
+//set keyboard and mouse to synthetic input for frame, circling player around and firing constantly
+void botInput(int frame);
+
+//play frames at normal pace with injected input, returns failure if p99 input to present latency is over budget
+int runLatencyTest(int frames);
+
+//run authoritative server until quit
+int runServer(Uint16 port);
+
+//run as client of server, showing server's scene
+int runClient(std::string host, Uint16 port, bool bot);
+
+//host many sessions split into shards across cores, served from port up if serving or played by bots. Bots run as
+//fast as they can, for ticks if given or until quit, servers keep frame rate
+int runSessions(int count, int shards, bool serve, Uint16 port, int ticks);
+
+//print command line options, after naming argument that wasn't understood
+void printUsage(const char* program, const char* badArgument);
+
+//step a batch of games with random actions as fast as they go, for ticks if given or until quit, reporting steps per second
+int runBatch(int count, int shards, int ticks);
 
 //initialize SDL components being used by the program
-void SDLInit()
+void SDLInit(bool headless)
 {
 	//flag to indicate success/fail
 	bool success = true;
 
+	//no display or sound hardware needed when headless. SDL_AUDIODRIVER=disk still wins, for checking mixed output
+	if(headless)
+	{
+		SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+		SDL_SetHint(SDL_HINT_AUDIODRIVER, "dummy");
+	}
+
 	//initialize SDL
 	if(SDL_Init(SDL_INIT_VIDEO) < 0)
 	{
@@ -109,20 +238,45 @@ void SDLInit()
 
 void close()
 {
-	//close scene
+	//finish writing captured frames
+	frameCapture.stop();
+
+	//free tile map, scaling target and CPU renderer before the renderer they use is destroyed
+	worldMap.free();
+	dynamicResolution.free();
+	softRenderer.free();
+	gameScene.setSoftRenderer(NULL);
+
+	//destroy any textures before the renderer that owns them
+	memDestroyTexture(playerTexture);
+	memDestroyTexture(enemyTexture);
+	memDestroyTexture(playerProjectileTexture);
+	memDestroyTexture(muzzleFlashTexture);
+	memDestroyTexture(timerFontTexture);
+	memDestroyTexture(tilesetTexture);
+	perfOverlay.free();
+	playerTexture = NULL;
+	enemyTexture = NULL;
+	playerProjectileTexture = NULL;
+	muzzleFlashTexture = NULL;
+	timerFontTexture = NULL;
+	tilesetTexture = NULL;
+
+	//stop audio before scene that plays it goes away
+	gameScene.setSounds(NULL, -1, -1);
+	mixer.free();
+
+	//close scene, then give back frames of scripts it stopped
 	gameScene.free();
-
-	//destroy any textures
-	SDL_DestroyTexture(playerTexture);
-	SDL_DestroyTexture(enemyTexture);
-	SDL_DestroyTexture(playerProjectileTexture);
-	SDL_DestroyTexture(muzzleFlashTexture);
-	SDL_DestroyTexture(timerFontTexture);
+	scriptFreeFrames();
 
 	//close fonts
 	TTF_CloseFont(timerFont);
 	timerFont = NULL;
 
+	//arena is tracked, so free it before leaks are reported
+	frameArena.free();
+
 	//quit SDL and SDL libraries
 	IMG_Quit();
 	TTF_Quit();
@@ -135,7 +289,17 @@ SDL_Texture* textureFromFile(SDL_Renderer* renderer, std::string imagePath)
 	SDL_Texture* loadedTexture = NULL;
 
 	//load image at specified path
-	loadedTexture = IMG_LoadTexture(renderer, imagePath.c_str());
+	SDL_Surface* loadedSurface = IMG_Load(imagePath.c_str());
+	if(loadedSurface != NULL)
+	{
+		loadedTexture = memTrackTexture(SDL_CreateTextureFromSurface(renderer, loadedSurface));
+
+		//CPU renderer keeps its own copy of pixels
+		if (softRenderer.isActive()) { softRenderer.addImage(loadedTexture, loadedSurface); }
+
+		SDL_FreeSurface(loadedSurface);
+	}
+
 	//check if loaded successfully
 	if (loadedTexture == NULL)
 	{
@@ -145,13 +309,13 @@ SDL_Texture* textureFromFile(SDL_Renderer* renderer, std::string imagePath)
 	return loadedTexture;
 }
 
-SDL_Texture* loadFromText(std::string textureText)
+SDL_Texture* loadFromText(const char* textureText)
 {
 	//initialize texture to hold 
 	SDL_Texture* loadedTexture = NULL;
 
 	//render text surface
-	SDL_Surface* textSurface = TTF_RenderText_Solid(timerFont, textureText.c_str(), fontColor);
+	SDL_Surface* textSurface = TTF_RenderText_Solid(timerFont, textureText, fontColor);
 	if (textSurface == NULL)
 	{
 		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Unable to render font to surface! SDL ttf Error: %s\n", TTF_GetError());
@@ -159,7 +323,7 @@ SDL_Texture* loadFromText(std::string textureText)
 	else
 	{
 		//create texture from surface
-		loadedTexture = SDL_CreateTextureFromSurface(gameScene.getRenderer(), textSurface);
+		loadedTexture = memTrackTexture(SDL_CreateTextureFromSurface(gameScene.getRenderer(), textSurface));
 		if(loadedTexture == NULL)
 		{
 			SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Unable to create texture from surface! SDL Error: %s\n", SDL_GetError());
@@ -177,37 +341,117 @@ void loadMedia()
 	playerTexture = textureFromFile(gameScene.getRenderer(), "gfx/myPlayer.png");
 	enemyTexture = textureFromFile(gameScene.getRenderer(), "gfx/myEnemy.png");
 	playerProjectileTexture = textureFromFile(gameScene.getRenderer(), "gfx/myProjectile.png");
+	gameScene.setEnemyTexture(enemyTexture);
 	muzzleFlashTexture = textureFromFile(gameScene.getRenderer(), "gfx/muzzleFlash.png");
 
+	//load tile map, flat background is drawn if there is none
+	tilesetTexture = textureFromFile(gameScene.getRenderer(), "gfx/tiles.png");
+	if (tilesetTexture != NULL) { worldMap.load(gameScene.getRenderer(), "maps/world.map", tilesetTexture); }
+
+	//enemies path around map's solid tiles
+	gameScene.setObstacles(&worldMap);
+
 	//open font
 	timerFont = TTF_OpenFont("gfx/HariPrimiantoro-owZdx.ttf", 28);
 	if (timerFont == NULL) { SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Unable to load font! SDL ttf Error: %s\n", TTF_GetError()); }
+
+	//overlay keeps its own small glyphs
+	perfOverlay.init(gameScene.getRenderer(), "gfx/HariPrimiantoro-owZdx.ttf", 14, (float)SCREEN_TICKS_PER_FRAME);
+}
+
+void loadSounds()
+{
+	if(!mixer.open())
+	{
+		return;
+	}
+
+	//made sounds stand in when files are missing
+	int shotSound = mixer.loadSound("sfx/shot.wav");
+	if (shotSound < 0) { shotSound = mixer.makeNoiseBurst(0.12f, 3000, 0.6f); }
+
+	int deathSound = mixer.loadSound("sfx/death.wav");
+	if (deathSound < 0) { deathSound = mixer.makeNoiseBurst(0.35f, 600, 0.9f); }
+
+	gameScene.setSounds(&mixer, shotSound, deathSound);
 }
 
 //render everything to screen
 void draw()
+{
+	//draw at current scale, stretched to window
+	dynamicResolution.begin();
+	drawWorld(true);
+	dynamicResolution.end();
+
+	//read back finished frame before it is presented
+	frameCapture.capture(gameScene.getRenderer());
+	perfOverlay.endPhase(PERF_DRAW);
+
+	//overlay goes over everything and isn't captured
+	perfOverlay.draw(gameScene);
+
+	//render scene
+	gameScene.render();
+	perfOverlay.endPhase(PERF_PRESENT);
+}
+
+void drawWorld(bool playing)
 {
 		//draw background
 		//create rect of whole screen
 	SDL_Rect backgroundRect = { 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT };
 
-	//draw background
-	SDL_SetRenderDrawColor(gameScene.getRenderer(), 61, 69, 33, 0);
-	SDL_RenderFillRect(gameScene.getRenderer(), &backgroundRect);
+	//stream chunks around player
+	worldMap.update(gameScene.getPlayerPos(), backgroundRect);
+
+	//draw background and tile map over it, into CPU framebuffer if using one
+	if(softRenderer.isActive())
+	{
+		softRenderer.clear({ 61, 69, 33, 0 });
+		worldMap.drawSoft(softRenderer, backgroundRect);
+	}
+	else
+	{
+		SDL_SetRenderDrawColor(gameScene.getRenderer(), 61, 69, 33, 0);
+		SDL_RenderFillRect(gameScene.getRenderer(), &backgroundRect);
+		worldMap.draw(backgroundRect);
+	}
+
+	//newest aim just before drawing
+	if (playing) { gameScene.sampleAim(); }
+
+	//flashlight battery runs down over the round
+	gameScene.getLighting().setPower(gameScene.getRoundTicksLeft() / (float)ROUND_TICKS);
 
 	//call scene draw functions
 	gameScene.draw();
 
-	//clear font stream and replace
-	fontTextStream.str("");
-	fontTextStream << std::fixed << std::setprecision(2) << (180 - gameTimer.getTicks() / 1000.f);
+	//format time left without touching heap
+	char timerText[16];
+	snprintf(timerText, sizeof(timerText), "%.2f", gameScene.getRoundTicksLeft() / (float)SCREEN_FPS);
 
-	//draw timer font
-	timerFontTexture = loadFromText(fontTextStream.str());
+	//draw timer font, destroying last frame's texture
+	memDestroyTexture(timerFontTexture);
+	timerFontTexture = loadFromText(timerText);
 	SDL_RenderCopy(gameScene.getRenderer(), timerFontTexture, NULL, &fontRenderRect);
+}
 
-	//render scene
-	gameScene.render();
+void drawBanner(const char* text, Uint8 shade)
+{
+	SDL_Renderer* renderer = gameScene.getRenderer();
+
+	//cover screen, blending lets what is under it show through
+	SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+	SDL_SetRenderDrawColor(renderer, 0, 0, 0, shade);
+	SDL_RenderFillRect(renderer, NULL);
+	SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+
+	//draw text, destroying last texture made from font
+	memDestroyTexture(timerFontTexture);
+	timerFontTexture = loadFromText(text);
+	SDL_Rect bannerRect = { SCREEN_WIDTH / 4, SCREEN_HEIGHT / 3, SCREEN_WIDTH / 2, SCREEN_HEIGHT / 3 };
+	SDL_RenderCopy(renderer, timerFontTexture, NULL, &bannerRect);
 }
 
 void initScene()
@@ -224,7 +468,7 @@ void initScene()
 
 void initializePlayer()
 {
-	Sprite* player = new Sprite(&gameScene, true, ENTITY, playerTexture);
+	Sprite* player = gameScene.addSprite(true, ENTITY, playerTexture);
 	//set player to center of screen
 	player->setPos(SCREEN_X_CENTER - (player->getWidth() / 2),	SCREEN_Y_CENTER - (player->getHeight() / 2));
 
@@ -242,79 +486,541 @@ bool handleInput()
 	return quit;
 }
 
-void gameOver(int playerHealth)
+void pushState(GameState state)
 {
-	gameScene.prepare();
+	stateStack.push_back(state);
+	idleDirty = true;
+}
 
-	//draw background
-	//create rect of whole screen
-	SDL_Rect backgroundRect = { 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT };
+void popState()
+{
+	stateStack.pop_back();
+	idleDirty = true;
 
-	//draw background
-	SDL_SetRenderDrawColor(gameScene.getRenderer(), 0, 0, 0, 0);
-	SDL_RenderFillRect(gameScene.getRenderer(), &backgroundRect);
+	//focus lost while paused shouldn't pause again
+	gameScene.takeFocusLost();
+}
+
+void playFrame()
+{
+	//start timing frame
+	perfOverlay.beginFrame();
+	Uint64 frameStart = SDL_GetPerformanceCounter();
 
-	//clear font stream and replace
-	fontTextStream.str("");
+	//initialize scene
+	initScene();
 
-	//if survived, display that you win
-	if(playerHealth > 0)
+	//do scene input
+	quit = handleInput();
+
+	//quick save and load
+	handleSnapshotKeys();
+	handleOverlayKey();
+	perfOverlay.endPhase(PERF_INPUT);
+
+	//stop simulating when asked or when window is left
+	if(pausePressed() || gameScene.takeFocusLost())
 	{
-		fontTextStream << "You have survived!";
+		pushState(STATE_PAUSED);
+		return;
 	}
-	else
+
+	//pick up edits to wave file
+	gameScene.getWaves().checkReload();
+
+	//handle logic
+	logic();
+	perfOverlay.endPhase(PERF_LOGIC);
+
+	//draw scene to screen
+	Uint64 drawStart = SDL_GetPerformanceCounter();
+	draw();
+
+	//frame time before waiting picks render scale
+	dynamicResolution.addFrame(msSince(frameStart), msSince(drawStart));
+
+	//close out frame allocation counts and frame arena
+	endFrame(true);
+
+	//end screen replaces game once last frame is shown
+	if(roundOver)
+	{
+		popState();
+		pushState(STATE_GAME_OVER);
+		return;
+	}
+
+	//cap frames
+	gameScene.capFrames();
+	perfOverlay.endPhase(PERF_WAIT);
+}
+
+void idleFrame()
+{
+	//only draw when state changed or window lost what was shown
+	if(gameScene.takeWindowChanged() || idleDirty)
 	{
-		fontTextStream << "You have died...";
+		drawIdle();
+		idleDirty = false;
 	}
 
-	//draw timer font
-	timerFontTexture = loadFromText(fontTextStream.str());
-	SDL_Rect gameOverRect = { SCREEN_WIDTH / 4, SCREEN_HEIGHT / 3, SCREEN_WIDTH / 2, SCREEN_HEIGHT / 3 };
-	SDL_RenderCopy(gameScene.getRenderer(), timerFontTexture, NULL, &gameOverRect);
+	//sleep instead of polling
+	quit = gameScene.waitInput(IDLE_WAIT_MS);
+	endFrame(false);
+
+	//this frame presented before it waited, so input it took isn't on screen. Left tagged, the next present would count
+	//the whole pause as latency
+	gameScene.discardFrameInput();
+
+	if (stateStack.back() == STATE_PAUSED && pausePressed()) { popState(); }
+}
+
+void drawIdle()
+{
+	gameScene.prepare();
+
+	if(stateStack.back() == STATE_PAUSED)
+	{
+		//frozen game under a dimmed screen
+		drawWorld(false);
+		drawBanner("Paused", 160);
+	}
+	else
+	{
+		//if survived, display that you win
+		Sprite* player = gameScene.getPlayer();
+		drawBanner(player != NULL && player->getHealth() > 0 ? "You have survived!" : "You have died...", 255);
+	}
 
 	//render to screen
 	gameScene.render();
+}
 
-	bool exit = false;
+float msSince(Uint64 start)
+{
+	return (SDL_GetPerformanceCounter() - start) * 1000.0f / SDL_GetPerformanceFrequency();
+}
+
+void endFrame(bool steady)
+{
+	//frames in a row that should allocate nothing, and when allocations were last reported
+	static int steadyFrames = 0;
+	static Uint64 lastReport = 0;
 
-	while(!exit)
+	memTrackEndFrame();
+	frameArena.reset();
+
+	steadyFrames = steady ? steadyFrames + 1 : 0;
+
+	//report at most once a second so reporting isn't most of the frame
+	Sint64 heapAllocs = memTrackHeapAllocs();
+	if(steadyFrames > STEADY_STATE_FRAMES && heapAllocs > 0 && SDL_GetTicks64() - lastReport >= 1000)
 	{
-		SDL_Event e;
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_WARN, "%lld heap allocations in a steady state frame\n", (long long)heapAllocs);
+		lastReport = SDL_GetTicks64();
+	}
+}
+
+bool pausePressed()
+{
+	//key state last frame so holding it only toggles once
+	static bool pauseHeld = false;
+
+	int* keyboard = gameScene.getKeyboard();
+	bool down = keyboard[SDL_SCANCODE_P] || keyboard[SDL_SCANCODE_ESCAPE];
+	bool pressed = down && !pauseHeld;
+
+	pauseHeld = down;
+	return pressed;
+}
 
-		while (SDL_PollEvent(&e))
+void handleSnapshotKeys()
+{
+	//key states last frame so holding a key only triggers once
+	static bool saveHeld = false;
+	static bool loadHeld = false;
+
+	int* keyboard = gameScene.getKeyboard();
+
+	if(keyboard[SDL_SCANCODE_F5] && !saveHeld)
+	{
+		gameScene.saveSnapshot(quickSave);
+		quickSave.writeFile(QUICK_SAVE_PATH);
+	}
+
+	if(keyboard[SDL_SCANCODE_F9] && !loadHeld && !quickSave.isEmpty())
+	{
+		gameScene.loadSnapshot(quickSave);
+	}
+
+	saveHeld = keyboard[SDL_SCANCODE_F5];
+	loadHeld = keyboard[SDL_SCANCODE_F9];
+}
+
+void handleOverlayKey()
+{
+	//key state last frame so holding it only toggles once
+	static bool overlayHeld = false;
+
+	int* keyboard = gameScene.getKeyboard();
+
+	if (keyboard[SDL_SCANCODE_F3] && !overlayHeld) { perfOverlay.toggle(); }
+
+	overlayHeld = keyboard[SDL_SCANCODE_F3];
+}
+
+void logic()
+{
+	//run one tick of scene simulation
+	gameScene.simulate();
+
+	//if round's ticks are up or player dead display end screen. Counted in simulation ticks like sessions count theirs, so
+	//a slow machine plays the same round
+	if (gameScene.getPlayer()->getHealth() == 0 || gameScene.isRoundSurvived())
+	{
+		roundOver = true;
+	}
+}
+
+int runSoak(int frames)
+{
+	//peak live bytes seen in each window after warmup
+	Sint64 trackedPeaks[SOAK_WINDOWS] = { 0 };
+	Sint64 processPeaks[SOAK_WINDOWS] = { 0 };
+	int windowFrames = (frames - SOAK_WARMUP_FRAMES) / SOAK_WINDOWS;
+
+	if(windowFrames <= 0)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Soak test needs more than %d frames\n", SOAK_WARMUP_FRAMES);
+		return 1;
+	}
+
+	for(int frame = 0; frame < frames; frame++)
+	{
+		initScene();
+
+		//synthetic input
+		botInput(frame);
+
+		handleInput();
+		logic();
+		draw();
+		endFrame(true);
+
+		//player death and timer don't end a soak test
+		roundOver = false;
+
+		//sample memory after warmup
+		if(frame >= SOAK_WARMUP_FRAMES)
 		{
-			switch (e.type)
+			int window = std::min((frame - SOAK_WARMUP_FRAMES) / windowFrames, SOAK_WINDOWS - 1);
+			trackedPeaks[window] = std::max(trackedPeaks[window], memTrackLiveBytes());
+			processPeaks[window] = std::max(processPeaks[window], memTrackProcessBytes());
+
+			if((frame - SOAK_WARMUP_FRAMES) % windowFrames == windowFrames - 1)
 			{
-			case SDL_QUIT:
-				exit = true;
-				break;
+				SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "Soak frame %d tracked: %lld bytes process: %lld bytes sprites: %lld allocs last frame: %lld heap: %lld arena peak: %zu bytes\n",
+					frame, (long long)trackedPeaks[window], (long long)processPeaks[window], (long long)memTrackStats(MEM_SPRITE).liveObjects,
+					(long long)memTrackStats(MEM_SPRITE).frameAllocs + memTrackStats(MEM_TEXTURE).frameAllocs, (long long)memTrackHeapAllocs(), frameArena.getPeak());
 			}
 		}
 	}
-};
 
-void logic()
+	//memory is growing if every window set a new peak and total growth is past slack
+	bool trackedGrowing = trackedPeaks[SOAK_WINDOWS - 1] - trackedPeaks[0] > SOAK_GROWTH_SLACK;
+	bool processGrowing = processPeaks[SOAK_WINDOWS - 1] - processPeaks[0] > SOAK_GROWTH_SLACK;
+	for(int i = 1; i < SOAK_WINDOWS; i++)
+	{
+		trackedGrowing = trackedGrowing && trackedPeaks[i] > trackedPeaks[i - 1];
+		processGrowing = processGrowing && processPeaks[i] > processPeaks[i - 1];
+	}
+
+	if(trackedGrowing || processGrowing)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Soak test failed, memory grew from %lld to %lld tracked bytes (%lld to %lld process bytes)\n",
+			(long long)trackedPeaks[0], (long long)trackedPeaks[SOAK_WINDOWS - 1], (long long)processPeaks[0], (long long)processPeaks[SOAK_WINDOWS - 1]);
+		return 1;
+	}
+
+	SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "Soak test passed after %d frames\n", frames);
+	return 0;
+}
+
+void botInput(int frame)
+{
+	int* keyboard = gameScene.getKeyboard();
+	int phase = (frame / 30) % 4;
+	keyboard[SDL_SCANCODE_W] = phase == 0;
+	keyboard[SDL_SCANCODE_D] = phase == 1;
+	keyboard[SDL_SCANCODE_S] = phase == 2;
+	keyboard[SDL_SCANCODE_A] = phase == 3;
+	gameScene.setMouseState({ (frame * 37) % SCREEN_WIDTH, (frame * 23) % SCREEN_HEIGHT }, true);
+}
+
+int runLatencyTest(int frames)
 {
-	//handle enemies
-	gameScene.doEnemies();
+	//events come from another thread at any time, like a real device's
+	InputInjector injector;
+	injector.start(LATENCY_INJECT_MS, (Uint64)time(NULL));
 
-	//handle projectiles
-	gameScene.doProjectiles();
+	for(int frame = 0; frame < frames && !quit; frame++)
+	{
+		perfOverlay.beginFrame();
+		initScene();
+		quit = handleInput();
+		perfOverlay.endPhase(PERF_INPUT);
 
-	//spawn enemies
-	gameScene.spawnEnemies(enemyTexture);
+		logic();
+		perfOverlay.endPhase(PERF_LOGIC);
 
-	//check for collisions
-	gameScene.collisionCheck();
+		draw();
+		endFrame(true);
 
-	//bounding player
-	gameScene.bound();
+		//player death and timer don't end test
+		roundOver = false;
 
-	//if timer is out or player dead display end screen
-	if (gameScene.getPlayer()->getHealth() == 0 || gameTimer.getTicks() >= 180000)
+		//waiting out frame is when most input arrives, so cap like a real game
+		gameScene.capFrames();
+		perfOverlay.endPhase(PERF_WAIT);
+	}
+
+	injector.stop();
+
+	const LatencyStats& latency = gameScene.getInputLatency();
+	latency.report("Input to present latency");
+
+	if(latency.getCount() == 0)
 	{
-		quit = true;
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Latency test failed, no injected input reached a presented frame\n");
+		return 1;
 	}
+
+	if(latency.percentile(0.99f) > LATENCY_BUDGET_MS)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Latency test failed, p99 %.2f ms is over %.2f ms budget\n",
+			latency.percentile(0.99f), LATENCY_BUDGET_MS);
+		return 1;
+	}
+
+	SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "Latency test passed after %d frames, %u events injected\n", frames, injector.getInjected());
+	return 0;
+}
+
+int runServer(Uint16 port)
+{
+	NetServer server;
+
+	if(!server.start(&gameScene, port, playerTexture))
+	{
+		return 1;
+	}
+
+	//server has no local player, it only simulates for clients
+	while(!quit)
+	{
+		initScene();
+
+		//window events still quit server
+		quit = handleInput();
+
+		//pick up edits to wave file
+		gameScene.getWaves().checkReload();
+
+		//apply client inputs, step scene and send results
+		server.receive();
+		gameScene.simulate();
+		server.sendSnapshots();
+
+		endFrame(true);
+		gameScene.capFrames();
+	}
+
+	server.stop();
+	return 0;
+}
+
+int runClient(std::string host, Uint16 port, bool bot)
+{
+	NetClient client;
+
+	if(!client.connect(&gameScene, host, port))
+	{
+		return 1;
+	}
+
+	//players arrive in snapshots instead of being made here
+	gameScene.setPlayerTexture(playerTexture);
+
+	//client doesn't simulate, it sends input and shows snapshots from server
+	for(int frame = 0; !quit; frame++)
+	{
+		perfOverlay.beginFrame();
+		Uint64 frameStart = SDL_GetPerformanceCounter();
+		initScene();
+
+		if (bot) { botInput(frame); }
+
+		quit = handleInput();
+		handleOverlayKey();
+		client.sendInput(gameScene.getLocalInput());
+		client.receive();
+		perfOverlay.endPhase(PERF_INPUT);
+
+		//effects are local only
+		gameScene.doParticles();
+		perfOverlay.endPhase(PERF_LOGIC);
+
+		Uint64 drawStart = SDL_GetPerformanceCounter();
+		draw();
+		dynamicResolution.addFrame(msSince(frameStart), msSince(drawStart));
+
+		endFrame(true);
+		gameScene.capFrames();
+		perfOverlay.endPhase(PERF_WAIT);
+	}
+
+	client.disconnect();
+	gameScene.getInputLatency().report("Input to present latency");
+	return 0;
+}
+
+int runSessions(int count, int shards, bool serve, Uint16 port, int ticks)
+{
+	//sessions share this scene's renderer and textures, which only hosts window events
+	SessionMedia media = { gameScene.getRenderer(), playerTexture, enemyTexture, playerProjectileTexture, muzzleFlashTexture };
+
+	SessionHost host;
+	if(!host.init(count, shards, media, gameScene.getWaves(), (Uint64)time(NULL), serve ? port : 0))
+	{
+		return 1;
+	}
+
+	Uint64 statsStart = SDL_GetPerformanceCounter();
+	Sint64 statsSteps = 0;
+
+	for(int tick = 0; !quit && (ticks <= 0 || tick < ticks); tick++)
+	{
+		initScene();
+
+		//window events still quit host
+		quit = handleInput();
+
+		host.step();
+		endFrame(true);
+
+		//servers keep clients' pace, bots show how fast sessions can go
+		if (serve) { gameScene.capFrames(); }
+
+		float elapsed = msSince(statsStart);
+		if(elapsed >= SESSION_STATS_MS)
+		{
+			int rounds = 0;
+			for (int i = 0; i < host.getSessionCount(); i++) { rounds += host.getSession(i).getRounds(); }
+
+			SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "%d sessions: %.0f ticks/s, %d rounds played\n",
+				host.getSessionCount(), (host.getSteps() - statsSteps) * 1000.0f / elapsed, rounds);
+
+			statsStart = SDL_GetPerformanceCounter();
+			statsSteps = host.getSteps();
+		}
+	}
+
+	//ticks over every session, for comparing shard counts
+	SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "Hosted %lld session ticks\n", (long long)host.getSteps());
+
+	host.free();
+	return 0;
+}
+
+int runBatch(int count, int shards, int ticks)
+{
+	SessionMedia media = { gameScene.getRenderer(), playerTexture, enemyTexture, playerProjectileTexture, muzzleFlashTexture };
+
+	BatchEnv env;
+	if(!env.init(count, shards, media, gameScene.getWaves(), (Uint64)time(NULL)))
+	{
+		return 1;
+	}
+
+	//buffers agents would own, filled in place
+	std::vector<PlayerInput> actions(count);
+	std::vector<BatchObservation> observations(count);
+	env.reset(observations.data());
+
+	Random actionRng;
+	double totalReward = 0;
+	int episodes = 0;
+	Uint64 statsStart = SDL_GetPerformanceCounter();
+	Sint64 statsSteps = 0;
+
+	for(int tick = 0; !quit && (ticks <= 0 || tick < ticks); tick++)
+	{
+		//a new random action every so often stands in for an agent
+		if(tick % 8 == 0)
+		{
+			for(PlayerInput& action : actions)
+			{
+				action.keys = (Uint8)actionRng.range(16);
+				action.fire = (Uint8)actionRng.range(2);
+				action.aimX = (Sint16)actionRng.range(SCREEN_WIDTH);
+				action.aimY = (Sint16)actionRng.range(SCREEN_HEIGHT);
+			}
+		}
+
+		env.step(actions.data(), observations.data());
+
+		for(const BatchObservation& observation : observations)
+		{
+			totalReward += observation.reward;
+			episodes += observation.done;
+		}
+
+		//window events still quit, checked between batches of steps
+		if (tick % SCREEN_FPS == 0) { quit = handleInput(); }
+
+		float elapsed = msSince(statsStart);
+		if(elapsed >= SESSION_STATS_MS)
+		{
+			SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "Batch of %d: %.0f steps/s, %d episodes, %.2f mean reward\n",
+				count, (env.getSteps() - statsSteps) * 1000.0f / elapsed, episodes, episodes > 0 ? totalReward / episodes : 0.0);
+
+			statsStart = SDL_GetPerformanceCounter();
+			statsSteps = env.getSteps();
+		}
+	}
+
+	SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "Stepped %lld games, %d episodes finished\n", (long long)env.getSteps(), episodes);
+
+	env.free();
+	return 0;
+}
+
+void printUsage(const char* program, const char* badArgument)
+{
+	printf("Unknown or incomplete option: %s\n", badArgument);
+	printf("Usage: %s [options]\n"
+		"  --headless               run without a window or sound\n"
+		"  --soak N                 play N frames headless with a bot, failing on memory growth or leaks\n"
+		"  --snapshot PATH          start from a saved game state\n"
+		"  --server [PORT]          host a game for clients\n"
+		"  --connect HOST[:PORT]    join a server\n"
+		"  --bot                    client plays itself\n"
+		"  --waves PATH             spawn waves to run\n"
+		"  --cpu-render             draw with the CPU renderer\n"
+		"  --no-rotation-cache      CPU renderer rotates every sprite exactly\n"
+		"  --render-threads N       threads CPU renderer draws with\n"
+		"  --capture PATH           record frames to PATH.y4m or numbered PNGs\n"
+		"  --capture-every N        only record every Nth frame\n"
+		"  --perf-overlay           start with performance overlay shown\n"
+		"  --fixed-resolution       never lower drawing resolution\n"
+		"  --no-lighting            draw without flashlight darkness\n"
+		"  --sessions N             host N sessions in one process, served with --server or played by bots\n"
+		"  --session-ticks N        stop hosted sessions after N ticks, failing on leaks\n"
+		"  --batch N                step N games in lockstep with random actions\n"
+		"  --batch-steps N          stop batched games after N steps\n"
+		"  --shards N               threads sessions or batched games are split over\n"
+		"  --latency-test N         measure input to present latency over N frames\n"
+		"  --self-test              check modules against known answers\n", program);
 }
 
 //arguments passed per SDL documentation
@@ -322,43 +1028,329 @@ int main(int argc, char * argv[])
 {
 	//flag for quitting
 	quit = false;
+	roundOver = false;
+
+	//command line options
+	bool headless = false;
+	int soakFrames = 0;
+	std::string snapshotPath;
+	bool serve = false;
+	bool bot = false;
+	std::string connectHost;
+	Uint16 port = NET_DEFAULT_PORT;
+	std::string wavesPath = DEFAULT_WAVES_PATH;
+	bool cpuRender = false;
+	bool rotationCache = true;
+	int renderThreads = (int)std::thread::hardware_concurrency();
+	std::string capturePath;
+	int captureEvery = 1;
+	bool showOverlay = false;
+	bool lighting = true;
+	bool fixedResolution = false;
+	int sessions = 0;
+	int sessionTicks = 0;
+	int shards = 0;
+	int batch = 0;
+	int batchSteps = 0;
+	int latencyFrames = 0;
+	bool selfTest = false;
+
+	for(int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+
+		if(arg == "--headless")
+		{
+			headless = true;
+		}
+		//soak test implies headless
+		else if(arg == "--soak" && i + 1 < argc)
+		{
+			soakFrames = atoi(argv[++i]);
+			headless = true;
+		}
+		//start from a saved mid-game state
+		else if(arg == "--snapshot" && i + 1 < argc)
+		{
+			snapshotPath = argv[++i];
+		}
+		//host game for clients, server has no window of its own
+		else if(arg == "--server")
+		{
+			serve = true;
+			headless = true;
+			if (i + 1 < argc && isdigit(argv[i + 1][0])) { port = (Uint16)atoi(argv[++i]); }
+		}
+		//join server at host[:port]
+		else if(arg == "--connect" && i + 1 < argc)
+		{
+			connectHost = argv[++i];
+			size_t colon = connectHost.find(':');
+			if(colon != std::string::npos)
+			{
+				port = (Uint16)atoi(connectHost.c_str() + colon + 1);
+				connectHost.erase(colon);
+			}
+		}
+		//spawn waves to run, e.g. a stress scenario
+		else if(arg == "--waves" && i + 1 < argc)
+		{
+			wavesPath = argv[++i];
+		}
+		//draw sprites with CPU renderer, for hosts without a GPU
+		else if(arg == "--cpu-render")
+		{
+			cpuRender = true;
+		}
+		//CPU renderer rotates every sprite exactly instead of using cached angles
+		else if(arg == "--no-rotation-cache")
+		{
+			rotationCache = false;
+		}
+		//threads CPU renderer draws screen tiles with, 1 draws everything on main thread
+		else if(arg == "--render-threads" && i + 1 < argc)
+		{
+			renderThreads = atoi(argv[++i]);
+		}
+		//record frames to path.y4m, or to numbered PNGs starting with path
+		else if(arg == "--capture" && i + 1 < argc)
+		{
+			capturePath = argv[++i];
+		}
+		//only record every nth frame
+		else if(arg == "--capture-every" && i + 1 < argc)
+		{
+			captureEvery = atoi(argv[++i]);
+		}
+		//start with performance overlay shown
+		else if(arg == "--perf-overlay")
+		{
+			showOverlay = true;
+		}
+		//always draw at full resolution, however long frames take
+		else if(arg == "--fixed-resolution")
+		{
+			fixedResolution = true;
+		}
+		//draw whole scene lit, without flashlight darkness
+		else if(arg == "--no-lighting")
+		{
+			lighting = false;
+		}
+		//client plays itself with synthetic input
+		else if(arg == "--bot")
+		{
+			bot = true;
+		}
+		//host many sessions in one process, no window of its own
+		else if(arg == "--sessions" && i + 1 < argc)
+		{
+			sessions = atoi(argv[++i]);
+			headless = true;
+		}
+		//hosted sessions run this many ticks, until quit if not given
+		else if(arg == "--session-ticks" && i + 1 < argc)
+		{
+			sessionTicks = atoi(argv[++i]);
+		}
+		//step games in lockstep with random actions, as an agent trainer would
+		else if(arg == "--batch" && i + 1 < argc)
+		{
+			batch = atoi(argv[++i]);
+			headless = true;
+		}
+		//batched games take this many steps, until quit if not given
+		else if(arg == "--batch-steps" && i + 1 < argc)
+		{
+			batchSteps = atoi(argv[++i]);
+		}
+		//measure input to present latency with injected input, for CI
+		else if(arg == "--latency-test" && i + 1 < argc)
+		{
+			latencyFrames = atoi(argv[++i]);
+			headless = true;
+		}
+		//check modules against known answers and exit, for CI
+		else if(arg == "--self-test")
+		{
+			selfTest = true;
+			headless = true;
+		}
+		//threads sessions or batched games are split over, one per core by default
+		else if(arg == "--shards" && i + 1 < argc)
+		{
+			shards = atoi(argv[++i]);
+		}
+		//anything else is a typo or missing value, better to stop than run something not asked for
+		else
+		{
+			printUsage(argv[0], argv[i]);
+			return 1;
+		}
+	}
 
 	//initialize SDL
-	SDLInit();
+	SDLInit(headless);
+
+	//frame temporaries come from here instead of heap
+	frameArena.init(FRAME_ARENA_BYTES);
+
+	//create window for scene
+	gameScene.createWindow(headless);
+
+	//CPU renderer must be ready before media loads so it can keep image pixels
+	if(cpuRender && softRenderer.init(gameScene.getRenderer(), SCREEN_WIDTH, SCREEN_HEIGHT))
+	{
+		softRenderer.setRotationCache(rotationCache);
+		softRenderer.setThreads(renderThreads);
+		gameScene.setSoftRenderer(&softRenderer);
+	}
+
+	//CPU renderers trade resolution for frame rate, GPUs have time to spare
+	SDL_RendererInfo rendererInfo = {};
+	SDL_GetRendererInfo(gameScene.getRenderer(), &rendererInfo);
+	if(!fixedResolution && (softRenderer.isActive() || (rendererInfo.flags & SDL_RENDERER_SOFTWARE)))
+	{
+		dynamicResolution.init(gameScene.getRenderer(), SCREEN_WIDTH, SCREEN_HEIGHT, SCREEN_TICKS_PER_FRAME, softRenderer.isActive() ? &softRenderer : NULL);
+	}
+
+	if(!capturePath.empty())
+	{
+		frameCapture.start(capturePath, SCREEN_WIDTH, SCREEN_HEIGHT, SCREEN_FPS, captureEvery);
+	}
 
 	//load required media
 	loadMedia();
+	perfOverlay.setVisible(showOverlay);
+	gameScene.setLightingEnabled(lighting);
+
+	//load spawn waves, built in wave is used if file can't be read
+	gameScene.getWaves().load(wavesPath);
+
+	//server is silent, it only simulates for clients
+	if(!serve)
+	{
+		loadSounds();
+	}
+
+	//batch of games driven without SDL events
+	if(batch > 0)
+	{
+		initScene();
+		int result = runBatch(batch, shards, batchSteps);
+
+		close();
+		memTrackReport();
+
+		return result;
+	}
+
+	//many sessions in one process, each served on its own port or played by a bot
+	if(sessions > 0)
+	{
+		if(serve && !netInit())
+		{
+			close();
+			return 1;
+		}
+
+		initScene();
+		int result = runSessions(sessions, shards, serve, port, sessionTicks);
+
+		if (serve) { netQuit(); }
+		close();
+
+		//sessions run for a set time fail on leaks like a soak of the game
+		if(memTrackReport() > 0 && sessionTicks > 0)
+		{
+			result = 1;
+		}
+
+		return result;
+	}
+
+	//networked games run their own loops and get players from the server
+	if(serve || !connectHost.empty())
+	{
+		if(!netInit())
+		{
+			close();
+			return 1;
+		}
+
+		initScene();
+		int result = serve ? runServer(port) : runClient(connectHost, port, bot);
+
+		netQuit();
+		close();
+		memTrackReport();
+
+		return result;
+	}
 
 	//initialize player
 	initializePlayer();
 
-	//start game timer
-	gameTimer.start();
+	//restore starting state if one was given
+	if(!snapshotPath.empty() && quickSave.readFile(snapshotPath))
+	{
+		gameScene.loadSnapshot(quickSave);
+	}
 
-	//begin main game loop
-	while(!quit)
+	//self tests run instead of the game
+	if(selfTest)
 	{
-		//initialize scene
-		initScene();
+		int result = runSelfTests(gameScene) > 0 ? 1 : 0;
 
-		//do scene input
-		quit = handleInput();
+		close();
+		memTrackReport();
 
-		//handle logic
-		logic();
+		return result;
+	}
 
-		//draw scene to screen
-		draw();
+	//latency test runs instead of the game
+	if(latencyFrames > 0)
+	{
+		int result = runLatencyTest(latencyFrames);
 
-		gameScene.print(); //TODO remove
+		close();
+		memTrackReport();
 
-		//cap frames
-		gameScene.capFrames();
+		return result;
+	}
+
+	//soak test runs instead of the game
+	if(soakFrames > 0)
+	{
+		int result = runSoak(soakFrames);
+
+		close();
+
+		//anything left alive is a leak
+		if(memTrackReport() > 0)
+		{
+			result = 1;
+		}
+
+		return result;
+	}
+
+	//begin main game loop, until window is closed
+	pushState(STATE_PLAYING);
+	while(!quit && !stateStack.empty())
+	{
+		if (stateStack.back() == STATE_PLAYING) { playFrame(); }
+		else { idleFrame(); }
 
 	}//end main game loop
 
-	gameOver(gameScene.getPlayer()->getHealth());
+	//how responsive this session was
+	gameScene.getInputLatency().report("Input to present latency");
 
 	close();
+
+	//report leaks
+	memTrackReport();
+
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,211 @@
+/*
+Title:	MemTrack.cpp
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: implementation file for memory tracking in my game engine
+ */
+
+#include "MemTrack.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+//bytes per pixel assumed for textures
+const int TEXTURE_BYTES_PER_PIXEL = 4;
+
+//atomic counters for each category
+struct MemCounters
+{
+	std::atomic<Sint64> liveObjects{ 0 };
+	std::atomic<Sint64> liveBytes{ 0 };
+	std::atomic<Sint64> peakBytes{ 0 };
+	std::atomic<Sint64> totalAllocs{ 0 };
+	std::atomic<Sint64> currentFrameAllocs{ 0 };
+	std::atomic<Sint64> currentFrameFrees{ 0 };
+	Sint64 frameAllocs = 0;
+	Sint64 frameFrees = 0;
+};
+
+static MemCounters counters[MEM_CATEGORY_COUNT];
+
+//global operator new calls this frame and last
+static std::atomic<Sint64> currentHeapAllocs{ 0 };
+static Sint64 heapAllocs = 0;
+
+static const char* categoryNames[MEM_CATEGORY_COUNT] = { "sprites", "textures", "particles", "tile map", "soft render", "capture", "frame arena", "scripts" };
+
+void memTrackAlloc(MemCategory category, size_t bytes)
+{
+	MemCounters& counter = counters[category];
+
+	counter.liveObjects++;
+	counter.totalAllocs++;
+	counter.currentFrameAllocs++;
+	Sint64 live = counter.liveBytes += (Sint64)bytes;
+
+	//raise peak if this allocation passed it
+	Sint64 peak = counter.peakBytes.load();
+	while(live > peak && !counter.peakBytes.compare_exchange_weak(peak, live))
+	{
+	}
+}
+
+void memTrackFree(MemCategory category, size_t bytes)
+{
+	MemCounters& counter = counters[category];
+
+	counter.liveObjects--;
+	counter.currentFrameFrees++;
+	counter.liveBytes -= (Sint64)bytes;
+}
+
+//estimate memory used by a texture from its size
+static size_t textureBytes(SDL_Texture* texture)
+{
+	int width = 0, height = 0;
+	SDL_QueryTexture(texture, NULL, NULL, &width, &height);
+
+	return (size_t)width * height * TEXTURE_BYTES_PER_PIXEL;
+}
+
+SDL_Texture* memTrackTexture(SDL_Texture* texture)
+{
+	if(texture != NULL)
+	{
+		memTrackAlloc(MEM_TEXTURE, textureBytes(texture));
+	}
+
+	return texture;
+}
+
+void memDestroyTexture(SDL_Texture* texture)
+{
+	if(texture != NULL)
+	{
+		memTrackFree(MEM_TEXTURE, textureBytes(texture));
+		SDL_DestroyTexture(texture);
+	}
+}
+
+void memTrackEndFrame()
+{
+	//move this frame's counts to last frame and start fresh
+	for(MemCounters& counter : counters)
+	{
+		counter.frameAllocs = counter.currentFrameAllocs.exchange(0);
+		counter.frameFrees = counter.currentFrameFrees.exchange(0);
+	}
+
+	heapAllocs = currentHeapAllocs.exchange(0);
+}
+
+Sint64 memTrackHeapAllocs()
+{
+#ifdef MEMTRACK_COUNT_NEW
+	return heapAllocs;
+#else
+	return -1;
+#endif
+}
+
+MemStats memTrackStats(MemCategory category)
+{
+	MemCounters& counter = counters[category];
+
+	MemStats stats;
+	stats.liveObjects = counter.liveObjects;
+	stats.liveBytes = counter.liveBytes;
+	stats.peakBytes = counter.peakBytes;
+	stats.totalAllocs = counter.totalAllocs;
+	stats.frameAllocs = counter.frameAllocs;
+	stats.frameFrees = counter.frameFrees;
+
+	return stats;
+}
+
+Sint64 memTrackLiveBytes()
+{
+	Sint64 total = 0;
+
+	for(MemCounters& counter : counters)
+	{
+		total += counter.liveBytes;
+	}
+
+	return total;
+}
+
+Sint64 memTrackProcessBytes()
+{
+#ifdef __linux__
+	//second field of statm is resident pages
+	long pages = 0, residentPages = 0;
+	FILE* statm = fopen("/proc/self/statm", "r");
+
+	if(statm != NULL)
+	{
+		if (fscanf(statm, "%ld %ld", &pages, &residentPages) != 2) { residentPages = 0; }
+		fclose(statm);
+	}
+
+	//page size is up to the kernel, 4 KB on most x86 but 16 or 64 KB on some ARM
+	return (Sint64)residentPages * sysconf(_SC_PAGESIZE);
+#else
+	return 0;
+#endif
+}
+
+const char* memTrackName(MemCategory category)
+{
+	return categoryNames[category];
+}
+
+Sint64 memTrackReport()
+{
+	Sint64 leaked = 0;
+
+	for(int i = 0; i < MEM_CATEGORY_COUNT; i++)
+	{
+		MemStats stats = memTrackStats((MemCategory)i);
+
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "Memory %-10s live: %lld (%lld bytes) peak: %lld bytes allocations: %lld\n",
+			categoryNames[i], (long long)stats.liveObjects, (long long)stats.liveBytes, (long long)stats.peakBytes, (long long)stats.totalAllocs);
+
+		//anything still alive at shutdown was never freed
+		if(stats.liveObjects != 0)
+		{
+			SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_WARN, "Leaked %lld %s (%lld bytes)\n",
+				(long long)stats.liveObjects, categoryNames[i], (long long)stats.liveBytes);
+			leaked += stats.liveObjects;
+		}
+	}
+
+	return leaked;
+}
+
+#ifdef MEMTRACK_COUNT_NEW
+//replacements count then use malloc. Array and nothrow forms call these by default
+void* operator new(size_t bytes)
+{
+	currentHeapAllocs.fetch_add(1, std::memory_order_relaxed);
+
+	void* pointer = malloc(bytes != 0 ? bytes : 1);
+	if (pointer == NULL) { throw std::bad_alloc(); }
+
+	return pointer;
+}
+
+void operator delete(void* pointer) noexcept
+{
+	free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+	free(pointer);
+}
+#endif
@@ -0,0 +1,72 @@
+/*
+Title:	MemTrack.h
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: header file for memory tracking in my game engine. Counts live objects and bytes per category, allocations per frame,
+	and reports anything still alive at shutdown as a leak. Counters are atomic so loader threads can use them.
+
+	Built with MEMTRACK_COUNT_NEW, on by default in debug builds, global operator new is replaced to count every heap
+	allocation made in a frame, for finding allocations left in the frame loop.
+ */
+
+#pragma once
+#ifndef MEMTRACK_H
+#define MEMTRACK_H
+
+#include <SDL.h>
+#include <cstddef>
+
+//count heap allocations in debug builds
+#if defined(_DEBUG) && !defined(MEMTRACK_COUNT_NEW)
+#define MEMTRACK_COUNT_NEW
+#endif
+
+//categories of tracked memory
+enum MemCategory
+{
+	MEM_SPRITE, MEM_TEXTURE, MEM_PARTICLE, MEM_TILEMAP, MEM_SOFTRENDER, MEM_CAPTURE, MEM_ARENA, MEM_SCRIPT, MEM_CATEGORY_COUNT
+};
+
+//counters for one category
+struct MemStats
+{
+	Sint64 liveObjects;
+	Sint64 liveBytes;
+	Sint64 peakBytes;
+	Sint64 totalAllocs;
+	Sint64 frameAllocs;		//allocations made during last finished frame
+	Sint64 frameFrees;		//frees made during last finished frame
+};
+
+//record an allocation or free of bytes in category
+void memTrackAlloc(MemCategory category, size_t bytes);
+void memTrackFree(MemCategory category, size_t bytes);
+
+//register a texture created by SDL and return it, NULL is ignored
+SDL_Texture* memTrackTexture(SDL_Texture* texture);
+
+//unregister and destroy a tracked texture, NULL is ignored
+void memDestroyTexture(SDL_Texture* texture);
+
+//close out per frame counters, call once at end of each frame
+void memTrackEndFrame();
+
+//get global operator new calls made during last finished frame, on any thread. -1 when not built to count them
+Sint64 memTrackHeapAllocs();
+
+//get counters for a category
+MemStats memTrackStats(MemCategory category);
+
+//get live bytes summed over every category
+Sint64 memTrackLiveBytes();
+
+//get resident memory of the process in bytes, 0 where not supported
+Sint64 memTrackProcessBytes();
+
+//get category name for reports
+const char* memTrackName(MemCategory category);
+
+//log live objects per category, returns number of leaked objects
+Sint64 memTrackReport();
+
+#endif
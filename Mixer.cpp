@@ -0,0 +1,311 @@
+/*
+Title:	Mixer.cpp
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: implementation file for Mixer class for my game engine
+ */
+
+#include "Mixer.h"
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+
+Mixer::Mixer()
+{
+	//initialize variables
+	device = 0;
+	deviceSpec = {};
+	soundCount.store(0);
+	commandHead.store(0);
+	commandTail.store(0);
+	activeVoices.store(0);
+	stolenVoices.store(0);
+	droppedCommands.store(0);
+	callbackTicks.store(0);
+	noiseState = 0x9E3779B9;
+
+	for(MixerVoice& voice : voices)
+	{
+		voice.sound = -1;
+	}
+}
+
+Mixer::~Mixer()
+{
+	free();
+}
+
+bool Mixer::open()
+{
+	if(device != 0)
+	{
+		return true;
+	}
+
+	if(SDL_InitSubSystem(SDL_INIT_AUDIO) < 0)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_AUDIO, SDL_LOG_PRIORITY_ERROR, "Unable to initialize audio! SDL Error: %s\n", SDL_GetError());
+		return false;
+	}
+
+	//small float stereo buffer keeps latency low and mixing simple. SDL converts if hardware wants otherwise
+	SDL_AudioSpec desired = {};
+	desired.freq = MIXER_FREQUENCY;
+	desired.format = AUDIO_F32SYS;
+	desired.channels = MIXER_CHANNELS;
+	desired.samples = MIXER_BUFFER_FRAMES;
+	desired.callback = audioCallback;
+	desired.userdata = this;
+
+	device = SDL_OpenAudioDevice(NULL, 0, &desired, &deviceSpec, SDL_AUDIO_ALLOW_FREQUENCY_CHANGE);
+	if(device == 0)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_AUDIO, SDL_LOG_PRIORITY_ERROR, "Unable to open audio device! SDL Error: %s\n", SDL_GetError());
+		SDL_QuitSubSystem(SDL_INIT_AUDIO);
+		return false;
+	}
+
+	SDL_LogMessage(SDL_LOG_CATEGORY_AUDIO, SDL_LOG_PRIORITY_INFO, "Audio on %s driver at %d Hz, %d frame buffer (%.1f ms)\n",
+		SDL_GetCurrentAudioDriver(), deviceSpec.freq, deviceSpec.samples, getLatencyMs());
+
+	//start callback
+	SDL_PauseAudioDevice(device, 0);
+
+	return true;
+}
+
+void Mixer::close()
+{
+	if(device == 0)
+	{
+		return;
+	}
+
+	SDL_CloseAudioDevice(device);
+	SDL_QuitSubSystem(SDL_INIT_AUDIO);
+	device = 0;
+
+	//nothing is playing anymore
+	for (MixerVoice& voice : voices) { voice.sound = -1; }
+	commandTail.store(commandHead.load());
+	activeVoices.store(0);
+}
+
+void Mixer::free()
+{
+	close();
+
+	for(int i = 0; i < soundCount.load(); i++)
+	{
+		sounds[i].samples.clear();
+		sounds[i].samples.shrink_to_fit();
+		sounds[i].frames = 0;
+	}
+	soundCount.store(0);
+}
+
+int Mixer::loadSound(std::string path)
+{
+	if(device == 0)
+	{
+		return -1;
+	}
+
+	SDL_AudioSpec wavSpec;
+	Uint8* wavBuffer = NULL;
+	Uint32 wavLength = 0;
+
+	if(SDL_LoadWAV(path.c_str(), &wavSpec, &wavBuffer, &wavLength) == NULL)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_AUDIO, SDL_LOG_PRIORITY_ERROR, "Unable to load sound %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		return -1;
+	}
+
+	//convert once now to exactly what callback mixes, float stereo at device rate
+	SDL_AudioCVT convert;
+	if(SDL_BuildAudioCVT(&convert, wavSpec.format, wavSpec.channels, wavSpec.freq, AUDIO_F32SYS, MIXER_CHANNELS, deviceSpec.freq) < 0)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_AUDIO, SDL_LOG_PRIORITY_ERROR, "Unable to convert sound %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		SDL_FreeWAV(wavBuffer);
+		return -1;
+	}
+
+	std::vector<Uint8> converted(wavLength * std::max(convert.len_mult, 1));
+	memcpy(converted.data(), wavBuffer, wavLength);
+	SDL_FreeWAV(wavBuffer);
+
+	convert.buf = converted.data();
+	convert.len = wavLength;
+	if(convert.needed && SDL_ConvertAudio(&convert) < 0)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_AUDIO, SDL_LOG_PRIORITY_ERROR, "Unable to convert sound %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		return -1;
+	}
+
+	int bytes = convert.needed ? convert.len_cvt : (int)wavLength;
+
+	MixerSound sound;
+	sound.frames = bytes / (int)(sizeof(float) * MIXER_CHANNELS);
+	sound.samples.assign((float*)converted.data(), (float*)converted.data() + sound.frames * MIXER_CHANNELS);
+
+	return addSound(sound);
+}
+
+int Mixer::makeNoiseBurst(float seconds, float cutoff, float volume)
+{
+	int rate = device != 0 ? deviceSpec.freq : MIXER_FREQUENCY;
+
+	MixerSound sound;
+	sound.frames = (int)(seconds * rate);
+	sound.samples.resize(sound.frames * MIXER_CHANNELS);
+
+	//white noise through a one pole low pass, fading out
+	float filtered = 0;
+	float smoothing = 1 - expf(-2 * (float)M_PI * cutoff / rate);
+
+	for(int i = 0; i < sound.frames; i++)
+	{
+		noiseState ^= noiseState << 13;
+		noiseState ^= noiseState >> 17;
+		noiseState ^= noiseState << 5;
+		float noise = (noiseState / 2147483648.0f) - 1;
+
+		filtered += (noise - filtered) * smoothing;
+
+		float envelope = 1 - (float)i / sound.frames;
+		float sample = filtered * envelope * envelope * volume;
+
+		sound.samples[i * 2] = sample;
+		sound.samples[i * 2 + 1] = sample;
+	}
+
+	return addSound(sound);
+}
+
+int Mixer::addSound(MixerSound& sound)
+{
+	int index = soundCount.load(std::memory_order_relaxed);
+
+	if(index >= MIXER_MAX_SOUNDS)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_AUDIO, SDL_LOG_PRIORITY_ERROR, "Too many sounds loaded\n");
+		return -1;
+	}
+
+	//fill slot before callback can see it
+	sounds[index].samples.swap(sound.samples);
+	sounds[index].frames = sound.frames;
+	soundCount.store(index + 1, std::memory_order_release);
+
+	return index;
+}
+
+void Mixer::play(int sound, float gain, float pan)
+{
+	if(device == 0 || sound < 0)
+	{
+		return;
+	}
+
+	Uint32 writeIndex = commandHead.load(std::memory_order_relaxed);
+
+	//drop play if callback is far behind rather than wait on it
+	if(writeIndex - commandTail.load(std::memory_order_acquire) >= MIXER_COMMAND_SIZE)
+	{
+		droppedCommands.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	pan = std::clamp(pan, -1.0f, 1.0f);
+
+	MixerCommand& command = commands[writeIndex & (MIXER_COMMAND_SIZE - 1)];
+	command.sound = sound;
+	command.leftGain = gain * std::min(1.0f, 1 - pan);
+	command.rightGain = gain * std::min(1.0f, 1 + pan);
+
+	commandHead.store(writeIndex + 1, std::memory_order_release);
+}
+
+void Mixer::audioCallback(void* userdata, Uint8* stream, int length)
+{
+	Mixer* mixer = (Mixer*)userdata;
+	Uint64 start = SDL_GetPerformanceCounter();
+
+	mixer->mix((float*)stream, length / (int)(sizeof(float) * MIXER_CHANNELS));
+
+	//track worst callback time
+	Uint64 ticks = SDL_GetPerformanceCounter() - start;
+	if (ticks > mixer->callbackTicks.load(std::memory_order_relaxed)) { mixer->callbackTicks.store(ticks, std::memory_order_relaxed); }
+}
+
+void Mixer::mix(float* out, int frames)
+{
+	int loadedSounds = soundCount.load(std::memory_order_acquire);
+
+	//start voices for waiting commands
+	Uint32 readIndex = commandTail.load(std::memory_order_relaxed);
+	Uint32 writeIndex = commandHead.load(std::memory_order_acquire);
+
+	for(; readIndex != writeIndex; readIndex++)
+	{
+		const MixerCommand& command = commands[readIndex & (MIXER_COMMAND_SIZE - 1)];
+
+		if(command.sound >= loadedSounds)
+		{
+			continue;
+		}
+
+		//take a free voice, or cut off the one furthest along
+		MixerVoice* chosen = &voices[0];
+		for(MixerVoice& voice : voices)
+		{
+			if (voice.sound < 0) { chosen = &voice; break; }
+			if (voice.frame > chosen->frame) { chosen = &voice; }
+		}
+
+		if (chosen->sound >= 0) { stolenVoices.fetch_add(1, std::memory_order_relaxed); }
+
+		chosen->sound = command.sound;
+		chosen->frame = 0;
+		chosen->leftGain = command.leftGain;
+		chosen->rightGain = command.rightGain;
+	}
+
+	commandTail.store(readIndex, std::memory_order_release);
+
+	//silence then add every voice
+	std::fill(out, out + frames * MIXER_CHANNELS, 0.0f);
+
+	int active = 0;
+	for(MixerVoice& voice : voices)
+	{
+		if(voice.sound < 0)
+		{
+			continue;
+		}
+
+		const MixerSound& sound = sounds[voice.sound];
+		int count = std::min(frames, sound.frames - voice.frame);
+		const float* source = sound.samples.data() + voice.frame * MIXER_CHANNELS;
+
+		for(int i = 0; i < count; i++)
+		{
+			out[i * 2] += source[i * 2] * voice.leftGain;
+			out[i * 2 + 1] += source[i * 2 + 1] * voice.rightGain;
+		}
+
+		voice.frame += count;
+
+		//free voice once sound is done
+		if (voice.frame >= sound.frames) { voice.sound = -1; }
+		else { active++; }
+	}
+
+	//keep many overlapping sounds from wrapping
+	for(int i = 0; i < frames * MIXER_CHANNELS; i++)
+	{
+		out[i] = std::clamp(out[i], -1.0f, 1.0f);
+	}
+
+	activeVoices.store(active, std::memory_order_relaxed);
+}
@@ -0,0 +1,121 @@
+/*
+Title:	Mixer.h
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: header file for Mixer class for my game engine. Mixes sound effects in the SDL audio callback from PCM that is decoded
+	and converted to the device format at load time, using a fixed pool of voices. The game thread only pushes play commands into
+	a lock-free ring, so the callback never allocates, locks or waits on the game.
+ */
+
+#pragma once
+#ifndef MIXER_H
+#define MIXER_H
+
+#include <SDL.h>
+#include <string>
+#include <vector>
+#include <atomic>
+
+//mixer constants
+const int MIXER_FREQUENCY = 48000;
+const int MIXER_CHANNELS = 2;
+const int MIXER_BUFFER_FRAMES = 256;		//about 5 ms at 48 kHz
+const int MIXER_MAX_SOUNDS = 32;
+const int MIXER_MAX_VOICES = 32;
+const Uint32 MIXER_COMMAND_SIZE = 256;		//must be a power of 2
+
+//a decoded sound, interleaved stereo float at device rate
+struct MixerSound
+{
+	std::vector<float> samples;
+	int frames;
+};
+
+//play request sent from game thread to audio callback
+struct MixerCommand
+{
+	int sound;
+	float leftGain;
+	float rightGain;
+};
+
+//a sound being played
+struct MixerVoice
+{
+	int sound;		//-1 if free
+	int frame;		//next frame to mix
+	float leftGain;
+	float rightGain;
+};
+
+class Mixer
+{
+public:
+	//initialize variables
+	Mixer();
+
+	//destructor
+	~Mixer();
+
+	//open audio device and start callback. Use the dummy or disk audio driver to run without sound hardware
+	bool open();
+
+	//stop callback and close device. Loaded sounds are kept until free
+	void close();
+
+	//close device and release sounds
+	void free();
+
+	//decode wav file into a sound, returns sound id or -1 on failure. Call after open and not from the callback
+	int loadSound(std::string path);
+
+	//make a sound from decaying noise for when no file is available, returns sound id or -1 if full
+	int makeNoiseBurst(float seconds, float cutoff, float volume);
+
+	//play sound with gain, pan is -1 for left to 1 for right. Safe from game thread, never blocks
+	void play(int sound, float gain = 1, float pan = 0);
+
+	//getters
+	bool isOpen() const { return device != 0; }
+	float getLatencyMs() const { return deviceSpec.samples * 1000.0f / deviceSpec.freq; }	//get buffer length in ms
+	int getActiveVoices() const { return activeVoices.load(std::memory_order_relaxed); }
+	Uint32 getStolenVoices() const { return stolenVoices.load(std::memory_order_relaxed); }	//get voices cut off to play newer sounds
+	Uint32 getDroppedCommands() const { return droppedCommands.load(std::memory_order_relaxed); }
+	double getCallbackMs() const { return callbackTicks.load(std::memory_order_relaxed) * 1000.0 / SDL_GetPerformanceFrequency(); }	//get longest callback run
+
+private:
+	//SDL audio callback, mixes active voices into stream
+	static void audioCallback(void* userdata, Uint8* stream, int length);
+
+	//mix one buffer on audio thread
+	void mix(float* out, int frames);
+
+	//publish a sound once its samples are ready
+	int addSound(MixerSound& sound);
+
+	//opened device and its format
+	SDL_AudioDeviceID device;
+	SDL_AudioSpec deviceSpec;
+
+	//loaded sounds. Slots below soundCount are never changed while device is open
+	MixerSound sounds[MIXER_MAX_SOUNDS];
+	std::atomic<int> soundCount;
+
+	//voices, only touched by callback
+	MixerVoice voices[MIXER_MAX_VOICES];
+
+	//play commands from game thread
+	MixerCommand commands[MIXER_COMMAND_SIZE];
+	alignas(64) std::atomic<Uint32> commandHead;
+	alignas(64) std::atomic<Uint32> commandTail;
+
+	//stats written by callback
+	std::atomic<int> activeVoices;
+	std::atomic<Uint32> stolenVoices;
+	std::atomic<Uint32> droppedCommands;
+	std::atomic<Uint64> callbackTicks;
+
+	//noise generator state for made sounds
+	Uint32 noiseState;
+};
+#endif
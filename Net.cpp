@@ -0,0 +1,149 @@
+/*
+Title:	Net.cpp
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: implementation file for networking in my game engine
+ */
+
+#include "Net.h"
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+typedef int socklen_t;
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+bool netInit()
+{
+#ifdef _WIN32
+	WSADATA wsaData;
+	if(WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Unable to initialize Winsock!\n");
+		return false;
+	}
+#endif
+	return true;
+}
+
+void netQuit()
+{
+#ifdef _WIN32
+	WSACleanup();
+#endif
+}
+
+bool netResolve(std::string host, Uint16 port, NetAddress& address)
+{
+	addrinfo hints = {};
+	hints.ai_family = AF_INET;
+	hints.ai_socktype = SOCK_DGRAM;
+
+	addrinfo* result = NULL;
+	if(getaddrinfo(host.c_str(), NULL, &hints, &result) != 0 || result == NULL)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Unable to resolve host %s\n", host.c_str());
+		return false;
+	}
+
+	address.host = ntohl(((sockaddr_in*)result->ai_addr)->sin_addr.s_addr);
+	address.port = port;
+
+	freeaddrinfo(result);
+	return true;
+}
+
+UdpSocket::UdpSocket()
+{
+	socketHandle = INVALID_HANDLE;
+}
+
+UdpSocket::~UdpSocket()
+{
+	close();
+}
+
+bool UdpSocket::open(Uint16 port)
+{
+	close();
+
+	socketHandle = (intptr_t)socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if(socketHandle == INVALID_HANDLE)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Unable to create UDP socket!\n");
+		return false;
+	}
+
+	//bind to any interface on port
+	sockaddr_in local = {};
+	local.sin_family = AF_INET;
+	local.sin_addr.s_addr = htonl(INADDR_ANY);
+	local.sin_port = htons(port);
+
+	if(bind(socketHandle, (sockaddr*)&local, sizeof(local)) != 0)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Unable to bind UDP port %d!\n", port);
+		close();
+		return false;
+	}
+
+	//don't block when nothing is waiting
+#ifdef _WIN32
+	u_long nonBlocking = 1;
+	ioctlsocket(socketHandle, FIONBIO, &nonBlocking);
+#else
+	fcntl(socketHandle, F_SETFL, fcntl(socketHandle, F_GETFL, 0) | O_NONBLOCK);
+#endif
+
+	return true;
+}
+
+void UdpSocket::close()
+{
+	if(socketHandle != INVALID_HANDLE)
+	{
+#ifdef _WIN32
+		closesocket(socketHandle);
+#else
+		::close(socketHandle);
+#endif
+	}
+
+	socketHandle = INVALID_HANDLE;
+}
+
+bool UdpSocket::send(const NetAddress& address, const void* data, int bytes)
+{
+	sockaddr_in remote = {};
+	remote.sin_family = AF_INET;
+	remote.sin_addr.s_addr = htonl(address.host);
+	remote.sin_port = htons(address.port);
+
+	return sendto(socketHandle, (const char*)data, bytes, 0, (sockaddr*)&remote, sizeof(remote)) == bytes;
+}
+
+int UdpSocket::receive(NetAddress& address, void* data, int maxBytes)
+{
+	sockaddr_in remote = {};
+	socklen_t remoteSize = sizeof(remote);
+
+	int bytes = (int)recvfrom(socketHandle, (char*)data, maxBytes, 0, (sockaddr*)&remote, &remoteSize);
+
+	//nothing waiting or error
+	if(bytes <= 0)
+	{
+		return 0;
+	}
+
+	address.host = ntohl(remote.sin_addr.s_addr);
+	address.port = ntohs(remote.sin_port);
+
+	return bytes;
+}
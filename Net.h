@@ -0,0 +1,148 @@
+/*
+Title:	Net.h
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: header file for networking in my game engine. Wraps non-blocking UDP sockets for Windows and POSIX, and has small
+	writer/reader classes for packing packets with variable length integers
+ */
+
+#pragma once
+#ifndef NET_H
+#define NET_H
+
+#include <SDL.h>
+#include <string>
+#include <cstring>
+
+//address of a socket in host byte order
+struct NetAddress
+{
+	Uint32 host;
+	Uint16 port;
+
+	bool operator==(const NetAddress& other) const { return host == other.host && port == other.port; }
+	bool operator!=(const NetAddress& other) const { return !(*this == other); }
+};
+
+//start and stop socket library, needed on Windows
+bool netInit();
+void netQuit();
+
+//look up host name or dotted address
+bool netResolve(std::string host, Uint16 port, NetAddress& address);
+
+class UdpSocket
+{
+public:
+	//initialize variables
+	UdpSocket();
+
+	//destructor
+	~UdpSocket();
+
+	//open non-blocking socket bound to port, 0 picks any free port
+	bool open(Uint16 port);
+
+	//close socket
+	void close();
+
+	//send datagram, returns false on failure
+	bool send(const NetAddress& address, const void* data, int bytes);
+
+	//receive one datagram if one is waiting. Returns bytes received, 0 if none waiting
+	int receive(NetAddress& address, void* data, int maxBytes);
+
+	//getters
+	bool isOpen() const { return socketHandle != INVALID_HANDLE; }
+
+private:
+	//handle value for no socket
+	static const intptr_t INVALID_HANDLE = -1;
+
+	//OS socket handle
+	intptr_t socketHandle;
+};
+
+//packs values into a packet buffer. Writes past capacity set the overflow flag instead of writing
+class NetWriter
+{
+public:
+	NetWriter(Uint8* buffer, int capacity) { data = buffer; this->capacity = capacity; size = 0; overflow = false; }
+
+	void writeBytes(const void* bytes, int count)
+	{
+		if (size + count > capacity) { overflow = true; return; }
+		memcpy(data + size, bytes, count);
+		size += count;
+	}
+
+	void writeU8(Uint8 value) { writeBytes(&value, 1); }
+	void writeU16(Uint16 value) { Uint8 bytes[2] = { (Uint8)value, (Uint8)(value >> 8) }; writeBytes(bytes, 2); }
+	void writeU32(Uint32 value) { Uint8 bytes[4] = { (Uint8)value, (Uint8)(value >> 8), (Uint8)(value >> 16), (Uint8)(value >> 24) }; writeBytes(bytes, 4); }
+
+	//7 bits per byte, high bit set while more bytes follow
+	void writeVarint(Uint32 value)
+	{
+		while (value >= 0x80) { writeU8((Uint8)(value | 0x80)); value >>= 7; }
+		writeU8((Uint8)value);
+	}
+
+	//zigzag so small negative values stay small
+	void writeSignedVarint(Sint32 value) { writeVarint(((Uint32)value << 1) ^ (Uint32)(value >> 31)); }
+
+	//getters
+	int getSize() const { return size; }
+	bool hasOverflowed() const { return overflow; }
+
+private:
+	Uint8* data;
+	int capacity;
+	int size;
+	bool overflow;
+};
+
+//unpacks values from a packet. Reads past the end set the error flag and return 0
+class NetReader
+{
+public:
+	NetReader(const Uint8* buffer, int size) { data = buffer; this->size = size; pos = 0; error = false; }
+
+	bool readBytes(void* bytes, int count)
+	{
+		if (pos + count > size) { error = true; memset(bytes, 0, count); return false; }
+		memcpy(bytes, data + pos, count);
+		pos += count;
+		return true;
+	}
+
+	Uint8 readU8() { Uint8 value = 0; readBytes(&value, 1); return value; }
+	Uint16 readU16() { Uint8 bytes[2]; readBytes(bytes, 2); return (Uint16)(bytes[0] | (bytes[1] << 8)); }
+	Uint32 readU32() { Uint8 bytes[4]; readBytes(bytes, 4); return (Uint32)bytes[0] | ((Uint32)bytes[1] << 8) | ((Uint32)bytes[2] << 16) | ((Uint32)bytes[3] << 24); }
+
+	Uint32 readVarint()
+	{
+		Uint32 value = 0;
+		for (int shift = 0; shift < 35 && !error; shift += 7)
+		{
+			Uint8 byte = readU8();
+			value |= (Uint32)(byte & 0x7F) << shift;
+			if (!(byte & 0x80)) { return value; }
+		}
+		error = true;
+		return 0;
+	}
+
+	Sint32 readSignedVarint() { Uint32 value = readVarint(); return (Sint32)(value >> 1) ^ -(Sint32)(value & 1); }
+
+	//getters
+	int getRemaining() const { return size - pos; }
+	const Uint8* getCurrent() const { return data + pos; }
+	bool hasError() const { return error; }
+
+private:
+	const Uint8* data;
+	int size;
+	int pos;
+	bool error;
+};
+#endif
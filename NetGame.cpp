@@ -0,0 +1,801 @@
+/*
+Title:	NetGame.cpp
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: implementation file for NetServer and NetClient classes for my game engine
+ */
+
+#include "NetGame.h"
+#include "FrameArena.h"
+#include <algorithm>
+
+//bytes before fragment data in a snapshot packet, at most
+const int NET_SNAPSHOT_HEADER = 12;
+
+//start a packet with protocol id and message type
+static void writeHeader(NetWriter& writer, NetMessage message)
+{
+	writer.writeU16(NET_PROTOCOL_ID);
+	writer.writeU8((Uint8)message);
+}
+
+//copy scene sprites into a frame sorted by id
+static void gatherFrame(Scene* scene, Uint32 tick, NetFrame& frame)
+{
+	frame.tick = tick;
+	frame.entities.clear();
+
+	for(int list = 0; list < 2; list++)
+	{
+		for(const Sprite& current : list == 0 ? scene->getEntities() : scene->getProjectiles())
+		{
+			NetEntity entity;
+			entity.id = current.getId();
+			entity.x = current.getX();
+			entity.y = current.getY();
+			entity.angle = current.getHeading();
+			entity.health = (Uint8)std::max(0, std::min(current.getHealth(), 255));
+			entity.flags = (current.isPlayer() ? NET_FLAG_PLAYER : 0) | (current.isProjectile() ? NET_FLAG_PROJECTILE : 0);
+			frame.entities.push_back(entity);
+		}
+	}
+
+	std::sort(frame.entities.begin(), frame.entities.end(), [](const NetEntity& a, const NetEntity& b) { return a.id < b.id; });
+}
+
+//fields of entity that differ from base
+static Uint8 changedFields(const NetEntity& base, const NetEntity& entity)
+{
+	Uint8 mask = 0;
+
+	if (entity.x != base.x) { mask |= NET_FIELD_X; }
+	if (entity.y != base.y) { mask |= NET_FIELD_Y; }
+	if (entity.angle != base.angle) { mask |= NET_FIELD_ANGLE; }
+	if (entity.health != base.health) { mask |= NET_FIELD_HEALTH; }
+	if (entity.flags != base.flags) { mask |= NET_FIELD_FLAGS; }
+
+	return mask;
+}
+
+size_t maxDeltaBytes(const NetFrame* base, const NetFrame& current)
+{
+	//every entity new with every field, and every base entity removed with a full 5 byte id gap
+	return 64 + current.entities.size() * 24 + (base != NULL ? base->entities.size() * 5 : 0);
+}
+
+void encodeDelta(NetWriter& writer, const NetFrame* base, const NetFrame& current)
+{
+	static const NetEntity zero = {};
+	const std::vector<NetEntity> empty;
+	const std::vector<NetEntity>& baseEntities = base != NULL ? base->entities : empty;
+
+	//first pass counts removed and changed entities so counts can lead
+	Uint32 removed = 0, changed = 0;
+	size_t b = 0, c = 0;
+	while(b < baseEntities.size() || c < current.entities.size())
+	{
+		if (c == current.entities.size() || (b < baseEntities.size() && baseEntities[b].id < current.entities[c].id)) { removed++; b++; }
+		else if (b == baseEntities.size() || current.entities[c].id < baseEntities[b].id) { changed++; c++; }
+		else { changed += changedFields(baseEntities[b], current.entities[c]) != 0; b++; c++; }
+	}
+
+	//removed ids as gaps from previous id
+	writer.writeVarint(removed);
+	Uint32 lastId = 0;
+	b = 0;
+	c = 0;
+	while(b < baseEntities.size())
+	{
+		if(c == current.entities.size() || baseEntities[b].id < current.entities[c].id)
+		{
+			writer.writeVarint(baseEntities[b].id - lastId);
+			lastId = baseEntities[b].id;
+			b++;
+		}
+		else
+		{
+			if (baseEntities[b].id == current.entities[c].id) { b++; }
+			c++;
+		}
+	}
+
+	//changed entities with only the fields that changed, as deltas from base
+	writer.writeVarint(changed);
+	lastId = 0;
+	b = 0;
+	for(c = 0; c < current.entities.size(); c++)
+	{
+		const NetEntity& entity = current.entities[c];
+
+		//find base entity with same id, new entities delta against zero with every field
+		while (b < baseEntities.size() && baseEntities[b].id < entity.id) { b++; }
+		bool isNew = b == baseEntities.size() || baseEntities[b].id != entity.id;
+		const NetEntity& from = isNew ? zero : baseEntities[b];
+		Uint8 mask = isNew ? (NET_FIELD_X | NET_FIELD_Y | NET_FIELD_ANGLE | NET_FIELD_HEALTH | NET_FIELD_FLAGS) : changedFields(from, entity);
+
+		if(mask == 0)
+		{
+			continue;
+		}
+
+		writer.writeVarint(entity.id - lastId);
+		lastId = entity.id;
+		writer.writeU8(mask);
+
+		if (mask & NET_FIELD_X) { writer.writeSignedVarint(entity.x - from.x); }
+		if (mask & NET_FIELD_Y) { writer.writeSignedVarint(entity.y - from.y); }
+		if (mask & NET_FIELD_ANGLE) { writer.writeU16(entity.angle); }
+		if (mask & NET_FIELD_HEALTH) { writer.writeU8(entity.health); }
+		if (mask & NET_FIELD_FLAGS) { writer.writeU8(entity.flags); }
+	}
+}
+
+bool decodeDelta(NetReader& reader, const NetFrame* base, NetFrame& frame)
+{
+	static const NetEntity zero = {};
+	const std::vector<NetEntity> empty;
+	const std::vector<NetEntity>& baseEntities = base != NULL ? base->entities : empty;
+
+	frame.entities.clear();
+
+	//removed ids, sorted like base
+	Uint32 removed = reader.readVarint();
+	if (removed > (Uint32)reader.getRemaining()) { return false; }
+
+	FrameVector<Uint32> removedIds(removed);
+	Uint32 lastId = 0;
+	for(Uint32 i = 0; i < removed; i++)
+	{
+		lastId += reader.readVarint();
+		removedIds[i] = lastId;
+	}
+
+	Uint32 changed = reader.readVarint();
+	if (changed > (Uint32)reader.getRemaining()) { return false; }
+
+	size_t b = 0, r = 0;
+	lastId = 0;
+
+	//copy base entities below id that weren't removed
+	auto copyBaseBelow = [&](Uint32 id, bool all)
+	{
+		while(b < baseEntities.size() && (all || baseEntities[b].id < id))
+		{
+			while (r < removedIds.size() && removedIds[r] < baseEntities[b].id) { r++; }
+			if (r == removedIds.size() || removedIds[r] != baseEntities[b].id) { frame.entities.push_back(baseEntities[b]); }
+			b++;
+		}
+	};
+
+	for(Uint32 i = 0; i < changed && !reader.hasError(); i++)
+	{
+		Uint32 id = lastId + reader.readVarint();
+		lastId = id;
+		Uint8 mask = reader.readU8();
+
+		copyBaseBelow(id, false);
+
+		//start from base entity with same id, or zero for a new entity
+		NetEntity entity = zero;
+		if(b < baseEntities.size() && baseEntities[b].id == id)
+		{
+			entity = baseEntities[b];
+			b++;
+		}
+		entity.id = id;
+
+		if (mask & NET_FIELD_X) { entity.x += reader.readSignedVarint(); }
+		if (mask & NET_FIELD_Y) { entity.y += reader.readSignedVarint(); }
+		if (mask & NET_FIELD_ANGLE) { entity.angle = reader.readU16(); }
+		if (mask & NET_FIELD_HEALTH) { entity.health = reader.readU8(); }
+		if (mask & NET_FIELD_FLAGS) { entity.flags = reader.readU8(); }
+
+		frame.entities.push_back(entity);
+	}
+
+	//rest of base is unchanged
+	copyBaseBelow(0, true);
+
+	return !reader.hasError();
+}
+
+NetServer::NetServer()
+{
+	//initialize variables
+	scene = NULL;
+	playerTexture = NULL;
+	tick = 1;
+	lastStats = 0;
+
+	for(Client& client : clients)
+	{
+		client.active = false;
+		client.sprite = NULL_HANDLE;
+		client.spriteId = 0;
+	}
+}
+
+NetServer::~NetServer()
+{
+	stop();
+}
+
+bool NetServer::start(Scene* scene, Uint16 port, SDL_Texture* playerTexture)
+{
+	if(!socket.open(port))
+	{
+		return false;
+	}
+
+	this->scene = scene;
+	this->playerTexture = playerTexture;
+	lastStats = SDL_GetTicks64();
+
+	SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "Server listening on UDP port %d\n", port);
+
+	return true;
+}
+
+void NetServer::stop()
+{
+	if(!socket.isOpen())
+	{
+		return;
+	}
+
+	//let clients know server is leaving
+	for(Client& client : clients)
+	{
+		if(client.active)
+		{
+			Uint8 packet[8];
+			NetWriter writer(packet, sizeof(packet));
+			writeHeader(writer, NET_DISCONNECT);
+			socket.send(client.address, packet, writer.getSize());
+
+			//sprites belong to scene, which frees them
+			client.active = false;
+			client.sprite = NULL_HANDLE;
+		}
+	}
+
+	socket.close();
+}
+
+void NetServer::receive()
+{
+	Uint8 packet[NET_MAX_PACKET];
+	NetAddress address;
+	int bytes;
+
+	while((bytes = socket.receive(address, packet, sizeof(packet))) > 0)
+	{
+		NetReader reader(packet, bytes);
+
+		//ignore packets that aren't ours
+		if(reader.readU16() != NET_PROTOCOL_ID)
+		{
+			continue;
+		}
+
+		Uint8 message = reader.readU8();
+		Client* client = findClient(address);
+
+		if(message == NET_CONNECT)
+		{
+			handleConnect(address);
+		}
+		else if(client != NULL && message == NET_INPUT)
+		{
+			client->lastHeard = SDL_GetTicks64();
+			handleInput(*client, reader);
+		}
+		else if(client != NULL && message == NET_DISCONNECT)
+		{
+			SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "Client %08x:%d left\n", address.host, address.port);
+			dropClient(*client);
+		}
+	}
+}
+
+void NetServer::handleConnect(const NetAddress& address)
+{
+	//client may resend connect if welcome was lost
+	Client* existing = findClient(address);
+	if(existing != NULL)
+	{
+		sendWelcome(*existing);
+		return;
+	}
+
+	for(int i = 0; i < NET_MAX_CLIENTS; i++)
+	{
+		Client& client = clients[i];
+
+		if(!client.active)
+		{
+			client.active = true;
+			client.address = address;
+			client.lastInputTick = 0;
+			client.ackTick = 0;
+			client.echoTime = 0;
+			client.lastHeard = SDL_GetTicks64();
+			client.bytesSent = 0;
+			for (NetFrame& frame : client.history) { frame.tick = 0; }
+
+			//give client a player spread around center of screen
+			Sprite* sprite = scene->addSprite(true, ENTITY, playerTexture);
+			sprite->setPos(SCREEN_X_CENTER - sprite->getWidth() / 2 + (i % 4 - 2) * 64, SCREEN_Y_CENTER - sprite->getHeight() / 2 + (i / 4 - 2) * 64);
+			client.sprite = sprite->getHandle();
+			client.spriteId = sprite->getId();
+
+			SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "Client %08x:%d joined as player %u\n", address.host, address.port, client.spriteId);
+
+			sendWelcome(client);
+			return;
+		}
+	}
+
+	SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_WARN, "Server full, ignoring %08x:%d\n", address.host, address.port);
+}
+
+void NetServer::sendWelcome(Client& client)
+{
+	Uint8 packet[16];
+	NetWriter writer(packet, sizeof(packet));
+	writeHeader(writer, NET_WELCOME);
+	writer.writeU32(client.spriteId);
+
+	socket.send(client.address, packet, writer.getSize());
+}
+
+void NetServer::handleInput(Client& client, NetReader& reader)
+{
+	Uint32 inputTick = reader.readVarint();
+	Uint32 ackTick = reader.readVarint();
+	Uint32 sendTime = reader.readU32();
+	int count = std::min((int)reader.readU8(), NET_INPUT_REDUNDANCY);
+
+	//newest input wins, but a shot in any input not seen yet still fires
+	PlayerInput newest = {};
+	bool fire = false;
+
+	for(int i = 0; i < count; i++)
+	{
+		PlayerInput input;
+		input.keys = reader.readU8();
+		input.fire = reader.readU8();
+		input.aimX = (Sint16)reader.readSignedVarint();
+		input.aimY = (Sint16)reader.readSignedVarint();
+
+		if (i == 0) { newest = input; }
+		if (inputTick - i > client.lastInputTick && input.fire) { fire = true; }
+	}
+
+	//drop malformed or out of order packets
+	if(reader.hasError() || count == 0 || inputTick <= client.lastInputTick)
+	{
+		return;
+	}
+
+	newest.fire = fire;
+	Sprite* sprite = scene->getEntity(client.sprite);
+	if (sprite != NULL) { sprite->setInput(newest); }
+	client.lastInputTick = inputTick;
+	client.echoTime = sendTime;
+
+	//acks can arrive out of order, keep newest
+	if (ackTick > client.ackTick && ackTick < tick) { client.ackTick = ackTick; }
+}
+
+void NetServer::sendSnapshots()
+{
+	Uint64 now = SDL_GetTicks64();
+
+	gatherFrame(scene, tick, current);
+
+	for(Client& client : clients)
+	{
+		if(!client.active)
+		{
+			continue;
+		}
+
+		if(now - client.lastHeard > NET_TIMEOUT_MS)
+		{
+			SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "Client %08x:%d timed out\n", client.address.host, client.address.port);
+			dropClient(client);
+			continue;
+		}
+
+		//delta against last snapshot client acked if it is still kept
+		NetFrame* base = NULL;
+		if(client.ackTick != 0 && client.history[client.ackTick % NET_HISTORY].tick == client.ackTick)
+		{
+			base = &client.history[client.ackTick % NET_HISTORY];
+		}
+
+		//room for worst case body
+		body.resize(maxDeltaBytes(base, current));
+
+		NetWriter bodyWriter(body.data(), (int)body.size());
+		bodyWriter.writeVarint(base != NULL ? base->tick : 0);
+		bodyWriter.writeU32(client.echoTime);
+		encodeDelta(bodyWriter, base, current);
+
+		//split body into fragments that fit a packet
+		int fragmentSize = NET_MAX_PACKET - NET_SNAPSHOT_HEADER;
+		int fragmentCount = (bodyWriter.getSize() + fragmentSize - 1) / fragmentSize;
+
+		if(bodyWriter.hasOverflowed() || fragmentCount > NET_MAX_FRAGMENTS)
+		{
+			SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Snapshot too large to send\n");
+			continue;
+		}
+
+		for(int fragment = 0; fragment < fragmentCount; fragment++)
+		{
+			Uint8 packet[NET_MAX_PACKET];
+			NetWriter writer(packet, sizeof(packet));
+			writeHeader(writer, NET_SNAPSHOT);
+			writer.writeVarint(tick);
+			writer.writeU8((Uint8)fragment);
+			writer.writeU8((Uint8)fragmentCount);
+
+			int offset = fragment * fragmentSize;
+			writer.writeBytes(body.data() + offset, std::min(fragmentSize, bodyWriter.getSize() - offset));
+
+			socket.send(client.address, packet, writer.getSize());
+			client.bytesSent += writer.getSize();
+		}
+
+		//keep what was sent as a possible base, reusing the slot's memory
+		NetFrame& kept = client.history[tick % NET_HISTORY];
+		kept.tick = tick;
+		kept.entities.assign(current.entities.begin(), current.entities.end());
+	}
+
+	//log bandwidth per client
+	if(now - lastStats >= NET_STATS_MS)
+	{
+		for(Client& client : clients)
+		{
+			if(client.active)
+			{
+				SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "Client %u: %.1f KB/s, %d entities, acked %u ticks ago\n",
+					client.spriteId, client.bytesSent / 1024.0 / ((now - lastStats) / 1000.0), (int)current.entities.size(), tick - client.ackTick);
+				client.bytesSent = 0;
+			}
+		}
+		lastStats = now;
+	}
+
+	tick++;
+}
+
+int NetServer::getClientCount() const
+{
+	int count = 0;
+
+	for(const Client& client : clients)
+	{
+		count += client.active;
+	}
+
+	return count;
+}
+
+void NetServer::dropClient(Client& client)
+{
+	scene->removeSprite(scene->getEntity(client.sprite));
+	client.sprite = NULL_HANDLE;
+	client.active = false;
+}
+
+NetServer::Client* NetServer::findClient(const NetAddress& address)
+{
+	for(Client& client : clients)
+	{
+		if(client.active && client.address == address)
+		{
+			return &client;
+		}
+	}
+
+	return NULL;
+}
+
+NetClient::NetClient()
+{
+	//initialize variables
+	scene = NULL;
+	server = { 0, 0 };
+	playerId = 0;
+	tick = 0;
+	ackTick = 0;
+	assemblyTick = 0;
+	assemblyCount = 0;
+	assemblyReceived = 0;
+	lastConnectTry = 0;
+	lastHeard = 0;
+	roundTrip = 0;
+	bytesReceived = 0;
+	lastStats = 0;
+
+	for (PlayerInput& input : inputs) { input = {}; }
+	for (NetFrame& frame : history) { frame.tick = 0; }
+	shown.tick = 0;
+	incoming.tick = 0;
+}
+
+NetClient::~NetClient()
+{
+	disconnect();
+}
+
+bool NetClient::connect(Scene* scene, std::string host, Uint16 port)
+{
+	if(!netResolve(host, port, server) || !socket.open(0))
+	{
+		return false;
+	}
+
+	this->scene = scene;
+	lastStats = SDL_GetTicks64();
+
+	SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "Connecting to %s:%d\n", host.c_str(), port);
+
+	return true;
+}
+
+void NetClient::disconnect()
+{
+	if(!socket.isOpen())
+	{
+		return;
+	}
+
+	Uint8 packet[8];
+	NetWriter writer(packet, sizeof(packet));
+	writeHeader(writer, NET_DISCONNECT);
+	socket.send(server, packet, writer.getSize());
+
+	socket.close();
+	playerId = 0;
+}
+
+void NetClient::sendInput(const PlayerInput& input)
+{
+	Uint64 now = SDL_GetTicks64();
+	Uint8 packet[NET_MAX_PACKET];
+	NetWriter writer(packet, sizeof(packet));
+
+	//ask to join until welcomed
+	if(!isConnected())
+	{
+		if(now - lastConnectTry >= NET_CONNECT_RETRY_MS)
+		{
+			writeHeader(writer, NET_CONNECT);
+			socket.send(server, packet, writer.getSize());
+			lastConnectTry = now;
+		}
+		return;
+	}
+
+	//shift recent inputs and add newest
+	tick++;
+	for (int i = NET_INPUT_REDUNDANCY - 1; i > 0; i--) { inputs[i] = inputs[i - 1]; }
+	inputs[0] = input;
+
+	int count = (int)std::min(tick, (Uint32)NET_INPUT_REDUNDANCY);
+
+	writeHeader(writer, NET_INPUT);
+	writer.writeVarint(tick);
+	writer.writeVarint(ackTick);
+	writer.writeU32((Uint32)now);
+	writer.writeU8((Uint8)count);
+
+	for(int i = 0; i < count; i++)
+	{
+		writer.writeU8(inputs[i].keys);
+		writer.writeU8(inputs[i].fire);
+		writer.writeSignedVarint(inputs[i].aimX);
+		writer.writeSignedVarint(inputs[i].aimY);
+	}
+
+	socket.send(server, packet, writer.getSize());
+}
+
+void NetClient::receive()
+{
+	Uint8 packet[NET_MAX_PACKET];
+	NetAddress address;
+	int bytes;
+	Uint64 now = SDL_GetTicks64();
+
+	while((bytes = socket.receive(address, packet, sizeof(packet))) > 0)
+	{
+		NetReader reader(packet, bytes);
+
+		//ignore anyone but server and packets that aren't ours
+		if(address != server || reader.readU16() != NET_PROTOCOL_ID)
+		{
+			continue;
+		}
+
+		bytesReceived += bytes;
+		lastHeard = now;
+
+		Uint8 message = reader.readU8();
+
+		if(message == NET_WELCOME && !isConnected())
+		{
+			playerId = reader.readU32();
+			SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "Joined server as player %u\n", playerId);
+		}
+		else if(message == NET_SNAPSHOT && isConnected())
+		{
+			Uint32 snapshotTick = reader.readVarint();
+			int fragment = reader.readU8();
+			int fragmentCount = reader.readU8();
+
+			//skip snapshots older than newest decoded
+			if(reader.hasError() || snapshotTick <= ackTick || fragment >= fragmentCount)
+			{
+				continue;
+			}
+
+			//start assembling a newer snapshot, dropping any unfinished one
+			if(snapshotTick != assemblyTick)
+			{
+				if (snapshotTick < assemblyTick) { continue; }
+				assemblyTick = snapshotTick;
+				assemblyCount = fragmentCount;
+				assemblyReceived = 0;
+				fragments.resize(fragmentCount);
+				for (std::vector<Uint8>& part : fragments) { part.clear(); }
+			}
+
+			if(fragmentCount != assemblyCount || !fragments[fragment].empty())
+			{
+				continue;
+			}
+
+			fragments[fragment].assign(reader.getCurrent(), reader.getCurrent() + reader.getRemaining());
+			assemblyReceived++;
+
+			//decode once every fragment is in
+			if(assemblyReceived == assemblyCount)
+			{
+				FrameVector<Uint8> whole;
+				for (std::vector<Uint8>& part : fragments) { whole.insert(whole.end(), part.begin(), part.end()); }
+				handleSnapshot(snapshotTick, whole.data(), (int)whole.size());
+			}
+		}
+		else if(message == NET_DISCONNECT)
+		{
+			SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "Server closed connection\n");
+			playerId = 0;
+		}
+	}
+
+	//server went quiet, start asking to join again
+	if(isConnected() && now - lastHeard > NET_TIMEOUT_MS)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_WARN, "Lost connection to server\n");
+		playerId = 0;
+		ackTick = 0;
+		assemblyTick = 0;
+	}
+
+	//log latency and bandwidth
+	if(now - lastStats >= NET_STATS_MS)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "Net: round trip %u ms, %.1f KB/s down, %d entities\n",
+			roundTrip, bytesReceived / 1024.0 / ((now - lastStats) / 1000.0), (int)shown.entities.size());
+		bytesReceived = 0;
+		lastStats = now;
+	}
+}
+
+void NetClient::handleSnapshot(Uint32 snapshotTick, const Uint8* data, int size)
+{
+	NetReader reader(data, size);
+	Uint32 baseTick = reader.readVarint();
+	Uint32 echoTime = reader.readU32();
+
+	//base must be a snapshot still kept
+	const NetFrame* base = NULL;
+	if(baseTick != 0)
+	{
+		if(history[baseTick % NET_HISTORY].tick != baseTick)
+		{
+			return;
+		}
+		base = &history[baseTick % NET_HISTORY];
+	}
+
+	if(!decodeDelta(reader, base, incoming))
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_WARN, "Dropped malformed snapshot %u\n", snapshotTick);
+		return;
+	}
+
+	//keep decoded frame as a base and ack it
+	incoming.tick = snapshotTick;
+	std::swap(history[snapshotTick % NET_HISTORY], incoming);
+	ackTick = snapshotTick;
+
+	if (echoTime != 0) { roundTrip = (Uint32)SDL_GetTicks64() - echoTime; }
+
+	applyFrame(history[snapshotTick % NET_HISTORY]);
+}
+
+void NetClient::applyFrame(const NetFrame& frame)
+{
+	//effects for shots fired and enemies killed since last frame shown
+	size_t s = 0;
+	FrameVector<Uint32> killed;
+	for(const NetEntity& entity : frame.entities)
+	{
+		while(s < shown.entities.size() && shown.entities[s].id < entity.id)
+		{
+			if (!(shown.entities[s].flags & (NET_FLAG_PLAYER | NET_FLAG_PROJECTILE))) { killed.push_back(shown.entities[s].id); }
+			s++;
+		}
+
+		bool isNew = s == shown.entities.size() || shown.entities[s].id != entity.id;
+		if (!isNew) { s++; }
+
+		if(isNew && (entity.flags & NET_FLAG_PROJECTILE) && shown.tick != 0)
+		{
+			scene->emitMuzzleFlash((float)entity.x, (float)entity.y, (float)fixedAngleToRadians(entity.angle));
+		}
+	}
+	for (; s < shown.entities.size(); s++)
+	{
+		if (!(shown.entities[s].flags & (NET_FLAG_PLAYER | NET_FLAG_PROJECTILE))) { killed.push_back(shown.entities[s].id); }
+	}
+
+	//killed enemies are still in scene, burst at their centers
+	if(!killed.empty())
+	{
+		for(const Sprite& current : scene->getEntities())
+		{
+			if (std::find(killed.begin(), killed.end(), current.getId()) != killed.end()) { scene->emitEnemyDeath(current.getCenter()); }
+		}
+	}
+
+	//split frame into scene's entity and projectile lists
+	entityStates.clear();
+	projectileStates.clear();
+	for(const NetEntity& entity : frame.entities)
+	{
+		SpriteState state = {};
+		state.id = entity.id;
+		state.x = entity.x;
+		state.y = entity.y;
+		state.heading = entity.angle;
+		state.health = entity.health;
+		state.player = (entity.flags & NET_FLAG_PLAYER) != 0;
+		state.projectile = (entity.flags & NET_FLAG_PROJECTILE) != 0;
+
+		if (state.projectile) { projectileStates.push_back(state); }
+		else { entityStates.push_back(state); }
+	}
+
+	scene->setSprites(entityStates.data(), (Uint32)entityStates.size(), projectileStates.data(), (Uint32)projectileStates.size());
+
+	//local player is the sprite server gave us
+	for(const Sprite& current : scene->getEntities())
+	{
+		if(current.getId() == playerId)
+		{
+			scene->setPlayer(scene->getEntity(current.getHandle()));
+			break;
+		}
+	}
+
+	shown.tick = frame.tick;
+	shown.entities.assign(frame.entities.begin(), frame.entities.end());
+}
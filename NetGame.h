@@ -0,0 +1,237 @@
+/*
+Title:	NetGame.h
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: header file for NetServer and NetClient classes for my game engine. The server runs the only simulation and gives each
+	client its own player sprite. Clients send their input every tick, and the server sends back the scene as a delta against
+	the last snapshot that client acknowledged, so only entities that changed cost bandwidth.
+
+	Every packet starts with Uint16 NET_PROTOCOL_ID and Uint8 message type.
+		NET_CONNECT		client asks to join, resent until welcomed
+		NET_WELCOME		Uint32 id of client's player sprite
+		NET_INPUT		varint tick, varint acked snapshot tick, Uint32 send time, Uint8 count, then count inputs newest first
+		NET_SNAPSHOT	varint tick, Uint8 fragment, Uint8 fragment count, then a fragment of the snapshot body
+		NET_DISCONNECT	either side is leaving
+
+	Snapshot body: varint base tick (0 for none), Uint32 echoed client time, varint removed count, removed ids as varint gaps,
+	varint changed count, then per changed entity varint id gap, Uint8 field mask and the masked fields as deltas from base
+ */
+
+#pragma once
+#ifndef NETGAME_H
+#define NETGAME_H
+
+#include <SDL.h>
+#include <vector>
+#include <string>
+#include "Net.h"
+#include "Scene.h"
+#include "Sprite.h"
+
+//network constants
+const Uint16 NET_PROTOCOL_ID = 0x4D47;
+const Uint16 NET_DEFAULT_PORT = 27015;
+const int NET_MAX_PACKET = 1200;				//stays under common MTU
+const int NET_MAX_FRAGMENTS = 255;
+const int NET_MAX_CLIENTS = 16;
+const int NET_HISTORY = 32;						//snapshots kept as delta bases
+const int NET_INPUT_REDUNDANCY = 4;				//past inputs resent with each input packet
+const Uint32 NET_TIMEOUT_MS = 5000;
+const Uint32 NET_CONNECT_RETRY_MS = 250;
+const Uint32 NET_STATS_MS = 5000;
+
+//message types
+enum NetMessage
+{
+	NET_CONNECT = 1, NET_WELCOME, NET_INPUT, NET_SNAPSHOT, NET_DISCONNECT
+};
+
+//entity flags and delta field mask bits
+const Uint8 NET_FLAG_PLAYER = 1;
+const Uint8 NET_FLAG_PROJECTILE = 2;
+const Uint8 NET_FIELD_X = 1;
+const Uint8 NET_FIELD_Y = 2;
+const Uint8 NET_FIELD_ANGLE = 4;
+const Uint8 NET_FIELD_HEALTH = 8;
+const Uint8 NET_FIELD_FLAGS = 16;
+
+//entity state sent over the network
+struct NetEntity
+{
+	Uint32 id;
+	Sint32 x;
+	Sint32 y;
+	FixedAngle angle;	//heading, already 65536ths of a turn so it is sent as is
+	Uint8 health;
+	Uint8 flags;
+};
+
+//state of the scene at a tick, sorted by id
+struct NetFrame
+{
+	Uint32 tick;
+	std::vector<NetEntity> entities;
+};
+
+//most bytes a snapshot body holding delta of current against base can take, header included
+size_t maxDeltaBytes(const NetFrame* base, const NetFrame& current);
+
+//write removed and changed entities of current against base. Base may be NULL to send everything
+void encodeDelta(NetWriter& writer, const NetFrame* base, const NetFrame& current);
+
+//rebuild frame from base and delta written by encodeDelta. Returns false on a malformed delta
+bool decodeDelta(NetReader& reader, const NetFrame* base, NetFrame& frame);
+
+class NetServer
+{
+public:
+	//initialize variables
+	NetServer();
+
+	//destructor
+	~NetServer();
+
+	//open server port. Player sprites for clients are made with player texture
+	bool start(Scene* scene, Uint16 port, SDL_Texture* playerTexture);
+
+	//tell clients and close port
+	void stop();
+
+	//handle waiting packets, applying newest inputs to player sprites
+	void receive();
+
+	//send this tick's scene to every client, call after simulating
+	void sendSnapshots();
+
+	//getters
+	int getClientCount() const;
+	Uint32 getTick() const { return tick; }
+
+private:
+	//a connected client
+	struct Client
+	{
+		bool active;
+		NetAddress address;
+		SlotHandle sprite;
+		Uint32 spriteId;
+		Uint32 lastInputTick;
+		Uint32 ackTick;
+		Uint32 echoTime;
+		Uint64 lastHeard;
+		Uint64 bytesSent;
+		NetFrame history[NET_HISTORY];
+	};
+
+	//handle join request
+	void handleConnect(const NetAddress& address);
+
+	//handle input packet from client
+	void handleInput(Client& client, NetReader& reader);
+
+	//remove client and its sprite
+	void dropClient(Client& client);
+
+	//find client by address, NULL if none
+	Client* findClient(const NetAddress& address);
+
+	//send welcome with client's sprite id
+	void sendWelcome(Client& client);
+
+	//scene being served
+	Scene* scene;
+
+	//texture for player sprites
+	SDL_Texture* playerTexture;
+
+	UdpSocket socket;
+	Client clients[NET_MAX_CLIENTS];
+
+	//current server tick, starts at 1 so 0 can mean no base
+	Uint32 tick;
+
+	//scene state gathered this tick
+	NetFrame current;
+
+	//reused packet buffers
+	std::vector<Uint8> body;
+
+	//when stats were last logged
+	Uint64 lastStats;
+};
+
+class NetClient
+{
+public:
+	//initialize variables
+	NetClient();
+
+	//destructor
+	~NetClient();
+
+	//open socket and start asking server to join
+	bool connect(Scene* scene, std::string host, Uint16 port);
+
+	//tell server and close socket
+	void disconnect();
+
+	//send this tick's input, or join request until welcomed
+	void sendInput(const PlayerInput& input);
+
+	//handle waiting packets and apply newest complete snapshot to scene
+	void receive();
+
+	//getters
+	bool isConnected() const { return playerId != 0; }
+	Uint32 getRoundTrip() const { return roundTrip; }	//get last round trip time in ms
+
+private:
+	//decode a complete snapshot body and apply it
+	void handleSnapshot(Uint32 snapshotTick, const Uint8* data, int size);
+
+	//push frame to scene sprites, spawning effects for new shots and dead enemies
+	void applyFrame(const NetFrame& frame);
+
+	//scene shown
+	Scene* scene;
+
+	UdpSocket socket;
+	NetAddress server;
+
+	//id of this client's player sprite, 0 until welcomed
+	Uint32 playerId;
+
+	//client tick and recent inputs, newest first
+	Uint32 tick;
+	PlayerInput inputs[NET_INPUT_REDUNDANCY];
+
+	//decoded snapshots kept as delta bases
+	NetFrame history[NET_HISTORY];
+
+	//frame being decoded, swapped into history once complete
+	NetFrame incoming;
+
+	//newest snapshot tick decoded, acked to server
+	Uint32 ackTick;
+
+	//fragments of snapshot being assembled
+	Uint32 assemblyTick;
+	int assemblyCount;
+	int assemblyReceived;
+	std::vector<std::vector<Uint8>> fragments;
+
+	//last frame applied to scene, for spotting new and removed entities
+	NetFrame shown;
+
+	//reused sprite states for scene
+	std::vector<SpriteState> entityStates;
+	std::vector<SpriteState> projectileStates;
+
+	//connection timing and stats
+	Uint64 lastConnectTry;
+	Uint64 lastHeard;
+	Uint32 roundTrip;
+	Uint64 bytesReceived;
+	Uint64 lastStats;
+};
+#endif
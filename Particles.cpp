@@ -0,0 +1,347 @@
+/*
+Title:	Particles.cpp
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: implementation file for ParticleSystem class for my game engine
+ */
+
+#include "Particles.h"
+#include "MemTrack.h"
+#include "PerfOverlay.h"
+#include <cmath>
+#include <cstring>
+
+//allocate a zeroed, SIMD aligned buffer
+template <typename T>
+static T* allocBuffer(int count)
+{
+	T* buffer = (T*)SDL_SIMDAlloc(sizeof(T) * count);
+	if (buffer != NULL) { memset(buffer, 0, sizeof(T) * count); }
+	return buffer;
+}
+
+ParticleSystem::ParticleSystem()
+{
+	//initialize everything to NULL
+	posX = NULL;
+	posY = NULL;
+	velX = NULL;
+	velY = NULL;
+	life = NULL;
+	maxLife = NULL;
+	rotCos = NULL;
+	rotSin = NULL;
+	deadMasks = NULL;
+	vertices = NULL;
+	indices = NULL;
+
+	count = 0;
+	capacity = 0;
+
+	particleTexture = NULL;
+	width = 0;
+	height = 0;
+	color = { 255, 255, 255, 255 };
+	drag = 1;
+	shrink = false;
+
+	randState = 0x9E3779B9;
+}
+
+ParticleSystem::~ParticleSystem()
+{
+	free();
+}
+
+bool ParticleSystem::init(int capacity, int width, int height, SDL_Color color, float drag, bool shrink)
+{
+	free();
+
+	//round capacity up so SIMD loops never run past the buffers
+	capacity = (capacity + 7) & ~7;
+
+	posX = allocBuffer<float>(capacity);
+	posY = allocBuffer<float>(capacity);
+	velX = allocBuffer<float>(capacity);
+	velY = allocBuffer<float>(capacity);
+	life = allocBuffer<float>(capacity);
+	maxLife = allocBuffer<float>(capacity);
+	rotCos = allocBuffer<float>(capacity);
+	rotSin = allocBuffer<float>(capacity);
+	deadMasks = allocBuffer<Uint8>(capacity / PARTICLE_LANES);
+	vertices = allocBuffer<SDL_Vertex>(capacity * 4);
+	indices = allocBuffer<int>(capacity * 6);
+
+	if(posX == NULL || posY == NULL || velX == NULL || velY == NULL || life == NULL || maxLife == NULL ||
+		rotCos == NULL || rotSin == NULL || deadMasks == NULL || vertices == NULL || indices == NULL)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Unable to allocate particle buffers\n");
+		free();
+		return false;
+	}
+
+	//quad indices never change so they are built once
+	for(int i = 0; i < capacity; i++)
+	{
+		int* quad = &indices[i * 6];
+		quad[0] = i * 4;
+		quad[1] = i * 4 + 1;
+		quad[2] = i * 4 + 2;
+		quad[3] = i * 4;
+		quad[4] = i * 4 + 2;
+		quad[5] = i * 4 + 3;
+
+		//texture coordinates never change either
+		vertices[i * 4].tex_coord = { 0, 0 };
+		vertices[i * 4 + 1].tex_coord = { 1, 0 };
+		vertices[i * 4 + 2].tex_coord = { 1, 1 };
+		vertices[i * 4 + 3].tex_coord = { 0, 1 };
+	}
+
+	this->capacity = capacity;
+	this->width = width;
+	this->height = height;
+	this->color = color;
+	this->drag = drag;
+	this->shrink = shrink;
+	count = 0;
+
+	//track buffers as one allocation
+	memTrackAlloc(MEM_PARTICLE, getBufferBytes());
+
+	return true;
+}
+
+void ParticleSystem::free()
+{
+	if(capacity > 0)
+	{
+		memTrackFree(MEM_PARTICLE, getBufferBytes());
+	}
+
+	SDL_SIMDFree(posX);
+	SDL_SIMDFree(posY);
+	SDL_SIMDFree(velX);
+	SDL_SIMDFree(velY);
+	SDL_SIMDFree(life);
+	SDL_SIMDFree(maxLife);
+	SDL_SIMDFree(rotCos);
+	SDL_SIMDFree(rotSin);
+	SDL_SIMDFree(deadMasks);
+	SDL_SIMDFree(vertices);
+	SDL_SIMDFree(indices);
+
+	posX = NULL;
+	posY = NULL;
+	velX = NULL;
+	velY = NULL;
+	life = NULL;
+	maxLife = NULL;
+	rotCos = NULL;
+	rotSin = NULL;
+	deadMasks = NULL;
+	vertices = NULL;
+	indices = NULL;
+
+	count = 0;
+	capacity = 0;
+
+	//texture is owned by caller
+	particleTexture = NULL;
+}
+
+void ParticleSystem::emit(float x, float y, float velX, float velY, float life, float angle)
+{
+	//drop particle if buffers are full
+	if(count >= capacity || life <= 0)
+	{
+		return;
+	}
+
+	posX[count] = x;
+	posY[count] = y;
+	this->velX[count] = velX;
+	this->velY[count] = velY;
+	this->life[count] = life;
+	maxLife[count] = life;
+	rotCos[count] = cosf(angle);
+	rotSin[count] = sinf(angle);
+
+	count++;
+}
+
+void ParticleSystem::emitBurst(float x, float y, int count, float angle, float spread, float minSpeed, float maxSpeed, float minLife, float maxLife)
+{
+	for(int i = 0; i < count; i++)
+	{
+		//pick a direction within spread of angle
+		float particleAngle = angle + randRange(-spread, spread);
+		float speed = randRange(minSpeed, maxSpeed);
+
+		emit(x, y, speed * cosf(particleAngle), speed * sinf(particleAngle), randRange(minLife, maxLife), particleAngle);
+	}
+}
+
+void ParticleSystem::update()
+{
+	//round up to whole SIMD groups, lanes past count are ignored
+	int groups = (count + PARTICLE_LANES - 1) / PARTICLE_LANES;
+	bool anyDead = false;
+
+#if PARTICLE_LANES == 8
+	__m256 dragLanes = _mm256_set1_ps(drag);
+	__m256 one = _mm256_set1_ps(1.0f);
+	__m256 zero = _mm256_setzero_ps();
+
+	for(int group = 0; group < groups; group++)
+	{
+		int i = group * 8;
+
+		//move by velocity then slow velocity by drag
+		__m256 vx = _mm256_load_ps(velX + i);
+		__m256 vy = _mm256_load_ps(velY + i);
+		_mm256_store_ps(posX + i, _mm256_add_ps(_mm256_load_ps(posX + i), vx));
+		_mm256_store_ps(posY + i, _mm256_add_ps(_mm256_load_ps(posY + i), vy));
+		_mm256_store_ps(velX + i, _mm256_mul_ps(vx, dragLanes));
+		_mm256_store_ps(velY + i, _mm256_mul_ps(vy, dragLanes));
+
+		//age particles and mark dead lanes
+		__m256 age = _mm256_sub_ps(_mm256_load_ps(life + i), one);
+		_mm256_store_ps(life + i, age);
+		deadMasks[group] = (Uint8)_mm256_movemask_ps(_mm256_cmp_ps(age, zero, _CMP_LE_OQ));
+		anyDead |= deadMasks[group] != 0;
+	}
+#elif PARTICLE_LANES == 4
+	__m128 dragLanes = _mm_set1_ps(drag);
+	__m128 one = _mm_set1_ps(1.0f);
+	__m128 zero = _mm_setzero_ps();
+
+	for(int group = 0; group < groups; group++)
+	{
+		int i = group * 4;
+
+		//move by velocity then slow velocity by drag
+		__m128 vx = _mm_load_ps(velX + i);
+		__m128 vy = _mm_load_ps(velY + i);
+		_mm_store_ps(posX + i, _mm_add_ps(_mm_load_ps(posX + i), vx));
+		_mm_store_ps(posY + i, _mm_add_ps(_mm_load_ps(posY + i), vy));
+		_mm_store_ps(velX + i, _mm_mul_ps(vx, dragLanes));
+		_mm_store_ps(velY + i, _mm_mul_ps(vy, dragLanes));
+
+		//age particles and mark dead lanes
+		__m128 age = _mm_sub_ps(_mm_load_ps(life + i), one);
+		_mm_store_ps(life + i, age);
+		deadMasks[group] = (Uint8)_mm_movemask_ps(_mm_cmple_ps(age, zero));
+		anyDead |= deadMasks[group] != 0;
+	}
+#else
+	for(int i = 0; i < groups; i++)
+	{
+		posX[i] += velX[i];
+		posY[i] += velY[i];
+		velX[i] *= drag;
+		velY[i] *= drag;
+		life[i] -= 1;
+		deadMasks[i] = life[i] <= 0;
+		anyDead |= deadMasks[i] != 0;
+	}
+#endif
+
+	if(anyDead)
+	{
+		compact();
+	}
+}
+
+void ParticleSystem::compact()
+{
+	int groups = (count + PARTICLE_LANES - 1) / PARTICLE_LANES;
+
+	//walk groups from the end so particles swapped in from the tail are always alive
+	for(int group = groups - 1; group >= 0; group--)
+	{
+		if(deadMasks[group] == 0)
+		{
+			continue;
+		}
+
+		for(int lane = PARTICLE_LANES - 1; lane >= 0; lane--)
+		{
+			int i = group * PARTICLE_LANES + lane;
+
+			//skip live lanes and lanes past the end
+			if(i >= count || !(deadMasks[group] & (1 << lane)))
+			{
+				continue;
+			}
+
+			//move last particle into dead slot
+			count--;
+			posX[i] = posX[count];
+			posY[i] = posY[count];
+			velX[i] = velX[count];
+			velY[i] = velY[count];
+			life[i] = life[count];
+			maxLife[i] = maxLife[count];
+			rotCos[i] = rotCos[count];
+			rotSin[i] = rotSin[count];
+		}
+	}
+}
+
+void ParticleSystem::draw(SDL_Renderer* renderer)
+{
+	if(count == 0)
+	{
+		return;
+	}
+
+	float halfWidth = width / 2.0f;
+	float halfHeight = height / 2.0f;
+
+	//build one rotated quad per particle
+	for(int i = 0; i < count; i++)
+	{
+		float lifeLeft = life[i] / maxLife[i];
+		float scale = shrink ? lifeLeft : 1.0f;
+
+		//rotated half extents
+		float wx = halfWidth * scale * rotCos[i];
+		float wy = halfWidth * scale * rotSin[i];
+		float hx = -halfHeight * scale * rotSin[i];
+		float hy = halfHeight * scale * rotCos[i];
+
+		//fade alpha as particle dies
+		SDL_Color particleColor = color;
+		particleColor.a = (Uint8)(color.a * lifeLeft);
+
+		SDL_Vertex* quad = &vertices[i * 4];
+		quad[0].position = { posX[i] - wx - hx, posY[i] - wy - hy };
+		quad[1].position = { posX[i] + wx - hx, posY[i] + wy - hy };
+		quad[2].position = { posX[i] + wx + hx, posY[i] + wy + hy };
+		quad[3].position = { posX[i] - wx + hx, posY[i] - wy + hy };
+		quad[0].color = particleColor;
+		quad[1].color = particleColor;
+		quad[2].color = particleColor;
+		quad[3].color = particleColor;
+	}
+
+	SDL_RenderGeometry(renderer, particleTexture, vertices, count * 4, indices, count * 6);
+	perfCountDraw();
+}
+
+size_t ParticleSystem::getBufferBytes() const
+{
+	//eight float fields, masks, four vertices and six indices per particle
+	return (size_t)capacity * (8 * sizeof(float) + 4 * sizeof(SDL_Vertex) + 6 * sizeof(int)) + capacity / PARTICLE_LANES;
+}
+
+float ParticleSystem::randRange(float min, float max)
+{
+	//xorshift random
+	randState ^= randState << 13;
+	randState ^= randState >> 17;
+	randState ^= randState << 5;
+
+	return min + (max - min) * ((randState & 0xFFFFFF) / 16777216.0f);
+}
@@ -0,0 +1,109 @@
+/*
+Title:	Particles.h
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: header file for ParticleSystem class for my game engine. Particles are kept in structure of arrays buffers so they can
+	be updated several at a time with SIMD, and are drawn in one batched geometry call per system.
+ */
+
+#pragma once
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+#include <SDL.h>
+
+//use SIMD when building for x86
+#if defined(__AVX__)
+#include <immintrin.h>
+#define PARTICLE_LANES 8
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PARTICLE_LANES 4
+#else
+#define PARTICLE_LANES 1
+#endif
+
+//particle constants
+const int MAX_PARTICLES = 65536;
+
+class ParticleSystem
+{
+public:
+	//initialize variables
+	ParticleSystem();
+
+	//destructor
+	~ParticleSystem();
+
+	//allocate buffers. Texture may be NULL to draw plain colored quads
+	bool init(int capacity, int width, int height, SDL_Color color, float drag, bool shrink);
+
+	//deallocates resources
+	void free();
+
+	//sets texture drawn for each particle
+	void setTexture(SDL_Texture* texture) { particleTexture = texture; }
+
+	//add one particle. Life is in frames, angle is in radians
+	void emit(float x, float y, float velX, float velY, float life, float angle);
+
+	//add a burst of particles spread around a direction
+	void emitBurst(float x, float y, int count, float angle, float spread, float minSpeed, float maxSpeed, float minLife, float maxLife);
+
+	//advance particles by one frame and remove dead ones
+	void update();
+
+	//draw all particles in one call
+	void draw(SDL_Renderer* renderer);
+
+	//getters
+	int getCount() const { return count; }			//get number of live particles
+	int getCapacity() const { return capacity; }	//get max number of particles
+
+private:
+	//random float between min and max, kept separate from game rand() so effects don't change gameplay
+	float randRange(float min, float max);
+
+	//get size of all buffers in bytes
+	size_t getBufferBytes() const;
+
+	//remove dead particles by swapping in live particles from the end
+	void compact();
+
+	//particle buffers, one array per field
+	float* posX;
+	float* posY;
+	float* velX;
+	float* velY;
+	float* life;
+	float* maxLife;
+	float* rotCos;
+	float* rotSin;
+
+	//one dead lane mask per SIMD group, filled by update
+	Uint8* deadMasks;
+
+	//batched geometry buffers
+	SDL_Vertex* vertices;
+	int* indices;
+
+	//number of live particles and buffer size
+	int count;
+	int capacity;
+
+	//shared look of particles in this system
+	SDL_Texture* particleTexture;
+	int width;
+	int height;
+	SDL_Color color;
+
+	//velocity multiplier per frame
+	float drag;
+
+	//flag if particles shrink as they die
+	bool shrink;
+
+	//random state
+	Uint32 randState;
+};
+#endif
@@ -0,0 +1,311 @@
+/*
+Title:	PerfOverlay.cpp
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: implementation file for PerfOverlay class for my game engine
+ */
+
+#include "PerfOverlay.h"
+#include "MemTrack.h"
+#include "FrameArena.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+//draw calls made so far this frame
+static int drawCallCount = 0;
+
+//names and graph colors of phases
+static const char* phaseNames[PERF_PHASE_COUNT] = { "input", "logic", "draw", "overlay", "present", "wait" };
+static const SDL_Color phaseColors[PERF_PHASE_COUNT] =
+{
+	{ 80, 140, 255, 255 }, { 90, 220, 90, 255 }, { 255, 150, 40, 255 }, { 230, 70, 230, 255 }, { 240, 230, 60, 255 }, { 90, 90, 90, 255 }
+};
+
+void perfCountDraw()
+{
+	drawCallCount++;
+}
+
+PerfOverlay::PerfOverlay()
+{
+	//initialize variables
+	mRenderer = NULL;
+	atlas = NULL;
+	memset(glyphs, 0, sizeof(glyphs));
+	white = { 0, 0, 0, 0 };
+	lineHeight = 0;
+	memset(history, 0, sizeof(history));
+	historyFrame = 0;
+	framesRecorded = 0;
+	memset(phaseTimes, 0, sizeof(phaseTimes));
+	lastMark = 0;
+	msPerCount = 1000.0 / SDL_GetPerformanceFrequency();
+	timing = false;
+	drawCalls = 0;
+	memset(lines, 0, sizeof(lines));
+	framesSinceText = PERF_TEXT_FRAMES;
+	budgetMs = 0;
+	visible = false;
+}
+
+PerfOverlay::~PerfOverlay()
+{
+	free();
+}
+
+bool PerfOverlay::init(SDL_Renderer* renderer, std::string fontPath, int fontSize, float budgetMs)
+{
+	free();
+
+	TTF_Font* font = TTF_OpenFont(fontPath.c_str(), fontSize);
+	if(font == NULL)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Unable to load overlay font! SDL ttf Error: %s\n", TTF_GetError());
+		return false;
+	}
+
+	lineHeight = TTF_FontHeight(font);
+
+	//render every glyph once, measuring a single row atlas with a gap between glyphs
+	SDL_Surface* rendered[PERF_GLYPH_COUNT];
+	int atlasWidth = 0;
+
+	for(int i = 0; i < PERF_GLYPH_COUNT; i++)
+	{
+		int advance = 0;
+		TTF_GlyphMetrics(font, (Uint16)(PERF_GLYPH_FIRST + i), NULL, NULL, NULL, NULL, &advance);
+		rendered[i] = TTF_RenderGlyph_Blended(font, (Uint16)(PERF_GLYPH_FIRST + i), { 255, 255, 255, 255 });
+
+		glyphs[i].advance = (float)advance;
+		glyphs[i].width = rendered[i] != NULL ? (float)rendered[i]->w : 0;
+		atlasWidth += (int)glyphs[i].width + 1;
+	}
+
+	TTF_CloseFont(font);
+
+	//white block after glyphs, for bars and panel
+	atlasWidth += 2;
+
+	SDL_Surface* atlasSurface = SDL_CreateRGBSurfaceWithFormat(0, atlasWidth, lineHeight, 32, SDL_PIXELFORMAT_ARGB8888);
+	if(atlasSurface == NULL)
+	{
+		for (SDL_Surface* surface : rendered) { SDL_FreeSurface(surface); }
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Unable to create overlay atlas! SDL Error: %s\n", SDL_GetError());
+		return false;
+	}
+
+	SDL_FillRect(atlasSurface, NULL, 0);
+
+	int x = 0;
+	for(int i = 0; i < PERF_GLYPH_COUNT; i++)
+	{
+		if(rendered[i] != NULL)
+		{
+			//copy glyph alpha instead of blending it onto clear pixels
+			SDL_SetSurfaceBlendMode(rendered[i], SDL_BLENDMODE_NONE);
+			SDL_Rect dest = { x, 0, rendered[i]->w, rendered[i]->h };
+			SDL_BlitSurface(rendered[i], NULL, atlasSurface, &dest);
+			SDL_FreeSurface(rendered[i]);
+		}
+
+		glyphs[i].source = { (float)x / atlasWidth, 0, glyphs[i].width / atlasWidth, 1 };
+		x += (int)glyphs[i].width + 1;
+	}
+
+	//sample middle of white block so filtering never reaches a glyph
+	SDL_Rect whiteRect = { x, 0, 2, 2 };
+	SDL_FillRect(atlasSurface, &whiteRect, SDL_MapRGBA(atlasSurface->format, 255, 255, 255, 255));
+	white = { (x + 1.0f) / atlasWidth, 1.0f / lineHeight, 0, 0 };
+
+	//left out of texture memory shown, overlay must not change its own numbers
+	atlas = SDL_CreateTextureFromSurface(renderer, atlasSurface);
+	SDL_FreeSurface(atlasSurface);
+
+	if(atlas == NULL)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Unable to create overlay texture! SDL Error: %s\n", SDL_GetError());
+		return false;
+	}
+
+	SDL_SetTextureBlendMode(atlas, SDL_BLENDMODE_BLEND);
+
+	mRenderer = renderer;
+	this->budgetMs = budgetMs;
+
+	//room for panel, graph bars and text so drawing never allocates
+	int quads = 2 + PERF_HISTORY * PERF_PHASE_COUNT + PERF_TEXT_LINES * PERF_TEXT_LENGTH;
+	vertices.reserve(quads * 4);
+	indices.reserve(quads * 6);
+
+	return true;
+}
+
+void PerfOverlay::free()
+{
+	if(atlas != NULL)
+	{
+		SDL_DestroyTexture(atlas);
+	}
+
+	atlas = NULL;
+	mRenderer = NULL;
+}
+
+void PerfOverlay::beginFrame()
+{
+	Uint64 now = SDL_GetPerformanceCounter();
+
+	//keep finished frame in history
+	if(timing)
+	{
+		memcpy(history[historyFrame], phaseTimes, sizeof(phaseTimes));
+		historyFrame = (historyFrame + 1) % PERF_HISTORY;
+		framesRecorded++;
+	}
+
+	memset(phaseTimes, 0, sizeof(phaseTimes));
+	lastMark = now;
+	timing = true;
+
+	drawCalls = drawCallCount;
+	drawCallCount = 0;
+}
+
+void PerfOverlay::endPhase(PerfPhase phase)
+{
+	Uint64 now = SDL_GetPerformanceCounter();
+	phaseTimes[phase] += (float)((now - lastMark) * msPerCount);
+	lastMark = now;
+}
+
+void PerfOverlay::draw(const Scene& scene)
+{
+	if(!visible || atlas == NULL)
+	{
+		return;
+	}
+
+	//text changes slowly enough to read
+	if(++framesSinceText >= PERF_TEXT_FRAMES)
+	{
+		updateText(scene);
+		framesSinceText = 0;
+	}
+
+	vertices.clear();
+	indices.clear();
+
+	float graphWidth = (float)(PERF_HISTORY * PERF_BAR_WIDTH);
+	float textHeight = (float)(PERF_TEXT_LINES * lineHeight);
+
+	//dark panel behind everything
+	addQuad(4, 4, graphWidth + 8, textHeight + PERF_GRAPH_HEIGHT + 12, white, { 0, 0, 0, 170 });
+
+	for(int i = 0; i < PERF_TEXT_LINES; i++)
+	{
+		addText(8, 8 + (float)(i * lineHeight), lines[i], { 255, 255, 255, 255 });
+	}
+
+	//frame time graph, oldest frame at left with phases stacked from bottom
+	float baseline = 8 + textHeight + PERF_GRAPH_HEIGHT;
+	float pixelsPerMs = PERF_GRAPH_HEIGHT / PERF_GRAPH_MS;
+	int frames = std::min(framesRecorded, PERF_HISTORY);
+
+	for(int i = 0; i < frames; i++)
+	{
+		const float* times = history[(historyFrame - frames + i + PERF_HISTORY) % PERF_HISTORY];
+		float x = 8 + (float)((PERF_HISTORY - frames + i) * PERF_BAR_WIDTH);
+		float top = baseline;
+
+		for(int phase = 0; phase < PERF_PHASE_COUNT && top > baseline - PERF_GRAPH_HEIGHT; phase++)
+		{
+			float height = std::min(times[phase] * pixelsPerMs, top - (baseline - PERF_GRAPH_HEIGHT));
+			if (height <= 0) { continue; }
+
+			top -= height;
+			addQuad(x, top, PERF_BAR_WIDTH, height, white, phaseColors[phase]);
+		}
+	}
+
+	//frame budget line
+	addQuad(8, baseline - budgetMs * pixelsPerMs, graphWidth, 1, white, { 255, 60, 60, 255 });
+
+	SDL_RenderGeometry(mRenderer, atlas, vertices.data(), (int)vertices.size(), indices.data(), (int)indices.size());
+
+	endPhase(PERF_OVERLAY);
+}
+
+void PerfOverlay::updateText(const Scene& scene)
+{
+	//average and worst of recent frames
+	int frames = std::min(std::min(framesRecorded, PERF_HISTORY), PERF_TEXT_FRAMES);
+	float average[PERF_PHASE_COUNT] = { 0 };
+	float frameAverage = 0;
+	float frameMax = 0;
+
+	for(int i = 0; i < frames; i++)
+	{
+		const float* times = history[(historyFrame - 1 - i + PERF_HISTORY) % PERF_HISTORY];
+		float total = 0;
+
+		for(int phase = 0; phase < PERF_PHASE_COUNT; phase++)
+		{
+			average[phase] += times[phase] / frames;
+			total += times[phase];
+		}
+
+		frameAverage += total / frames;
+		frameMax = std::max(frameMax, total);
+	}
+
+	const float megabyte = 1024.0f * 1024.0f;
+
+	snprintf(lines[0], PERF_TEXT_LENGTH, "frame %.2f ms avg  %.2f ms max  %.0f fps", frameAverage, frameMax, frameAverage > 0 ? 1000 / frameAverage : 0);
+	snprintf(lines[1], PERF_TEXT_LENGTH, "%s %.2f  %s %.2f  %s %.2f", phaseNames[PERF_INPUT], average[PERF_INPUT],
+		phaseNames[PERF_LOGIC], average[PERF_LOGIC], phaseNames[PERF_DRAW], average[PERF_DRAW]);
+	snprintf(lines[2], PERF_TEXT_LENGTH, "%s %.2f  %s %.2f  %s %.2f", phaseNames[PERF_OVERLAY], average[PERF_OVERLAY],
+		phaseNames[PERF_PRESENT], average[PERF_PRESENT], phaseNames[PERF_WAIT], average[PERF_WAIT]);
+	snprintf(lines[3], PERF_TEXT_LENGTH, "enemies %d (lod %d/%d/%d)  projectiles %d", scene.getEnemyCount(),
+		scene.getLodCount(0), scene.getLodCount(1), scene.getLodCount(2), scene.countProjectiles());
+	//heap allocations are only counted in debug builds
+	char heapAllocs[24] = "-";
+	if (memTrackHeapAllocs() >= 0) { snprintf(heapAllocs, sizeof(heapAllocs), "%lld", (long long)memTrackHeapAllocs()); }
+
+	snprintf(lines[4], PERF_TEXT_LENGTH, "particles %d/%d  draw calls %d  arena %.0f KB  heap allocs %s", scene.getParticleCount(),
+		scene.getParticleCapacity(), drawCalls, frameArena.getPeak() / 1024.0f, heapAllocs);
+	snprintf(lines[5], PERF_TEXT_LENGTH, "textures %.1f MB  tracked %.1f MB  process %.1f MB", memTrackStats(MEM_TEXTURE).liveBytes / megabyte,
+		memTrackLiveBytes() / megabyte, memTrackProcessBytes() / megabyte);
+
+	const LatencyStats& latency = scene.getInputLatency();
+	snprintf(lines[6], PERF_TEXT_LENGTH, "input to present p50 %.1f  p95 %.1f  p99 %.1f ms", latency.percentile(0.5f),
+		latency.percentile(0.95f), latency.percentile(0.99f));
+}
+
+void PerfOverlay::addQuad(float x, float y, float w, float h, const SDL_FRect& source, SDL_Color color)
+{
+	int first = (int)vertices.size();
+
+	vertices.push_back({ { x, y }, color, { source.x, source.y } });
+	vertices.push_back({ { x + w, y }, color, { source.x + source.w, source.y } });
+	vertices.push_back({ { x + w, y + h }, color, { source.x + source.w, source.y + source.h } });
+	vertices.push_back({ { x, y + h }, color, { source.x, source.y + source.h } });
+
+	//two triangles
+	int corners[6] = { 0, 1, 2, 0, 2, 3 };
+	for (int corner : corners) { indices.push_back(first + corner); }
+}
+
+void PerfOverlay::addText(float x, float y, const char* text, SDL_Color color)
+{
+	for(const char* c = text; *c != '\0'; c++)
+	{
+		int index = (unsigned char)*c - PERF_GLYPH_FIRST;
+		if (index < 0 || index >= PERF_GLYPH_COUNT) { continue; }
+
+		const Glyph& glyph = glyphs[index];
+		if (glyph.width > 0) { addQuad(x, y, glyph.width, (float)lineHeight, glyph.source, color); }
+
+		x += glyph.advance;
+	}
+}
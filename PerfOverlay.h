@@ -0,0 +1,124 @@
+/*
+Title:	PerfOverlay.h
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: header file for PerfOverlay class for my game engine. A HUD toggled with F3 that shows frame time split into phases,
+	entity counts, particle pool use, draw calls and memory, for finding frame spikes on a live machine without a profiler.
+	Glyphs are rendered once into an atlas with a white block for untextured shapes, so the whole overlay is one geometry
+	call. Its own time is kept in its own phase, and its draw call and atlas texture are left out of the counts it shows.
+ */
+
+#pragma once
+#ifndef PERFOVERLAY_H
+#define PERFOVERLAY_H
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <string>
+#include <vector>
+#include "Scene.h"
+
+//overlay constants
+const int PERF_HISTORY = 180;			//frames shown in graph
+const int PERF_TEXT_FRAMES = 15;		//frames averaged for each text update
+const int PERF_TEXT_LINES = 7;
+const int PERF_TEXT_LENGTH = 128;
+const int PERF_GLYPH_FIRST = 32;		//printable ASCII
+const int PERF_GLYPH_COUNT = 95;
+const float PERF_GRAPH_MS = 50.0f;		//frame time at top of graph
+const int PERF_GRAPH_HEIGHT = 100;
+const int PERF_BAR_WIDTH = 2;
+
+//parts of a frame that are timed
+enum PerfPhase
+{
+	PERF_INPUT, PERF_LOGIC, PERF_DRAW, PERF_OVERLAY, PERF_PRESENT, PERF_WAIT, PERF_PHASE_COUNT
+};
+
+//count a draw call sent to the renderer this frame
+void perfCountDraw();
+
+class PerfOverlay
+{
+public:
+	//initialize variables
+	PerfOverlay();
+
+	//destructor
+	~PerfOverlay();
+
+	//build glyph atlas from font. budgetMs is marked on graph
+	bool init(SDL_Renderer* renderer, std::string fontPath, int fontSize, float budgetMs);
+
+	//deallocates resources
+	void free();
+
+	//show or hide
+	void toggle() { visible = !visible; }
+	void setVisible(bool visible) { this->visible = visible; }
+
+	//close out last frame's timings and start a new frame
+	void beginFrame();
+
+	//add time since last mark to phase
+	void endPhase(PerfPhase phase);
+
+	//draw overlay for scene if visible, timed as PERF_OVERLAY
+	void draw(const Scene& scene);
+
+	//getters
+	bool isVisible() const { return visible; }
+	int getDrawCalls() const { return drawCalls; }	//get draw calls counted last frame
+
+private:
+	//where a glyph is in atlas
+	struct Glyph
+	{
+		SDL_FRect source;	//texture coordinates
+		float width;
+		float advance;
+	};
+
+	//rebuild text lines from recent frames
+	void updateText(const Scene& scene);
+
+	//add a quad of part of atlas to batch
+	void addQuad(float x, float y, float w, float h, const SDL_FRect& source, SDL_Color color);
+
+	//add a line of text to batch
+	void addText(float x, float y, const char* text, SDL_Color color);
+
+	SDL_Renderer* mRenderer;
+
+	//glyphs and white block in one texture
+	SDL_Texture* atlas;
+	Glyph glyphs[PERF_GLYPH_COUNT];
+	SDL_FRect white;
+	int lineHeight;
+
+	//quads drawn this frame, reused
+	std::vector<SDL_Vertex> vertices;
+	std::vector<int> indices;
+
+	//phase times in ms of recent frames, oldest overwritten
+	float history[PERF_HISTORY][PERF_PHASE_COUNT];
+	int historyFrame;
+	int framesRecorded;
+
+	//frame being timed
+	float phaseTimes[PERF_PHASE_COUNT];
+	Uint64 lastMark;
+	double msPerCount;
+	bool timing;
+
+	//draw calls made last frame
+	int drawCalls;
+
+	//text shown, updated every PERF_TEXT_FRAMES
+	char lines[PERF_TEXT_LINES][PERF_TEXT_LENGTH];
+	int framesSinceText;
+
+	float budgetMs;
+	bool visible;
+};
+#endif
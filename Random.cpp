@@ -0,0 +1,33 @@
+/*
+Title:	Random.cpp
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: implementation file for Random class for my game engine
+ */
+
+#include "Random.h"
+
+Random::Random()
+{
+	seed(1);
+}
+
+void Random::seed(Uint64 seedValue)
+{
+	state = seedValue != 0 ? seedValue : 0x9E3779B97F4A7C15ull;
+}
+
+Uint32 Random::next()
+{
+	//xorshift64* generator
+	state ^= state >> 12;
+	state ^= state << 25;
+	state ^= state >> 27;
+
+	return (Uint32)((state * 0x2545F4914F6CDD1Dull) >> 32);
+}
+
+int Random::range(int max)
+{
+	return (int)(next() % (Uint32)max);
+}
@@ -0,0 +1,38 @@
+/*
+Title:	Random.h
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: header file for Random class for my game engine. Small seedable generator whose whole state is one integer so it can
+	be saved and restored with the rest of the scene, unlike rand()
+ */
+
+#pragma once
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <SDL.h>
+
+class Random
+{
+public:
+	//initialize with a fixed seed
+	Random();
+
+	//set seed, 0 is replaced since it would only produce 0
+	void seed(Uint64 seedValue);
+
+	//next random 32 bit value
+	Uint32 next();
+
+	//random value from 0 to max - 1, max must be above 0
+	int range(int max);
+
+	//state getter and setter for snapshots
+	Uint64 getState() const { return state; }
+	void setState(Uint64 newState) { state = newState; }
+
+private:
+	//generator state
+	Uint64 state;
+};
+#endif
@@ -6,14 +6,16 @@ Purpose: Implementation file for the Scene class for my game engine
  */
 
 #include "Scene.h"
+#include "MemTrack.h"
 
 Scene::Scene()
 {
 	//initialize randomizer
-	srand( time(NULL) );
+	rng.seed(time(NULL));
 
 	//initialize enemy count
 	enemyCount = 0;
+	enemiesKilled = 0;
 
 	//initialize variables
 	mWindow = NULL;
@@ -29,45 +31,88 @@ Scene::Scene()
 
 	//initialize mouse button state
 	leftClick = false;
+	clickLatched = false;
+	quitRequested = false;
+	windowChanged = false;
+	focusLost = false;
+	inputDelay = 0;
+	frameInputTime = 0;
+	lastPresent = 0;
 
 	//initialize player
-	player = NULL;
+	player = NULL_HANDLE;
 
-	//initialize list variables
-	entityHead = NULL;
-	entityTail = entityHead;
+	//draw through SDL until CPU renderer is set
+	softRenderer = NULL;
 
-	projectileHead = NULL;
-	projectileTail = projectileHead;
+	//dark outside flashlight unless turned off
+	lightingEnabled = true;
+
+	//silent until sounds are set
+	mixer = NULL;
+	shotSound = -1;
+	deathSound = -1;
 
 	//initialize projectile images
 	playerProjectileTexture = NULL;
+	playerMuzzleFlashTexture = NULL;
+
+	//pursuit field covers the screen
+	flowField.init(SCREEN_WIDTH, SCREEN_HEIGHT);
+	simTick = 0;
+	for (int i = 0; i < LOD_LEVELS; i++) { lodCounts[i] = 0; }
+
+	//first sprite id, 0 is left for no sprite
+	nextSpriteId = 1;
+
+	//initialize textures used to rebuild sprites
+	playerTexture = NULL;
+	enemyTexture = NULL;
+
+	//first spawn after a second
+	scripts.setTimers(&timers);
+	spawnTimer = NULL_HANDLE;
+	spawnScript = scripts.start(spawnWaves(30));
+
+	//round is survived once its ticks pass
+	roundTimer = NULL_HANDLE;
+	roundSurvived = false;
+	roundScript = scripts.start(surviveRound(ROUND_TICKS));
+
+	//allocate particle buffers
+	muzzleParticles.init(MUZZLE_PARTICLE_LIMIT, 10, 6, { 255, 255, 255, 255 }, 1.0f, false);
+	sparkParticles.init(MAX_PARTICLES, 4, 2, { 255, 180, 60, 255 }, 0.88f, true);
+}
 
-	//initialize enemy countdown
-	enemyCountdown = 30;
+Scene::~Scene()
+{
+	free();
+}
 
+bool Scene::createWindow(bool headless)
+{
 	//create window
 	mWindow = SDL_CreateWindow("Simple Game", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
-		SCREEN_WIDTH, SCREEN_HEIGHT, WINDOW_FLAGS);
+		SCREEN_WIDTH, SCREEN_HEIGHT, headless ? HEADLESS_WINDOW_FLAGS : WINDOW_FLAGS);
 	//check if creation failed
 	if(mWindow == NULL)
 	{
 		printf("Unable to create window! SDL Error: %s\n", SDL_GetError());
+		return false;
 	}
+
 	//if success, create renderer
-	else
+	mRenderer = SDL_CreateRenderer(mWindow, -1, headless ? HEADLESS_RENDER_FLAGS : RENDER_FLAGS);
+	if(mRenderer == NULL)
 	{
-		mRenderer = SDL_CreateRenderer(mWindow, -1, RENDER_FLAGS);
-		if(mRenderer == NULL)
-		{
-			printf("Unable to create renderer! SDL Error: %s\n", SDL_GetError());
-		}
+		printf("Unable to create renderer! SDL Error: %s\n", SDL_GetError());
+		return false;
 	}
-}
 
-Scene::~Scene()
-{
-	free();
+	//capture input as SDL pumps it
+	SDL_AddEventWatch(InputQueue::eventWatch, &inputQueue);
+
+	return true;
 }
 
 void Scene::prepare()
@@ -82,49 +127,46 @@ void Scene::render()
 {
 	//displays renderer onto screen
 	SDL_RenderPresent(mRenderer);
-}
 
-void Scene::free()
-{
-	//free window and renderer if they exist
-	if(mRenderer != NULL)
+	//present returning is as close to photons as game can see, input taken by frame is now showing
+	lastPresent = SDL_GetPerformanceCounter();
+	if(frameInputTime != 0)
 	{
-		SDL_DestroyRenderer(mRenderer);
+		inputLatency.add((float)((lastPresent - frameInputTime) * 1000.0 / SDL_GetPerformanceFrequency()));
+		frameInputTime = 0;
 	}
-	mRenderer = NULL;
+}
 
+void Scene::free()
+{
+	//free window and renderer if scene made them, a shared renderer belongs to whoever made it
 	if(mWindow != NULL)
 	{
+		//stop capturing input
+		SDL_DelEventWatch(InputQueue::eventWatch, &inputQueue);
+
+		if (mRenderer != NULL) { SDL_DestroyRenderer(mRenderer); }
 		SDL_DestroyWindow(mWindow);
 	}
+	mRenderer = NULL;
 	mWindow = NULL;
 
-	//iterate through lists and free resources
-	Sprite* temp = NULL;
+	//stop scripts before what they use goes away
+	scripts.stopAll();
 
-	while(entityHead != NULL)
-	{
-		//set temp to current head
-		temp = entityHead;
+	//free particle buffers
+	muzzleParticles.free();
+	sparkParticles.free();
 
-		//set new head to current head next
-		entityHead = entityHead->next;
+	//remove every sprite, last first so none are moved
+	while (!entities.empty()) { eraseSprite(entities, entities.handleAt(entities.size() - 1)); }
+	while (!projectiles.empty()) { eraseSprite(projectiles, projectiles.handleAt(projectiles.size() - 1)); }
+	entityRemovals.clear();
+	projectileRemovals.clear();
 
-		//free resource of old head
-		temp->free();
-	}
-
-	while (projectileHead != NULL)
-	{
-		//set temp to current head
-		temp = projectileHead;
-
-		//set new head to current head next
-		projectileHead = projectileHead->next;
-
-		//free resource of old head
-		temp->free();
-	}
+	//player was removed with entities
+	player = NULL_HANDLE;
+	enemyCount = 0;
 }
 
 void Scene::doKeyDown(SDL_KeyboardEvent* e)
@@ -152,6 +194,7 @@ void Scene::doMouseDown(SDL_MouseButtonEvent* e)
 	if(e->button == SDL_BUTTON_LEFT)
 	{
 		leftClick = true;
+		clickLatched = true;
 	}
 }
 
@@ -164,33 +207,106 @@ void Scene::doMouseUp(SDL_MouseButtonEvent* e)
 	}
 }
 
-//mouse movement handler
-void Scene::setMousePos()
+bool Scene::doInput()
+{
+	//take events waiting since last frame
+	pumpInput();
+	drainInput();
+
+	//give local player this frame's input
+	Sprite* playerSprite = getPlayer();
+	if(playerSprite != NULL)
+	{
+		playerSprite->setInput(getLocalInput());
+	}
+
+	clickLatched = false;
+
+	return quitRequested;
+}
+
+bool Scene::waitInput(int timeout)
 {
-	//get mouse position and set mouse position variables
-	SDL_GetMouseState(&mousePos.x, &mousePos.y);
-}//end setMousePos
+	//event is left in SDL's queue, it was captured by event watch when it arrived
+	SDL_WaitEventTimeout(NULL, timeout);
+
+	return doInput();
+}
 
-//get a random number between 0 and 1 for spawner
-int Scene::getRand()
+void Scene::sampleAim()
 {
-	return rand() % 2;
+	//take events that came in while simulating
+	pumpInput();
+	drainInput();
+
+	//draw local player turned to newest mouse position. Its simulated input and heading wait for next tick's doInput
+	Sprite* playerSprite = getPlayer();
+	if(playerSprite != NULL && playerSprite->getHealth() > 0)
+	{
+		playerSprite->aimAt(mousePos);
+	}
 }
 
-bool Scene::doInput()
+void Scene::pumpInput()
 {
-	//quit flag
-	bool quit = false;
+	//event watch queues events as they are pumped, so SDL's copies of those aren't needed
+	SDL_PumpEvents();
+	SDL_FlushEvent(SDL_QUIT);
+	SDL_FlushEvent(SDL_WINDOWEVENT);
+	SDL_FlushEvents(SDL_KEYDOWN, SDL_KEYUP);
+	SDL_FlushEvents(SDL_MOUSEMOTION, SDL_MOUSEBUTTONUP);
+
+	//take the rest out too, so waiting for events sleeps until a new one comes
+	SDL_Event others[INPUT_PEEP_BATCH];
+	int count = 0;
+	while((count = SDL_PeepEvents(others, INPUT_PEEP_BATCH, SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT)) > 0)
+	{
+		for (int i = 0; i < count; i++) { doOtherEvent(others[i]); }
+	}
+}
+
+void Scene::doOtherEvent(SDL_Event& e)
+{
+	switch (e.type)
+	{
+	case SDL_DROPFILE:	//game doesn't open dropped files, SDL leaves freeing path to whoever takes event
+	case SDL_DROPTEXT:
+		SDL_free(e.drop.file);
+		break;
+
+	case SDL_RENDER_TARGETS_RESET:	//target textures and screen lost their contents
+	case SDL_RENDER_DEVICE_RESET:
+		windowChanged = true;
+		break;
+
+	default:	//text input, clipboard, audio device and user events aren't used
+		break;
+	}
+}
 
-	//create event handler
-	SDL_Event e;
+void Scene::drainInput()
+{
+	InputEvent queued;
+	bool moved = false;
+	SDL_Point latest = mousePos;
+	Uint64 oldest = 0;
 
-	while (SDL_PollEvent(&e))
+	while(inputQueue.pop(queued))
 	{
+		SDL_Event& e = queued.event;
+
+		if (oldest == 0) { oldest = queued.time; }
+
 		switch (e.type)
 		{
 		case SDL_QUIT:
-			quit = true;
+			quitRequested = true;
+			break;
+
+		case SDL_WINDOWEVENT:	//contents may be lost or stale
+			if (e.window.event == SDL_WINDOWEVENT_SHOWN || e.window.event == SDL_WINDOWEVENT_EXPOSED ||
+				e.window.event == SDL_WINDOWEVENT_SIZE_CHANGED || e.window.event == SDL_WINDOWEVENT_RESTORED) { windowChanged = true; }
+			else if (e.window.event == SDL_WINDOWEVENT_FOCUS_LOST) { focusLost = true; }
 			break;
 
 		case SDL_KEYDOWN:	//pass to handler on key down
@@ -201,8 +317,9 @@ bool Scene::doInput()
 			doKeyUp(&e.key);	//pass to handler on key up
 			break;
 
-		case SDL_MOUSEMOTION:	
-			setMousePos();
+		case SDL_MOUSEMOTION:	//only last position matters
+			latest = { e.motion.x, e.motion.y };
+			moved = true;
 			break;
 
 		case SDL_MOUSEBUTTONDOWN:
@@ -218,13 +335,78 @@ bool Scene::doInput()
 		}
 	}
 
-	//iterate through entity sprites list and handle input
-	for(Sprite* current = entityHead; current != NULL; current = current->next)
+	if (moved) { mousePos = latest; }
+
+	//how long input sat before the game saw it
+	if (oldest != 0) { inputDelay = (SDL_GetPerformanceCounter() - oldest) * 1000.0 / SDL_GetPerformanceFrequency(); }
+
+	//frame being built is tagged with oldest input any of its drains took
+	if (oldest != 0 && (frameInputTime == 0 || oldest < frameInputTime)) { frameInputTime = oldest; }
+}
+
+PlayerInput Scene::getLocalInput() const
+{
+	PlayerInput input = {};
+
+	//movement keys
+	if (mKeyboard[SDL_SCANCODE_W] || mKeyboard[SDL_SCANCODE_UP]) { input.keys |= INPUT_UP; }
+	if (mKeyboard[SDL_SCANCODE_S] || mKeyboard[SDL_SCANCODE_DOWN]) { input.keys |= INPUT_DOWN; }
+	if (mKeyboard[SDL_SCANCODE_A] || mKeyboard[SDL_SCANCODE_LEFT]) { input.keys |= INPUT_LEFT; }
+	if (mKeyboard[SDL_SCANCODE_D] || mKeyboard[SDL_SCANCODE_RIGHT]) { input.keys |= INPUT_RIGHT; }
+
+	//aim and fire
+	input.fire = leftClick || clickLatched;
+	input.aimX = (Sint16)mousePos.x;
+	input.aimY = (Sint16)mousePos.y;
+
+	return input;
+}
+
+void Scene::doPlayers()
+{
+	//iterate through entity sprites and handle player input
+	for(Sprite& current : entities)
 	{
-		current->doPlayer();
+		if(current.isPlayer())
+		{
+			current.doPlayer();
+		}
 	}
+}
+
+void Scene::simulate()
+{
+	//fire timers due this tick, so anything waiting on them sees it this tick
+	timers.advance();
+
+	//finish removals queued since last tick, e.g. by network
+	flushRemovals();
+
+	//handle players
+	doPlayers();
+
+	//build pursuit field once for all enemies
+	updateFlowField();
+
+	//handle enemies
+	doEnemies();
+
+	//handle projectiles
+	doProjectiles();
+
+	//handle particle effects
+	doParticles();
+
+	//run scripts woken this tick, spawning enemies among them
+	scripts.run();
+
+	//check for collisions
+	collisionCheck();
+
+	//bounding players
+	bound();
 
-	return quit;
+	simTick++;
 }
 
 void Scene::capStart()
@@ -240,188 +422,162 @@ void Scene::capFrames()
 	//get current ticks
 	Uint64 frameTicks = capTimer.getTicks();
 
-	//check if frame ticks are less than constant SCREEN_TICKS_PER_FRAME
-	if(frameTicks < SCREEN_TICKS_PER_FRAME)
+	//wait out rest of frame, waking for events so event watch stamps them as they arrive. Events are left in SDL's queue
+	//for pumpInput, so once one is waiting the wait returns at once and a short sleep keeps it from spinning
+	while(frameTicks < SCREEN_TICKS_PER_FRAME)
 	{
-		//wait until constant
-		SDL_Delay(SCREEN_TICKS_PER_FRAME - frameTicks);
+		if (SDL_WaitEventTimeout(NULL, (int)(SCREEN_TICKS_PER_FRAME - frameTicks)) == 1) { SDL_Delay(1); }
+
+		frameTicks = capTimer.getTicks();
 	}
 }
 
-//add sprite to tail of list. Requires pointer to a sprite, sprite type int 0 = ENTITY 1 = PROJECTILE
-void Scene::addSprite(Sprite* sprite, int spriteType)
+Sprite* Scene::addSprite(bool isPlayer, SpriteType spriteType, SDL_Texture* texture)
 {
-	//determine which list to add to
-	if(spriteType == ENTITY)
-	{
-		//check if list is empty
-		if(entityHead == NULL)
-		{
-			//make new sprite head of list
-			entityHead = sprite;
+	SlotMap<Sprite>& sprites = spriteType == PROJECTILE ? projectiles : entities;
 
-			//make single sprite tail as well
-			entityTail = entityHead;
-		}
-		else
-		{
-			//if there are already sprites in list, add new sprite to tail
-			//point next of current tail to new sprite
-			entityTail->next = sprite;
+	SlotHandle handle = sprites.insert(this, isPlayer, spriteType, texture);
+	Sprite* sprite = sprites.get(handle);
 
-			//set tail of list to now be new sprite
-			entityTail = sprite;
-		}
+	//give sprite an id for snapshots and networking, and handle for finding it again
+	sprite->setId(nextSpriteId++);
+	sprite->setHandle(handle);
+
+	//count live sprites
+	memTrackAlloc(MEM_SPRITE, sizeof(Sprite));
+
+	return sprite;
+}
+
+void Scene::removeSprite(const Sprite* sprite)
+{
+	if(sprite == NULL)
+	{
+		return;
 	}
-	else if(spriteType == PROJECTILE)
+
+	if (sprite->isProjectile()) { projectileRemovals.push_back(sprite->getHandle()); }
+	else { entityRemovals.push_back(sprite->getHandle()); }
+}
+
+void Scene::flushRemovals()
+{
+	for(SlotHandle handle : entityRemovals)
 	{
-		//check if list is empty
-		if (projectileHead == NULL)
-		{
-			//make new sprite head of list
-			projectileHead = sprite;
+		//sprite queued twice is already gone
+		const Sprite* sprite = entities.get(handle);
+		if (sprite == NULL) { continue; }
 
-			//make single sprite tail as well
-			projectileTail = projectileHead;
-		}
-		else
-		{
-			//if there are already sprites in list, add new sprite to tail
-			//point next of current tail to new sprite
-			projectileTail->next = sprite;
+		if (!sprite->isPlayer()) { enemyCount--; }
 
-			//set tail of list to now be new sprite
-			projectileTail = sprite;
-		}
+		eraseSprite(entities, handle);
+	}
+
+	for (SlotHandle handle : projectileRemovals) { eraseSprite(projectiles, handle); }
+
+	entityRemovals.clear();
+	projectileRemovals.clear();
+}
+
+void Scene::eraseSprite(SlotMap<Sprite>& sprites, SlotHandle handle)
+{
+	if(sprites.remove(handle))
+	{
+		memTrackFree(MEM_SPRITE, sizeof(Sprite));
 	}
 }
 
 void Scene::bound()
 {
 	//bound player
-	for(Sprite* current = entityHead; current != NULL; current = current->next)
+	for(Sprite& current : entities)
 	{
-		if(current->isPlayer())
+		if(current.isPlayer())
 		{
 			//check horizontal bounds
-			if(current->getX() < 0)
+			if(current.getX() < 0)
 			{
-				current->setPos(0, current->getY());
+				current.setPos(0, current.getY());
 			}
-			else if(current->getX() + current->getWidth() > SCREEN_WIDTH)
+			else if(current.getX() + current.getWidth() > SCREEN_WIDTH)
 			{
-				current->setPos(SCREEN_WIDTH - current->getWidth(), current->getY());
+				current.setPos(SCREEN_WIDTH - current.getWidth(), current.getY());
 			}
 
 			//check vertical bounds
-			if(current->getY() < 0)
+			if(current.getY() < 0)
 			{
-				current->setPos(current->getX(), 0);
+				current.setPos(current.getX(), 0);
 			}
-			else if(current->getY() + current->getHeight() > SCREEN_HEIGHT)
+			else if(current.getY() + current.getHeight() > SCREEN_HEIGHT)
 			{
-				current->setPos(current->getX(), SCREEN_HEIGHT - current->getHeight());
+				current.setPos(current.getX(), SCREEN_HEIGHT - current.getHeight());
 			}
 		}
 	}
-
-	////bound projectiles
-	//Sprite* previous = NULL;
-	//Sprite* current = projectileHead;
-
-	////check head
-	//if(current != NULL && current == projectileHead && (current->getX() > SCREEN_WIDTH || current->getX() + current->getWidth() < 0 || current->getY() > SCREEN_HEIGHT || current->getY() + current->getHeight() < 0))
-	//{
-	//	projectileHead = current->next;
-
-	//	delete current;
-	//	return;
-	//}
-	//else
-	//{
-	//	while(current != NULL && !(current->getX() > SCREEN_WIDTH || current->getX() + current->getWidth() < 0 || current->getY() > SCREEN_HEIGHT || current->getY() + current->getHeight() < 0))
-	//	{
-	//		previous = current;
-	//		current = current->next;
-	//	}
-
-	//	if (current == NULL)
-	//	{
-	//		return;
-	//	}
-
-	//	previous->next = current->next;
-
-	//	delete current;
-	//}
 }
 
 void Scene::draw()
 {
-	//iterate through entity sprite list and draw them to renderer
-	for (Sprite* current = entityHead; current != NULL; current = current->next)
+	//iterate through entity sprites and draw them to renderer
+	for (Sprite& current : entities)
+	{
+		current.draw();
+	}
+
+	for (Sprite& current : projectiles)
+	{
+		current.draw();
+	}
+
+	//darken everything outside local player's flashlight, particles are drawn after so they glow through
+	Sprite* playerSprite = getPlayer();
+	if(lightingEnabled && playerSprite != NULL)
 	{
-		current->draw();
+		SDL_Point center = playerSprite->getCenter();
+		lighting.update({ (float)center.x, (float)center.y }, (float)playerSprite->getDrawAngle());
+
+		if (softRenderer != NULL) { lighting.drawSoft(*softRenderer); }
+		else { lighting.draw(mRenderer, SCREEN_WIDTH, SCREEN_HEIGHT); }
 	}
 
-	for (Sprite* current = projectileHead; current != NULL; current = current->next)
+	//hand CPU drawn frame to SDL in one copy
+	if(softRenderer != NULL)
 	{
-		current->draw();
+		softRenderer->present();
 	}
+
+	//draw particles on top of sprites, one batch per system
+	sparkParticles.draw(mRenderer);
+	muzzleParticles.draw(mRenderer);
 }
 
 void Scene::doProjectiles()
 {
-//bound projectiles
-	Sprite* previous = NULL;
-	Sprite* current = NULL;
-
-	for (current = projectileHead; current != NULL; current = current->next)
+	for(Sprite& current : projectiles)
 	{
 		//move projectiles
-		current->moveSprite();
+		current.moveSprite();
 
 		//check if projectile is colliding or out of bounds
-		if(projectileCollideEnemy(current) || current->getX() > SCREEN_WIDTH || current->getX() + current->getWidth() < 0 || current->getY() > SCREEN_HEIGHT || current->getY() + current->getHeight() < 0)
+		if(projectileCollideEnemy(&current) || current.getX() > SCREEN_WIDTH || current.getX() + current.getWidth() < 0 || current.getY() > SCREEN_HEIGHT || current.getY() + current.getHeight() < 0)
 		{
-			//check if head or tail
-			if (current == projectileTail)
-			{
-				projectileTail = previous;
-			}
-			if(current == projectileHead)
-			{
-				//if head, set new head to next node and continue through iterations
-				projectileHead = current->next;
-				continue;
-			}
-
-			//set previous node's next to current nodes next, eliminating current from the list
-			previous->next = current->next;
-
-			//free currents data
-			current->free();
-
-			//set current to the previous node
-			current = previous;
+			removeSprite(&current);
 		}
-
-		//set previous node to current node before iterating
-		previous = current;
 	}
+
+	flushRemovals();
 }
 
 int Scene::projectileCollideEnemy(Sprite* projectile)
 {
-	Sprite* current = NULL;
-
-	for(current = entityHead; current != NULL; current = current->next)
+	for(Sprite& current : entities)
 	{
 		//if entity is not player and collides with projectile
-		if (!current->isPlayer() && collision(projectile->getX(), projectile->getY(), projectile->getWidth(), projectile->getHeight(), current->getX(), current->getY(), current->getWidth(), current->getHeight()))
+		if (!current.isPlayer() && collision(projectile->getX(), projectile->getY(), projectile->getWidth(), projectile->getHeight(), current.getX(), current.getY(), current.getWidth(), current.getHeight()))
 		{
 			//set colliding entity health to 0
-			current->setHealth(0);
+			current.setHealth(0);
 
 			return 1;
 		}
@@ -439,86 +595,111 @@ int Scene::collision(int x1, int y1, int w1, int h1, int x2, int y2, int w2, int
 
 void Scene::doEnemies()
 {
-	Sprite* previous = entityHead;
+	for (int i = 0; i < LOD_LEVELS; i++) { lodCounts[i] = 0; }
 
-	for(Sprite* current = entityHead->next; current != NULL; current = current->next)
+	for(Sprite& current : entities)
 	{
 		//if enemy
-		if(!current->isPlayer())
+		if(!current.isPlayer())
 		{
-			//calculate speed
-			//TODO change with battery
-			float enemySpeed = ENEMY_SPEED_BASE + (rand() % 6);
+			//distant enemies steer every 2nd or 4th tick, staggered by id so each tick does an even share
+			int level = lodLevel(current.getCenter());
+			lodCounts[level]++;
 
-			//move enemies
-			current->moveEnemy(enemySpeed);
-
-			//if enemy has no health
-			if(current->getHealth() == 0)
+			if((current.getId() + simTick) % (1 << level) == 0)
 			{
-				//if enemy is tail, set previous to tail
-				if(current == entityTail)
-				{
-					entityTail = previous;
-				}
-				//if enemy is head, set next in list as head
-				if(current == entityHead)
-				{
-					entityHead = current->next;
-					continue;
-				}
-
-				//set previous node's next to current nodes next, eliminating current from the list
-				previous->next = current->next;
-
-				//free currents data
-				current->free();
-
-				//set current to the previous node
-				current = previous;
-
-				//decrement enemy count
-				enemyCount--;
+				//calculate speed from current wave
+				const Wave& wave = waves.getWave(getSimSeconds());
+				//kept in 64 bits until relative to wave and ramped, a host up for hours is past what Fixed holds in seconds
+				Sint64 waveSeconds = (Sint64)simTick * FIXED_ONE / SCREEN_FPS - fixedFromFloat(wave.startSeconds);
+				Sint64 ramp = ((Sint64)wave.speedRamp * fixedSaturate(waveSeconds)) >> FIXED_SHIFT;
+				Fixed enemySpeed = fixedSaturate(wave.speedBase + ramp + fixedFromInt(rng.range(wave.speedRandom)));
+
+				//move enemies
+				current.moveEnemy(fixedTrunc(enemySpeed));
 			}
+			else
+			{
+				//keep going along last heading between updates
+				current.moveSprite();
+			}
+		}
+
+		//if enemy has no health
+		if(!current.isPlayer() && current.getHealth() == 0)
+		{
+			//show enemy death
+			emitEnemyDeath(current.getCenter());
+			enemiesKilled++;
 
-			//set previous node to current node before iterating
-			previous = current;
+			//enemy count goes down when it is removed
+			removeSprite(&current);
 		}
 	}
+
+	flushRemovals();
 }
 
-void Scene::spawnEnemies(SDL_Texture* enemyTexture)
+ScriptTask Scene::spawnWaves(Uint32 delay)
 {
-	//spawn only if countdown done and less than 15 enemies exist
-	if(--enemyCountdown <= 0 && enemyCount < ENEMY_SPAWN_LIMIT)
+	//wait out countdown, e.g. one restored from a snapshot
+	if (delay > 0) { co_await scripts.waitTicks(delay, &spawnTimer); }
+	else { co_await scripts.nextTick(); }
+
+	while(true)
 	{
-		Sprite* enemy = new Sprite(this, false, ENTITY, enemyTexture);
-		int spawnX, spawnY;
+		//waves can move on or be reloaded while waiting, so wave is looked up again after every wait
+		const Wave* wave = &waves.getWave(getSimSeconds());
 
-		//set spawn point to a border
-		//generate number from 0 to 1, if 0 enemy will spawn on left or right border, if 1 on top or bottom border
-		if(getRand() == 0)
+		//hold off while wave's cap is reached, checking each tick
+		while(enemyCount >= wave->cap)
 		{
-			//set spawnX to either left or right boundary
-			spawnX = getRand() * (SCREEN_WIDTH - enemy->getWidth());
-			//spawnY can be any y value in the height
-			spawnY = rand() % (SCREEN_HEIGHT - enemy->getHeight());
-		}
-		else
-		{
-			//set spawnX to any x value in width
-			spawnX = rand() % (SCREEN_WIDTH - enemy->getWidth());
-			//spawnY must be on a boundary
-			spawnY = getRand() * (SCREEN_HEIGHT - enemy->getHeight());
+			co_await scripts.nextTick();
+			wave = &waves.getWave(getSimSeconds());
 		}
 
+		spawnBurst(*wave);
+
+		//wait for next burst
+		co_await scripts.waitTicks(wave->minInterval + rng.range(wave->maxInterval - wave->minInterval + 1), &spawnTimer);
+	}
+}
+
+ScriptTask Scene::surviveRound(Uint32 ticks)
+{
+	co_await scripts.waitTicks(ticks, &roundTimer);
+
+	roundSurvived = true;
+}
+
+void Scene::spawnBurst(const Wave& wave)
+{
+	//count edges wave spawns on
+	int edgeCount = 0;
+	for (int edge = 0; edge < 4; edge++) { edgeCount += (wave.edges >> edge) & 1; }
+
+	int burst = std::min(wave.burst, wave.cap - enemyCount);
+	for(int i = 0; i < burst; i++)
+	{
+		Sprite* enemy = addSprite(false, ENTITY, enemyTexture);
+		int maxX = SCREEN_WIDTH - enemy->getWidth();
+		int maxY = SCREEN_HEIGHT - enemy->getHeight();
+
+		//pick one of wave's edges
+		int pick = rng.range(edgeCount);
+		int edge = 0;
+		while (!((wave.edges >> edge) & 1) || pick-- > 0) { edge++; }
+
+		//set spawn point to a random spot along that border
+		int spawnX, spawnY;
+		if (edge == 0) { spawnX = 0; spawnY = rng.range(maxY); }
+		else if (edge == 1) { spawnX = maxX; spawnY = rng.range(maxY); }
+		else if (edge == 2) { spawnX = rng.range(maxX); spawnY = 0; }
+		else { spawnX = rng.range(maxX); spawnY = maxY; }
+
 		//set enemy position to spawn points
 		enemy->setPos(spawnX, spawnY);
 
-		//reset spawn timer
-		//TODO change with battery
-		enemyCountdown = 5 + (rand() % 25);
-
 		//iterate the enemyCounter
 		enemyCount++;
 	}
@@ -526,55 +707,235 @@ void Scene::spawnEnemies(SDL_Texture* enemyTexture)
 
 void Scene::collisionCheck()
 {
-	int x = player->getX(), y = player->getY(), width = player->getWidth(), height = player->getWidth();
+	//check every player against every enemy
+	for (Sprite& target : entities)
+	{
+		if(!target.isPlayer())
+		{
+			continue;
+		}
 
-	x += width / 3;
-	y += height / 3;
-	width /= 4;
-	height /= 4;
+		int x = target.getX(), y = target.getY(), width = target.getWidth(), height = target.getWidth();
 
-	for (Sprite* current = entityHead; current != NULL; current = current->next)
-	{
-		if (!current->isPlayer() && collision(x, y, width, height, current->getX(), current->getY(), current->getWidth(), current->getHeight()))
+		x += width / 3;
+		y += height / 3;
+		width /= 4;
+		height /= 4;
+
+		for (const Sprite& current : entities)
 		{
-			player->setHealth(0);
-			player->setHealth(0);
+			//skip enemies too far from any player to touch, cut off cells have no real distance so are still checked
+			Uint16 distance = flowField.getDistance(current.getCenter());
+			if (!current.isPlayer() && distance > LOD_COLLIDE_CELLS && distance != FLOW_UNREACHED) { continue; }
+
+			if (!current.isPlayer() && collision(x, y, width, height, current.getX(), current.getY(), current.getWidth(), current.getHeight()))
+			{
+				target.setHealth(0);
+			}
 		}
 	}
 }
 
+void Scene::doParticles()
+{
+	muzzleParticles.update();
+	sparkParticles.update();
+}
+
+void Scene::emitMuzzleFlash(float x, float y, double angle)
+{
+	//flash lasts a few frames and fades
+	muzzleParticles.emit(x, y, 0, 0, 3, (float)angle);
+
+	//sparks thrown out of barrel
+	sparkParticles.emitBurst(x, y, 4, (float)angle, 0.3f, 4, 10, 3, 6);
+
+	//shot panned to where it was fired
+	if (mixer != NULL) { mixer->play(shotSound, 0.4f, x / SCREEN_X_CENTER - 1); }
+}
+
+void Scene::emitEnemyDeath(SDL_Point center)
+{
+	//sparks in every direction
+	sparkParticles.emitBurst((float)center.x, (float)center.y, 24, 0, (float)M_PI, 2, 9, 8, 20);
+
+	if (mixer != NULL) { mixer->play(deathSound, 0.7f, (float)center.x / SCREEN_X_CENTER - 1); }
+}
+
 SDL_Point Scene::getPlayerPos()
 {
-	//iterate through entity list for player
-	for(Sprite* current = entityHead; entityHead != NULL; current = current->next)
+	//if player, return coords
+	const Sprite* playerSprite = entities.get(player);
+	if(playerSprite != NULL)
 	{
-		//if player, return coords
-		if(current->isPlayer())
-		{
-			return current->getCenter();
-		}
+		return playerSprite->getCenter();
 	}
 
 	//if player isn't found, return center of window
 	return { SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 };
 }
 
+int Scene::lodLevel(SDL_Point center) const
+{
+	Uint16 distance = flowField.getDistance(center);
+
+	//cut off or blocked cells have no real distance, keep them at full rate
+	if(distance < LOD_NEAR_CELLS || distance == FLOW_UNREACHED)
+	{
+		return 0;
+	}
+
+	return distance < LOD_MID_CELLS ? 1 : 2;
+}
+
+void Scene::updateFlowField()
+{
+	SDL_Point sources[FLOW_MAX_SOURCES];
+	int sourceCount = 0;
+
+	//every living player pulls enemies
+	for(const Sprite& current : entities)
+	{
+		if(current.isPlayer() && current.getHealth() > 0 && sourceCount < FLOW_MAX_SOURCES)
+		{
+			sources[sourceCount++] = current.getCenter();
+		}
+	}
+
+	//if no player is alive, chase local player
+	if(sourceCount == 0)
+	{
+		sources[sourceCount++] = getPlayerPos();
+	}
+
+	flowField.update(sources, sourceCount);
+}
+
 void Scene::setPlayer(Sprite* playerSprite)
 {
-	player = playerSprite;
+	player = playerSprite != NULL ? playerSprite->getHandle() : NULL_HANDLE;
+
+	//remember texture for player rebuilt from snapshots
+	if (playerSprite != NULL) { playerTexture = playerSprite->getTexture(); }
 }
 
-//TODO remove after testing
-void Scene::print()
+void Scene::saveSnapshot(Snapshot& snapshot)
 {
-	int count = 0;
+	snapshot.clear();
+
+	//header is written first and patched with counts once lists are walked
+	SnapshotHeader header = {};
+	header.magic = SNAPSHOT_MAGIC;
+	header.version = SNAPSHOT_VERSION;
+	header.headerSize = sizeof(SnapshotHeader);
+	header.roundTicksLeft = getRoundTicksLeft();
+	header.randState = rng.getState();
+	header.enemyCountdown = (float)timers.remaining(spawnTimer);
+	header.enemyCount = enemyCount;
+	header.framesCounted = framesCounted;
+	header.nextSpriteId = nextSpriteId;
+	header.simTick = simTick;
+	snapshot.write(&header, sizeof(header));
+
+	for(const Sprite& current : entities)
+	{
+		SpriteState state = current.getState();
+		snapshot.write(&state, sizeof(state));
+		header.entityCount++;
+	}
+
+	for(const Sprite& current : projectiles)
+	{
+		SpriteState state = current.getState();
+		snapshot.write(&state, sizeof(state));
+		header.projectileCount++;
+	}
+
+	snapshot.patch(0, &header, sizeof(header));
+}
+
+bool Scene::loadSnapshot(Snapshot& snapshot)
+{
+	SnapshotHeader header;
+	snapshot.rewind();
+
+	//check header and that snapshot holds every sprite it says it does
+	if(!snapshot.read(&header, sizeof(header)) || header.magic != SNAPSHOT_MAGIC || header.version != SNAPSHOT_VERSION ||
+		header.headerSize != sizeof(SnapshotHeader) ||
+		snapshot.getSize() != sizeof(SnapshotHeader) + ((size_t)header.entityCount + header.projectileCount) * sizeof(SpriteState))
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Snapshot is invalid or from another version\n");
+		return false;
+	}
+
+	//scripts and timers belong to state being replaced, sprites reschedule their own
+	scripts.stopAll();
+	timers.clear();
+
+	//rebuild sprites from records in place
+	const SpriteState* entities = (const SpriteState*)snapshot.readPointer(header.entityCount * sizeof(SpriteState));
+	const SpriteState* projectiles = (const SpriteState*)snapshot.readPointer(header.projectileCount * sizeof(SpriteState));
+	setSprites(entities, header.entityCount, projectiles, header.projectileCount);
+
+	//restore scene variables
+	rng.setState(header.randState);
+	spawnTimer = NULL_HANDLE;
+	spawnScript = scripts.start(spawnWaves(header.enemyCountdown > 0 ? (Uint32)ceilf(header.enemyCountdown) : 0));
+	roundTimer = NULL_HANDLE;
+	roundSurvived = header.roundTicksLeft == 0;
+	roundScript = roundSurvived ? NULL_HANDLE : scripts.start(surviveRound((Uint32)header.roundTicksLeft));
+	enemyCount = header.enemyCount;
+	framesCounted = header.framesCounted;
+	nextSpriteId = header.nextSpriteId;
+	simTick = header.simTick;
+
+	return true;
+}
+
+void Scene::setSprites(const SpriteState* entityStates, Uint32 entityCount, const SpriteState* projectileStates, Uint32 projectileCount)
+{
+	//queued removals are for sprites being replaced
+	entityRemovals.clear();
+	projectileRemovals.clear();
+
+	//rebuild sprites
+	restoreSprites(entities, entityStates, entityCount, ENTITY);
+	restoreSprites(projectiles, projectileStates, projectileCount, PROJECTILE);
 
-	for (Sprite* current = projectileHead; current != NULL; current = current->next)
+	//count enemies and find first player in restored sprites
+	player = NULL_HANDLE;
+	enemyCount = 0;
+	for(const Sprite& current : entities)
 	{
-		count++;
+		if (!current.isPlayer()) { enemyCount++; }
+		else if (player == NULL_HANDLE) { player = current.getHandle(); }
 	}
+}
+
+void Scene::restoreSprites(SlotMap<Sprite>& sprites, const SpriteState* states, Uint32 count, SpriteType spriteType)
+{
+	//remove sprites snapshot didn't have from the end, so the rest keep their order
+	while (sprites.size() > (int)count) { eraseSprite(sprites, sprites.handleAt(sprites.size() - 1)); }
+
+	for(Uint32 i = 0; i < count; i++)
+	{
+		const SpriteState& state = states[i];
 
-	//printf("Projectiles: %d\n", count);
-	//printf("Enemies: %d\n", enemyCount);
-	//printf("Player Health: %d\n", player->getHealth());
+		//pick texture from what sprite is
+		SDL_Texture* texture = enemyTexture;
+		if (state.player) { texture = playerTexture; }
+		else if (state.projectile) { texture = playerProjectileTexture; }
+
+		//reuse existing sprite in same position if there is one, else add a new one at the end
+		if(i >= (Uint32)sprites.size())
+		{
+			addSprite(state.player != 0, spriteType, texture);
+		}
+		else if(sprites[i].getTexture() != texture)
+		{
+			sprites[i].setTexture(texture);
+		}
+
+		sprites[i].setState(state);
+	}
 }
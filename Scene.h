@@ -13,8 +13,22 @@ Purpose: header file for Scene class for my game engine. REQUIRES SPRITE CLASS
 #include <SDL_image.h>
 #include <string>
 #include <ctime>
+#include <vector>
 #include "Timer.h"
 #include "Sprite.h"
+#include "SlotMap.h"
+#include "Particles.h"
+#include "Random.h"
+#include "Snapshot.h"
+#include "FlowField.h"
+#include "WaveScript.h"
+#include "InputQueue.h"
+#include "Mixer.h"
+#include "SoftRenderer.h"
+#include "Lighting.h"
+#include "TimerWheel.h"
+#include "ScriptTask.h"
+#include "LatencyStats.h"
 
 //constants for screen size
 //change these for desired screen sizes, keyboard settings, render/window flags etc.
@@ -24,11 +38,21 @@ const int SCREEN_HEIGHT = 960;
 const int SCREEN_Y_CENTER = SCREEN_HEIGHT / 2;
 const int WINDOW_FLAGS = SDL_WINDOW_INPUT_GRABBED;
 const int RENDER_FLAGS = SDL_RENDERER_ACCELERATED;
+const int HEADLESS_WINDOW_FLAGS = SDL_WINDOW_HIDDEN;
+const int HEADLESS_RENDER_FLAGS = SDL_RENDERER_SOFTWARE;
 const int SCREEN_FPS = 30;
 const int SCREEN_TICKS_PER_FRAME = 1000 / SCREEN_FPS;
+const Uint32 ROUND_TICKS = 180 * SCREEN_FPS;	//ticks before a round is survived
 const int MAX_KEYBOARD_KEYS = 256;
-const float ENEMY_SPEED_BASE = 6;
+const int ENEMY_SPEED_BASE = 6;
 const int ENEMY_SPAWN_LIMIT = 25;
+const int MUZZLE_PARTICLE_LIMIT = 1024;
+
+//enemy simulation level of detail, by flow field distance in cells from nearest player
+const int LOD_LEVELS = 3;
+const int LOD_NEAR_CELLS = 6;		//closer than this updates every tick
+const int LOD_MID_CELLS = 14;		//closer than this updates every other tick, farther every fourth
+const int LOD_COLLIDE_CELLS = 3;	//enemies farther than this can't be touching a player
 
 //forward declaration
 class Sprite;
@@ -42,10 +66,20 @@ public:
 	//destroctor
 	~Scene();
 
+	//create window and renderer. Headless uses a hidden window and software renderer
+	bool createWindow(bool headless = false);
+
+	//draw with a renderer owned elsewhere instead of a window of its own, e.g. one of many scenes loaded with textures
+	//from one renderer. Scene takes no SDL input and doesn't destroy renderer
+	void shareRenderer(SDL_Renderer* renderer) { mRenderer = renderer; }
+
+	//seed random generator, so scenes made in the same second don't play the same game
+	void seed(Uint64 seedValue) { rng.seed(seedValue); }
+
 	//set background color and clear renderer
 	void prepare();
 
-	//renders to screen
+	//renders to screen. Once presented, frame's latency from oldest input it took is recorded
 	void render();
 
 	//deallocates resources
@@ -59,23 +93,46 @@ public:
 	void doMouseDown(SDL_MouseButtonEvent* e);
 	void doMouseUp(SDL_MouseButtonEvent* e);
 
-	//handle input
+	//handle input, sets local player input. Returns quit flag
 	bool doInput();
 
+	//sleep until an event comes in or timeout ms pass, then handle input like doInput. Returns quit flag
+	bool waitInput(int timeout);
+
+	//take newest input again just before rendering so local player faces where mouse is now
+	void sampleAim();
+
+	//build input for local player from keyboard and mouse state
+	PlayerInput getLocalInput() const;
+
+	//run player sprites from their current input
+	void doPlayers();
+
+	//run one tick of simulation: players, enemies, projectiles, particles, spawning, collisions and bounds
+	void simulate();
+
 	//starter for screen cap timer
 	void capStart();
 
 	//cap frame rate
 	void capFrames();
 
-	//add sprite to scene sprite list
-	void addSprite(Sprite* sprite, int spriteType);
+	//make sprite in scene and give it an id and handle. Returned pointer is only good until the next sprite of same type is
+	//added or removed, keep its handle instead
+	Sprite* addSprite(bool isPlayer, SpriteType spriteType, SDL_Texture* texture);
+
+	//queue sprite to be removed. Sprites are only removed by flushRemovals, so sprites can be walked while removing them
+	void removeSprite(const Sprite* sprite);
+
+	//remove queued sprites
+	void flushRemovals();
 
 	//set projectile and muzzle flash texture
 	void setPlayerProjectile(SDL_Texture* projectileTexture, SDL_Texture* muzzleFlashTexture)
 	{
 		playerProjectileTexture = projectileTexture;
 		playerMuzzleFlashTexture = muzzleFlashTexture;
+		muzzleParticles.setTexture(muzzleFlashTexture);
 	}
 
 	//bound sprites
@@ -96,24 +153,98 @@ public:
 	//handle enemies
 	void doEnemies();
 
-	//spawn enemies
-	void spawnEnemies(SDL_Texture* enemyTexture);
+	//script spawning bursts of enemies at current wave's pace, first once delay ticks pass or next tick if 0
+	ScriptTask spawnWaves(Uint32 delay);
+
+	//script ending round as survived once ticks pass
+	ScriptTask surviveRound(Uint32 ticks);
+
+	//spawn one burst of wave's enemies along its edges
+	void spawnBurst(const Wave& wave);
 
 	//check for collisions
 	void collisionCheck();
 
+	//write simulation state into snapshot in one pass
+	void saveSnapshot(Snapshot& snapshot);
+
+	//restore simulation state from snapshot, reusing existing sprites. Returns false if snapshot is invalid
+	bool loadSnapshot(Snapshot& snapshot);
+
+	//replace sprites with given states, reusing existing sprites
+	void setSprites(const SpriteState* entityStates, Uint32 entityCount, const SpriteState* projectileStates, Uint32 projectileCount);
+
+	//advance particle effects
+	void doParticles();
+
+	//update enemy flow field from living players
+	void updateFlowField();
+
+	//set tile map whose solid tiles enemies path around and block light
+	void setObstacles(const TileMap* map) { flowField.setObstacles(map); lighting.setOccluders(map); }
+
+	//turn darkness outside local player's flashlight on or off
+	void setLightingEnabled(bool enabled) { lightingEnabled = enabled; }
+
+	//spawn muzzle flash particles at muzzle facing angle in radians
+	void emitMuzzleFlash(float x, float y, double angle);
+
+	//spawn burst of particles where an enemy died
+	void emitEnemyDeath(SDL_Point center);
+
+	//draw sprites with CPU renderer instead of SDL, NULL to go back to SDL
+	void setSoftRenderer(SoftRenderer* renderer) { softRenderer = renderer; }
+	SoftRenderer* getSoftRenderer() const { return softRenderer; }
+
+	//set mixer and sounds played for shots and enemy deaths, NULL mixer for silence
+	void setSounds(Mixer* mixer, int shotSound, int deathSound) { this->mixer = mixer; this->shotSound = shotSound; this->deathSound = deathSound; }
+
 	//getters
 	int* getKeyboard() { return mKeyboard; }				//get keyboard state
 	SDL_Renderer* getRenderer() const { return mRenderer; }	//get renderer
 	SDL_Point getMousePos() const { return mousePos; }		//handler for mouse position
 	bool getMouseLeft() const { return leftClick; }			//get mouse button state
-	SDL_Point getPlayerPos();								//return players position
+	double getInputDelay() const { return inputDelay; }		//get ms oldest event waited before last doInput took it
+	const LatencyStats& getInputLatency() const { return inputLatency; }	//get input to present latency of frames so far
+	Uint64 getLastPresent() const { return lastPresent; }	//get performance counter when last frame was presented
+	Uint32 getInputDropped() const { return inputQueue.getDropped(); }	//get events lost to a full input queue
+	SDL_Point getPlayerPos();								//return local players position
+	SDL_Point getFlowTarget(SDL_Point from) const { return flowField.steer(from); }	//return point enemy at from should head for
+	const SlotMap<Sprite>& getEntities() const { return entities; }		//get players and enemies for iterating
+	const SlotMap<Sprite>& getProjectiles() const { return projectiles; }	//get projectiles for iterating
+	Sprite* getEntity(SlotHandle handle) { return entities.get(handle); }	//get entity by handle, NULL if it was removed
+	void setEnemyTexture(SDL_Texture* texture) { enemyTexture = texture; }	//set texture simulate spawns enemies with
+	void setPlayerTexture(SDL_Texture* texture) { playerTexture = texture; }	//set texture for players made from snapshots
 	void setPlayer(Sprite* playerSprite);					//sets player object
-	Sprite* getPlayer() { return player; }	//returns player health
+	Sprite* getPlayer() { return entities.get(player); }	//returns player, NULL if there is none
 	SDL_Texture* getPlayerProjectile() const { return playerProjectileTexture; }	//get player projectile
 	SDL_Texture* getMuzzleFlash() const { return playerMuzzleFlashTexture; }	//get player projectile
 	int getEnemyCount() const { return enemyCount; }		//get number of enemy entities
-	void print();
+	Uint32 getEnemiesKilled() const { return enemiesKilled; }	//get enemies killed since scene was made, snapshots don't change it
+	int getLodCount(int level) const { return lodCounts[level]; }	//get enemies at LOD level last tick, 0 is full rate
+	Uint32 getSimTick() const { return simTick; }			//get simulation ticks run
+	float getSimSeconds() const { return simTick / (float)SCREEN_FPS; }	//get simulated time, drives spawn waves
+	Uint32 getRoundTicksLeft() const { return roundSurvived ? 0 : timers.remaining(roundTimer); }	//get ticks until round is survived
+	bool isRoundSurvived() const { return roundSurvived; }	//check if round's ticks ran out
+	WaveScript& getWaves() { return waves; }				//get spawn waves for loading and reloading
+	TimerWheel& getTimers() { return timers; }				//get scheduler advanced once per simulation tick
+	ScriptScheduler& getScripts() { return scripts; }		//get gameplay scripts run once per simulation tick
+	Lighting& getLighting() { return lighting; }			//get flashlight, for setting its battery
+	int countProjectiles() const { return projectiles.size(); }	//get projectiles in flight
+	int getParticleCount() const { return muzzleParticles.getCount() + sparkParticles.getCount(); }	//get live particles in both pools
+	int getParticleCapacity() const { return muzzleParticles.getCapacity() + sparkParticles.getCapacity(); }	//get size of both pools
+
+	//check if window was shown, exposed or resized since last asked, so an idle screen has to be drawn again
+	bool takeWindowChanged() { bool changed = windowChanged; windowChanged = false; return changed; }
+
+	//forget input taken since last present, for frames that took input but won't present it
+	void discardFrameInput() { frameInputTime = 0; }
+
+	//check if window lost focus since last asked
+	bool takeFocusLost() { bool lost = focusLost; focusLost = false; return lost; }
+
+	//set mouse state directly for synthetic input
+	void setMouseState(SDL_Point pos, bool left) { mousePos = pos; leftClick = left; }
 
 
 private:
@@ -128,12 +259,43 @@ private:
 	int mKeyboard[MAX_KEYBOARD_KEYS];
 
 	//mouse position
-	void setMousePos();
 	SDL_Point mousePos;
 
 	//mouse button state
 	bool leftClick;
 
+	//click seen since input was last given to player, so a click released within a frame still fires
+	bool clickLatched;
+
+	//quit event seen
+	bool quitRequested;
+
+	//window events seen since last asked
+	bool windowChanged;
+	bool focusLost;
+
+	//events captured by SDL event watch
+	InputQueue inputQueue;
+
+	//ms oldest event waited before being handled
+	double inputDelay;
+
+	//capture time of oldest event taken since last present, 0 if none. Frames that took no input aren't measured
+	Uint64 frameInputTime;
+
+	//latency from input capture to frame using it being presented, and when last frame was presented
+	LatencyStats inputLatency;
+	Uint64 lastPresent;
+
+	//pump SDL so event watch captures waiting events, then empty SDL's own queue
+	void pumpInput();
+
+	//handle an event event watch doesn't queue
+	void doOtherEvent(SDL_Event& e);
+
+	//handle queued events, coalescing mouse motion into latest position
+	void drainInput();
+
 	//scene timer to keep track of current time/time passed
 	Timer sceneTimer;
 
@@ -143,12 +305,15 @@ private:
 	//integer to count frames for frame cap
 	int framesCounted;
 
-	//heads are pointers to prevent circular dependency
-	//hold items for players/enemies sprite linked list
-	Sprite* entityHead, * entityTail;
+	//players and enemies
+	SlotMap<Sprite> entities;
+
+	//projectiles
+	SlotMap<Sprite> projectiles;
 
-	//hold items for projectile sprite linked list
-	Sprite* projectileHead, * projectileTail;
+	//sprites waiting for flushRemovals
+	std::vector<SlotHandle> entityRemovals;
+	std::vector<SlotHandle> projectileRemovals;
 
 	//hold texture for projectile sprite
 	SDL_Texture* playerProjectileTexture;
@@ -156,16 +321,76 @@ private:
 	//hold texture for muzzle flash
 	SDL_Texture* playerMuzzleFlashTexture;
 
-	//enemy spawn countdown
-	float enemyCountdown;
+	//spawn script, and timer it is waiting on between bursts. Timer's remaining ticks are saved with snapshots
+	SlotHandle spawnScript;
+	SlotHandle spawnTimer;
+
+	//round script, timer it waits on and whether it ran out. Timer's remaining ticks are saved with snapshots, so round
+	//timer, flashlight battery and timer shown all count simulation ticks
+	SlotHandle roundScript;
+	SlotHandle roundTimer;
+	bool roundSurvived;
+
+	//scene random generator, saved with snapshots
+	Random rng;
+
+	//textures for sprites recreated from snapshots
+	SDL_Texture* playerTexture;
+	SDL_Texture* enemyTexture;
 
-	//generate random number for spawner
-	int getRand();
+	//rebuild sprites from states in order, reusing existing sprites
+	void restoreSprites(SlotMap<Sprite>& sprites, const SpriteState* states, Uint32 count, SpriteType spriteType);
+
+	//remove sprite now
+	void eraseSprite(SlotMap<Sprite>& sprites, SlotHandle handle);
+
+	//id given to next sprite added
+	Uint32 nextSpriteId;
 
 	//number of enemies in scene
 	int enemyCount;
 
-	//player object
-	Sprite* player;
+	//enemies killed, a running total for scoring
+	Uint32 enemiesKilled;
+
+	//local player
+	SlotHandle player;
+
+	//shared pursuit field for enemies
+	FlowField flowField;
+
+	//pick LOD level for enemy from its distance to nearest player
+	int lodLevel(SDL_Point center) const;
+
+	//simulation ticks run, staggers LOD updates. Saved with snapshots
+	Uint32 simTick;
+
+	//timers keyed on simulation ticks. Pending ones are saved with snapshots by whatever scheduled them
+	TimerWheel timers;
+
+	//gameplay scripts, restarted from saved values when snapshots load
+	ScriptScheduler scripts;
+
+	//enemies at each LOD level last tick
+	int lodCounts[LOD_LEVELS];
+
+	//spawn waves
+	WaveScript waves;
+
+	//CPU renderer sprites draw through if set, not owned
+	SoftRenderer* softRenderer;
+
+	//sound effects, mixer is not owned
+	Mixer* mixer;
+	int shotSound;
+	int deathSound;
+
+	//particle effects
+	ParticleSystem muzzleParticles;
+	ParticleSystem sparkParticles;
+
+	//local player's flashlight
+	Lighting lighting;
+	bool lightingEnabled;
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,207 @@
+/*
+Title:	ScriptTask.cpp
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: implementation file for gameplay scripts in my game engine
+ */
+
+#include "ScriptTask.h"
+#include "MemTrack.h"
+#include <mutex>
+
+//size classes of pooled frames
+const int SCRIPT_FRAME_CLASSES = (int)(SCRIPT_FRAME_LARGEST / SCRIPT_FRAME_GRAIN);
+
+//free frames of each size class, linked through their first bytes
+static void* freeFrames[SCRIPT_FRAME_CLASSES];
+
+//blocks frames were carved from, with their sizes, freed together
+static std::vector<std::pair<void*, size_t>> frameBlocks;
+
+//scenes on different threads share pool, only taken when a script starts or ends
+static std::mutex frameMutex;
+
+void* ScriptTask::promise_type::operator new(size_t bytes) noexcept
+{
+	//large frames aren't worth pooling
+	if(bytes > SCRIPT_FRAME_LARGEST)
+	{
+		void* frame = SDL_malloc(bytes);
+		if (frame != NULL) { memTrackAlloc(MEM_SCRIPT, bytes); }
+		return frame;
+	}
+
+	int sizeClass = (int)((bytes + SCRIPT_FRAME_GRAIN - 1) / SCRIPT_FRAME_GRAIN) - 1;
+	std::lock_guard<std::mutex> lock(frameMutex);
+
+	//carve a new block into frames when class runs out
+	if(freeFrames[sizeClass] == NULL)
+	{
+		size_t frameBytes = (sizeClass + 1) * SCRIPT_FRAME_GRAIN;
+		size_t blockBytes = frameBytes * SCRIPT_FRAMES_PER_BLOCK;
+		Uint8* block = (Uint8*)SDL_malloc(blockBytes);
+		if(block == NULL)
+		{
+			SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Unable to allocate script frames!\n");
+			return NULL;
+		}
+
+		memTrackAlloc(MEM_SCRIPT, blockBytes);
+		frameBlocks.push_back({ block, blockBytes });
+
+		for(int i = SCRIPT_FRAMES_PER_BLOCK - 1; i >= 0; i--)
+		{
+			*(void**)(block + i * frameBytes) = freeFrames[sizeClass];
+			freeFrames[sizeClass] = block + i * frameBytes;
+		}
+	}
+
+	void* frame = freeFrames[sizeClass];
+	freeFrames[sizeClass] = *(void**)frame;
+
+	return frame;
+}
+
+void ScriptTask::promise_type::operator delete(void* frame, size_t bytes)
+{
+	if(bytes > SCRIPT_FRAME_LARGEST)
+	{
+		memTrackFree(MEM_SCRIPT, bytes);
+		SDL_free(frame);
+		return;
+	}
+
+	//back on its class's free list
+	int sizeClass = (int)((bytes + SCRIPT_FRAME_GRAIN - 1) / SCRIPT_FRAME_GRAIN) - 1;
+	std::lock_guard<std::mutex> lock(frameMutex);
+	*(void**)frame = freeFrames[sizeClass];
+	freeFrames[sizeClass] = frame;
+}
+
+void scriptFreeFrames()
+{
+	std::lock_guard<std::mutex> lock(frameMutex);
+
+	for(auto& block : frameBlocks)
+	{
+		memTrackFree(MEM_SCRIPT, block.second);
+		SDL_free(block.first);
+	}
+
+	frameBlocks.clear();
+	for (void*& frame : freeFrames) { frame = NULL; }
+}
+
+void ScriptEvent::signal()
+{
+	//waiters only go on ready lists here, so nothing runs while list is walked
+	for (Waiter& waiter : waiting) { waiter.scheduler->wake(waiter.script); }
+	waiting.clear();
+}
+
+void ScriptEvent::await_suspend(std::coroutine_handle<ScriptTask::promise_type> coroutine)
+{
+	waiting.push_back({ coroutine.promise().scheduler, coroutine.promise().script });
+}
+
+void ScriptScheduler::TickWait::await_suspend(std::coroutine_handle<ScriptTask::promise_type> coroutine)
+{
+	SlotHandle script = coroutine.promise().script;
+
+	//next tick needs no timer
+	if(ticks == 0)
+	{
+		scheduler->wake(script);
+		return;
+	}
+
+	ScriptScheduler* waker = scheduler;
+	SlotHandle wait = scheduler->timers->schedule(ticks, [waker, script] { waker->wake(script); });
+	if (timer != NULL) { *timer = wait; }
+}
+
+ScriptScheduler::ScriptScheduler()
+{
+	//initialize variables
+	timers = NULL;
+	resumes = 0;
+}
+
+ScriptScheduler::~ScriptScheduler()
+{
+	stopAll();
+}
+
+SlotHandle ScriptScheduler::start(ScriptTask task)
+{
+	//frame couldn't be allocated
+	if(!task.coroutine)
+	{
+		return NULL_HANDLE;
+	}
+
+	//scheduler owns it from here
+	std::coroutine_handle<ScriptTask::promise_type> coroutine = task.coroutine;
+	task.coroutine = nullptr;
+
+	SlotHandle script = scripts.insert(coroutine);
+	coroutine.promise().scheduler = this;
+	coroutine.promise().script = script;
+
+	resume(script);
+
+	return script;
+}
+
+bool ScriptScheduler::stop(SlotHandle script)
+{
+	std::coroutine_handle<ScriptTask::promise_type>* coroutine = scripts.get(script);
+	if(coroutine == NULL)
+	{
+		return false;
+	}
+
+	//timers and events still holding handle skip it when they end
+	coroutine->destroy();
+	scripts.remove(script);
+
+	return true;
+}
+
+void ScriptScheduler::stopAll()
+{
+	while (!scripts.empty()) { stop(scripts.handleAt(scripts.size() - 1)); }
+
+	ready.clear();
+	running.clear();
+}
+
+void ScriptScheduler::run()
+{
+	//take this run's scripts, any woken while they run go on fresh ready list
+	running.swap(ready);
+
+	for (SlotHandle script : running) { resume(script); }
+	running.clear();
+}
+
+void ScriptScheduler::resume(SlotHandle script)
+{
+	//stopped scripts are skipped
+	std::coroutine_handle<ScriptTask::promise_type>* found = scripts.get(script);
+	if(found == NULL)
+	{
+		return;
+	}
+
+	//copied, script may start others and move slot map while it runs
+	std::coroutine_handle<ScriptTask::promise_type> coroutine = *found;
+	coroutine.resume();
+	resumes++;
+
+	if(coroutine.done())
+	{
+		coroutine.destroy();
+		scripts.remove(script);
+	}
+}
@@ -0,0 +1,163 @@
+/*
+Title:	ScriptTask.h
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: header file for gameplay scripts in my game engine. A script is a C++20 coroutine returning ScriptTask that reads
+	top to bottom and co_awaits ticks, timers and events instead of keeping countdowns and state flags by hand. Scripts are
+	started on a ScriptScheduler, which resumes every script whose wait ended at one point in the simulation tick, in the
+	order their waits ended. Timed waits sit on the scene's TimerWheel, so thousands of waiting scripts cost nothing per
+	tick. Coroutine frames come from pooled blocks shared by every scheduler and waiting never allocates, so steady play
+	doesn't touch the heap. A scheduler and its scripts belong to one thread at a time, the pool can be used from any.
+
+	Scripts are reached through generational handles, so a timer or event ending a wait for a stopped script is skipped.
+	Coroutine state can't be saved, so anything that has to survive snapshots restarts its script from saved values.
+ */
+
+#pragma once
+#ifndef SCRIPTTASK_H
+#define SCRIPTTASK_H
+
+#include <SDL.h>
+#include <coroutine>
+#include <vector>
+#include "SlotMap.h"
+#include "TimerWheel.h"
+
+//script constants
+const size_t SCRIPT_FRAME_GRAIN = 64;		//frame sizes are rounded up to this
+const size_t SCRIPT_FRAME_LARGEST = 4096;	//frames past this come straight from heap
+const int SCRIPT_FRAMES_PER_BLOCK = 32;		//frames allocated together when a size runs out
+
+class ScriptScheduler;
+
+//coroutine type returned by scripts. Holds the script until it is started on a scheduler
+class ScriptTask
+{
+public:
+	struct promise_type
+	{
+		//scheduler running script and where it is in it
+		ScriptScheduler* scheduler = NULL;
+		SlotHandle script = NULL_HANDLE;
+
+		ScriptTask get_return_object() { return ScriptTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+		std::suspend_always initial_suspend() noexcept { return {}; }		//runs once started
+		std::suspend_always final_suspend() noexcept { return {}; }		//scheduler destroys it
+		void return_void() {}
+		void unhandled_exception() { SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Gameplay script ended by an exception\n"); }
+
+		//frames come from pool, a script that can't get one is never started
+		static void* operator new(size_t bytes) noexcept;
+		static void operator delete(void* frame, size_t bytes);
+		static ScriptTask get_return_object_on_allocation_failure() { return ScriptTask(nullptr); }
+	};
+
+	//destroys script if it was never started
+	~ScriptTask() { if (coroutine) { coroutine.destroy(); } }
+
+	ScriptTask(ScriptTask&& other) noexcept : coroutine(other.coroutine) { other.coroutine = nullptr; }
+	ScriptTask(const ScriptTask&) = delete;
+	ScriptTask& operator=(const ScriptTask&) = delete;
+
+private:
+	friend class ScriptScheduler;
+
+	explicit ScriptTask(std::coroutine_handle<promise_type> coroutine) : coroutine(coroutine) {}
+
+	std::coroutine_handle<promise_type> coroutine;
+};
+
+//something scripts can wait on until it is signalled. Must not outlive schedulers of scripts waiting on it
+class ScriptEvent
+{
+public:
+	//make every waiting script ready, to run at their schedulers' next run
+	void signal();
+
+	//co_await event to wait until next signal
+	bool await_ready() const noexcept { return false; }
+	void await_suspend(std::coroutine_handle<ScriptTask::promise_type> coroutine);
+	void await_resume() const noexcept {}
+
+	//getters
+	int getWaiting() const { return (int)waiting.size(); }
+
+private:
+	//scripts waiting and scheduler each is on
+	struct Waiter
+	{
+		ScriptScheduler* scheduler;
+		SlotHandle script;
+	};
+	std::vector<Waiter> waiting;
+};
+
+class ScriptScheduler
+{
+public:
+	//wait for a number of ticks, returned by waitTicks
+	struct TickWait
+	{
+		ScriptScheduler* scheduler;
+		Uint32 ticks;
+		SlotHandle* timer;
+
+		bool await_ready() const noexcept { return false; }
+		void await_suspend(std::coroutine_handle<ScriptTask::promise_type> coroutine);
+		void await_resume() const noexcept {}
+	};
+
+	//initialize variables
+	ScriptScheduler();
+
+	//destructor
+	~ScriptScheduler();
+
+	//set wheel timed waits are scheduled on, advanced once per tick. Wheel is not owned
+	void setTimers(TimerWheel* timers) { this->timers = timers; }
+
+	//run script now until it first waits, then keep it until it returns. Returns handle to stop it
+	SlotHandle start(ScriptTask task);
+
+	//destroy script wherever it is waiting, returns false if it already finished
+	bool stop(SlotHandle script);
+
+	//destroy every script
+	void stopAll();
+
+	//resume scripts whose waits have ended, in order they ended. Scripts made ready while running wait for next run
+	void run();
+
+	//co_await to wait ticks, at least 1. If timer is given it is set to wait's timer, for saving how long is left
+	TickWait waitTicks(Uint32 ticks, SlotHandle* timer = NULL) { return { this, ticks, timer }; }
+
+	//co_await to wait until next run
+	TickWait nextTick() { return { this, 0, NULL }; }
+
+	//make script ready to resume at next run, used by waits
+	void wake(SlotHandle script) { ready.push_back(script); }
+
+	//getters
+	bool isRunning(SlotHandle script) const { return scripts.contains(script); }
+	int getScriptCount() const { return scripts.size(); }	//get scripts started and not finished
+	Sint64 getResumes() const { return resumes; }			//get times scripts were resumed
+
+private:
+	//resume script, destroying it if it returned
+	void resume(SlotHandle script);
+
+	//scripts started and not finished
+	SlotMap<std::coroutine_handle<ScriptTask::promise_type>> scripts;
+
+	//scripts to resume at next run, and ones being resumed by current run
+	std::vector<SlotHandle> ready;
+	std::vector<SlotHandle> running;
+
+	TimerWheel* timers;
+	Sint64 resumes;
+};
+
+//give back pooled script frames, call once no scripts are left
+void scriptFreeFrames();
+
+#endif
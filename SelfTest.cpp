@@ -0,0 +1,555 @@
+/*
+Title:	SelfTest.cpp
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: implementation file for self tests for my game engine
+ */
+
+#include "SelfTest.h"
+#include "Scene.h"
+#include "Random.h"
+#include "Snapshot.h"
+#include "NetGame.h"
+#include "FlowField.h"
+#include "SlotMap.h"
+#include "TimerWheel.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+
+//self test constants
+const char* SELF_TEST_SNAPSHOT_PATH = "selftest.snap";
+const int SELF_TEST_WARMUP_TICKS = 300;		//ticks played before saving, so enemies and projectiles are out
+const int SELF_TEST_REPLAY_TICKS = 120;		//ticks played from save and from its reload to compare
+
+//first values of xorshift64* seeded with 12345
+static const Uint32 RANDOM_EXPECTED[8] =
+{
+	2555902770u, 3234773579u, 328846939u, 3161420795u, 513335584u, 904356694u, 4293856061u, 2283851398u
+};
+
+//fixed math results checksummed over every angle and a grid of vectors and values. Changes if a table entry, the
+//blending or the rounding anywhere changes, which would change every replay and desync every older client
+const Uint32 FIXED_MATH_EXPECTED = 2754483830u;
+const int FIXED_SINE_ERROR = 2;				//65536ths, stated in FixedMath.h
+const int FIXED_ATAN_ERROR = 2;				//65536ths of a turn, stated in FixedMath.h
+
+//log a failed check and pass result through
+static bool selfTestFail(const char* check, const char* reason)
+{
+	SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Self test %s failed: %s\n", check, reason);
+	return false;
+}
+
+//compare bytes written to two snapshots
+static bool sameSnapshot(Snapshot& a, Snapshot& b)
+{
+	if(a.getSize() != b.getSize())
+	{
+		return false;
+	}
+
+	a.rewind();
+	b.rewind();
+
+	return memcmp(a.readPointer(a.getSize()), b.readPointer(b.getSize()), a.getSize()) == 0;
+}
+
+//compare every field of two net frames' entities
+static bool sameFrame(const NetFrame& a, const NetFrame& b)
+{
+	if(a.entities.size() != b.entities.size())
+	{
+		return false;
+	}
+
+	for(size_t i = 0; i < a.entities.size(); i++)
+	{
+		const NetEntity& x = a.entities[i];
+		const NetEntity& y = b.entities[i];
+		if (x.id != y.id || x.x != y.x || x.y != y.y || x.angle != y.angle || x.health != y.health || x.flags != y.flags) { return false; }
+	}
+
+	return true;
+}
+
+//encode current against base into a body sized like server's, decode it back and compare
+static bool deltaRoundTrip(const NetFrame* base, const NetFrame& current)
+{
+	std::vector<Uint8> body(maxDeltaBytes(base, current));
+	NetWriter writer(body.data(), (int)body.size());
+	writer.writeVarint(base != NULL ? base->tick : 0);
+	writer.writeU32(0);
+	encodeDelta(writer, base, current);
+
+	if(writer.hasOverflowed())
+	{
+		return false;
+	}
+
+	NetReader reader(body.data(), writer.getSize());
+	reader.readVarint();
+	reader.readU32();
+
+	NetFrame decoded;
+	return decodeDelta(reader, base, decoded) && reader.getRemaining() == 0 && sameFrame(current, decoded);
+}
+
+//fill in an entity with random state
+static NetEntity randomEntity(Random& rng, Uint32 id)
+{
+	NetEntity entity;
+	entity.id = id;
+	entity.x = rng.range(4000) - 2000;
+	entity.y = rng.range(4000) - 2000;
+	entity.angle = (FixedAngle)rng.next();
+	entity.health = (Uint8)rng.next();
+	entity.flags = (Uint8)rng.range(4);
+
+	return entity;
+}
+
+//drive scene with the same synthetic input for a tick, so two runs from one state can be compared
+static void selfTestTick(Scene& scene, Uint32 tick)
+{
+	int* keyboard = scene.getKeyboard();
+	int phase = (tick / 30) % 4;
+	keyboard[SDL_SCANCODE_W] = phase == 0;
+	keyboard[SDL_SCANCODE_D] = phase == 1;
+	keyboard[SDL_SCANCODE_S] = phase == 2;
+	keyboard[SDL_SCANCODE_A] = phase == 3;
+	scene.setMouseState({ (int)(tick * 37) % SCREEN_WIDTH, (int)(tick * 23) % SCREEN_HEIGHT }, (tick / 7) % 3 != 0);
+
+	scene.doInput();
+
+	//player dying would end the comparison early
+	if (scene.getPlayer() != NULL) { scene.getPlayer()->setHealth(1); }
+
+	scene.simulate();
+}
+
+bool selfTestRandom()
+{
+	Random rng;
+	rng.seed(12345);
+
+	for(int i = 0; i < 8; i++)
+	{
+		if (rng.next() != RANDOM_EXPECTED[i]) { return selfTestFail("random", "sequence from fixed seed changed"); }
+	}
+
+	//restoring state replays same values
+	Uint64 state = rng.getState();
+	Uint32 first[4];
+	for (Uint32& value : first) { value = rng.next(); }
+
+	rng.setState(state);
+	for(Uint32 value : first)
+	{
+		if (rng.next() != value) { return selfTestFail("random", "restored state gave a different sequence"); }
+	}
+
+	//0 would only ever produce 0
+	rng.seed(0);
+	if (rng.getState() == 0 || rng.next() == 0) { return selfTestFail("random", "seed 0 was not replaced"); }
+
+	//range stays under max
+	for(int i = 0; i < 1000; i++)
+	{
+		int value = rng.range(7);
+		if (value < 0 || value >= 7) { return selfTestFail("random", "range went outside 0 to max - 1"); }
+	}
+
+	return true;
+}
+
+bool selfTestSnapshot(Scene& scene)
+{
+	for(int tick = 0; tick < SELF_TEST_WARMUP_TICKS; tick++)
+	{
+		selfTestTick(scene, scene.getSimTick());
+	}
+
+	//save, write to disk and read back
+	Snapshot saved;
+	scene.saveSnapshot(saved);
+
+	Snapshot reread;
+	bool written = saved.writeFile(SELF_TEST_SNAPSHOT_PATH) && reread.readFile(SELF_TEST_SNAPSHOT_PATH);
+	remove(SELF_TEST_SNAPSHOT_PATH);
+
+	if (!written) { return selfTestFail("snapshot", "unable to write and read back snapshot file"); }
+	if (!sameSnapshot(saved, reread)) { return selfTestFail("snapshot", "snapshot read back from disk differs"); }
+
+	//loading and saving again changes nothing
+	Uint32 roundTicksLeft = scene.getRoundTicksLeft();
+	Snapshot resaved;
+	if (!scene.loadSnapshot(reread)) { return selfTestFail("snapshot", "unable to load snapshot"); }
+	scene.saveSnapshot(resaved);
+	if (!sameSnapshot(saved, resaved)) { return selfTestFail("snapshot", "loaded scene saves differently"); }
+	if (scene.getRoundTicksLeft() != roundTicksLeft || roundTicksLeft != ROUND_TICKS - scene.getSimTick()) { return selfTestFail("snapshot", "round timer wasn't restored"); }
+
+	//play on, then go back to save and play same ticks again
+	Uint32 startTick = scene.getSimTick();
+	for(int tick = 0; tick < SELF_TEST_REPLAY_TICKS; tick++)
+	{
+		selfTestTick(scene, startTick + tick);
+	}
+
+	Snapshot played;
+	scene.saveSnapshot(played);
+
+	if (!scene.loadSnapshot(saved)) { return selfTestFail("snapshot", "unable to load snapshot again"); }
+	for(int tick = 0; tick < SELF_TEST_REPLAY_TICKS; tick++)
+	{
+		selfTestTick(scene, startTick + tick);
+	}
+
+	Snapshot replayed;
+	scene.saveSnapshot(replayed);
+	if (!sameSnapshot(played, replayed)) { return selfTestFail("snapshot", "replay from snapshot diverged"); }
+
+	return true;
+}
+
+bool selfTestNetDelta()
+{
+	Random rng;
+	rng.seed(30);
+
+	//base with ids far enough apart that every removal takes a multi byte gap
+	NetFrame base;
+	base.tick = 100;
+	for(Uint32 i = 1; i <= 4000; i++)
+	{
+		base.entities.push_back(randomEntity(rng, i * 1000 + 7));
+	}
+
+	//nothing to delta against sends everything
+	if (!deltaRoundTrip(NULL, base)) { return selfTestFail("net delta", "full frame didn't round trip"); }
+
+	//same frame sends no changes
+	if (!deltaRoundTrip(&base, base)) { return selfTestFail("net delta", "unchanged frame didn't round trip"); }
+
+	//mass removal, leaving a few changed and a few unchanged and adding new ones past and between base ids
+	NetFrame current;
+	current.tick = 101;
+	current.entities.push_back(randomEntity(rng, 3));
+	current.entities.push_back(base.entities[10]);
+	current.entities.push_back(randomEntity(rng, base.entities[500].id));
+	current.entities.push_back(randomEntity(rng, base.entities[500].id + 1));
+	current.entities.push_back(base.entities[3999]);
+	current.entities.push_back(randomEntity(rng, 0xFFFFFFF0u));
+	if (!deltaRoundTrip(&base, current)) { return selfTestFail("net delta", "mass removal didn't round trip"); }
+
+	//everything removed
+	NetFrame empty;
+	empty.tick = 102;
+	if (!deltaRoundTrip(&base, empty)) { return selfTestFail("net delta", "removing every entity didn't round trip"); }
+
+	//every field of every entity changed
+	NetFrame moved = base;
+	moved.tick = 103;
+	for (NetEntity& entity : moved.entities) { entity = randomEntity(rng, entity.id); }
+	if (!deltaRoundTrip(&base, moved)) { return selfTestFail("net delta", "changing every entity didn't round trip"); }
+
+	//counts past what's left in the body are rejected before anything is sized from them, including ones negative as int
+	static const Uint32 BAD_COUNTS[][2] =
+	{
+		{ 0x80000000u, 0 }, { 0xFFFFFFFFu, 0 }, { 3, 0 }, { 0, 0x80000000u }, { 0, 0xFFFFFFFFu }, { 0, 3 }
+	};
+	for(const Uint32* counts : BAD_COUNTS)
+	{
+		Uint8 body[16];
+		NetWriter writer(body, sizeof(body));
+		writer.writeVarint(counts[0]);
+		writer.writeVarint(counts[1]);
+
+		NetReader reader(body, writer.getSize());
+		NetFrame decoded;
+		if (decodeDelta(reader, &base, decoded)) { return selfTestFail("net delta", "malformed count was accepted"); }
+	}
+
+	return true;
+}
+
+bool selfTestFlowField()
+{
+	Random rng;
+	rng.seed(31);
+
+	FlowField repaired;
+	repaired.init(SCREEN_WIDTH, SCREEN_HEIGHT);
+
+	//players wander a few cells at a time and now and then jump across screen
+	SDL_Point sources[4] = { { 100, 100 }, { SCREEN_WIDTH - 80, SCREEN_HEIGHT - 60 }, { SCREEN_X_CENTER, SCREEN_Y_CENTER }, { 300, SCREEN_HEIGHT - 160 } };
+	for(int step = 0; step < 400; step++)
+	{
+		int count = 1 + (step / 100) % 4;
+		for(int i = 0; i < count; i++)
+		{
+			sources[i].x = std::clamp(sources[i].x + rng.range(97) - 48, 0, SCREEN_WIDTH - 1);
+			sources[i].y = std::clamp(sources[i].y + rng.range(97) - 48, 0, SCREEN_HEIGHT - 1);
+			if (rng.range(50) == 0) { sources[i] = { rng.range(SCREEN_WIDTH), rng.range(SCREEN_HEIGHT) }; }
+		}
+		repaired.update(sources, count);
+
+		FlowField full;
+		full.init(SCREEN_WIDTH, SCREEN_HEIGHT);
+		full.update(sources, count);
+
+		//every cell is as far and steers the same way
+		for(int y = FLOW_CELL_SIZE / 2; y < SCREEN_HEIGHT; y += FLOW_CELL_SIZE)
+		{
+			for(int x = FLOW_CELL_SIZE / 2; x < SCREEN_WIDTH; x += FLOW_CELL_SIZE)
+			{
+				SDL_Point a = repaired.steer({ x, y });
+				SDL_Point b = full.steer({ x, y });
+				if (repaired.getDistance({ x, y }) != full.getDistance({ x, y }) || a.x != b.x || a.y != b.y) { return selfTestFail("flow field", "repaired field differs from full search"); }
+			}
+		}
+	}
+
+	if (repaired.getRepairs() == 0) { return selfTestFail("flow field", "moving players never repaired field"); }
+
+	return true;
+}
+
+bool selfTestSlotMap()
+{
+	SlotMap<int> map;
+	SlotHandle a = map.insert(1);
+	SlotHandle b = map.insert(2);
+	SlotHandle c = map.insert(3);
+
+	//removed handle is stale, and items after it keep their values after being moved into its place
+	if (!map.remove(a) || map.contains(a) || map.get(a) != NULL || map.remove(a)) { return selfTestFail("slot map", "removed handle still works"); }
+	if (map.size() != 2 || *map.get(b) != 2 || *map.get(c) != 3) { return selfTestFail("slot map", "remove lost another item"); }
+
+	//reused slot gets a new generation, old handle stays stale
+	SlotHandle d = map.insert(4);
+	if (d.index != a.index || d.generation == a.generation) { return selfTestFail("slot map", "freed slot wasn't reused with a new generation"); }
+	if (map.contains(a) || map.get(a) != NULL || *map.get(d) != 4) { return selfTestFail("slot map", "stale handle reached reused slot"); }
+
+	//null handle never refers to anything
+	if (map.contains(NULL_HANDLE)) { return selfTestFail("slot map", "null handle matched an item"); }
+
+	//generations count up and skip 0 on wrap
+	if (nextGeneration(1) != 2 || nextGeneration(0xFFFFFFFEu) != 0xFFFFFFFFu || nextGeneration(0xFFFFFFFFu) != 1) { return selfTestFail("slot map", "generation didn't wrap to 1"); }
+
+	//clear makes every handle stale
+	map.clear();
+	if (!map.empty() || map.contains(b) || map.contains(c) || map.contains(d)) { return selfTestFail("slot map", "clear left a handle working"); }
+
+	//random inserts and removes, every live handle finds its value and every removed one stays stale
+	Random rng;
+	rng.seed(40);
+	std::vector<std::pair<SlotHandle, int>> live;
+	std::vector<SlotHandle> dead;
+	for(int step = 0; step < 2000; step++)
+	{
+		if(live.empty() || rng.range(3) != 0)
+		{
+			live.push_back({ map.insert(step), step });
+		}
+		else
+		{
+			int pick = rng.range((int)live.size());
+			map.remove(live[pick].first);
+			dead.push_back(live[pick].first);
+			live[pick] = live.back();
+			live.pop_back();
+		}
+	}
+
+	for(const auto& entry : live)
+	{
+		if (map.get(entry.first) == NULL || *map.get(entry.first) != entry.second) { return selfTestFail("slot map", "live handle lost its item"); }
+	}
+	for(SlotHandle handle : dead)
+	{
+		if (map.contains(handle)) { return selfTestFail("slot map", "removed handle came back"); }
+	}
+	if (map.size() != (int)live.size()) { return selfTestFail("slot map", "size doesn't match live items"); }
+
+	return true;
+}
+
+bool selfTestTimerWheel()
+{
+	TimerWheel wheel;
+
+	//run a tick ahead so due ticks don't line up with ring boundaries from 0
+	wheel.advance();
+
+	//delays on each side of every ring boundary and past the top ring's reach
+	static const Uint32 DELAYS[] =
+	{
+		1, 2, WHEEL_SLOTS - 1, WHEEL_SLOTS, WHEEL_SLOTS + 1,
+		(1u << (WHEEL_SLOT_BITS * 2)) - 1, 1u << (WHEEL_SLOT_BITS * 2), (1u << (WHEEL_SLOT_BITS * 2)) + 1,
+		(1u << (WHEEL_SLOT_BITS * 3)) - 1, 1u << (WHEEL_SLOT_BITS * 3), (1u << (WHEEL_SLOT_BITS * 3)) + 1,
+		WHEEL_RANGE - 1, WHEEL_RANGE, WHEEL_RANGE + 100
+	};
+	const int delayCount = sizeof(DELAYS) / sizeof(DELAYS[0]);
+
+	Uint32 firedAt[delayCount] = { 0 };
+	for(int i = 0; i < delayCount; i++)
+	{
+		Uint32* slot = &firedAt[i];
+		wheel.schedule(DELAYS[i], [slot, &wheel] { *slot = wheel.getTick(); });
+	}
+	Uint32 start = wheel.getTick();
+
+	//timers due together fire in order scheduled, and callbacks can cancel one due same tick or schedule another
+	std::vector<int> order;
+	SlotHandle cancelledLater = NULL_HANDLE;
+	Uint32 rescheduledAt = 0;
+	wheel.schedule(200, [&order] { order.push_back(0); });
+	wheel.schedule(200, [&] { order.push_back(1); wheel.cancel(cancelledLater); wheel.schedule(1, [&] { rescheduledAt = wheel.getTick(); }); });
+	wheel.schedule(200, [&order] { order.push_back(2); });
+	cancelledLater = wheel.schedule(200, [&order] { order.push_back(3); });
+
+	//cancelled timer is stale and never fires
+	bool cancelledFired = false;
+	SlotHandle cancelled = wheel.schedule(WHEEL_SLOTS * 3, [&cancelledFired] { cancelledFired = true; });
+	if (!wheel.isPending(cancelled) || wheel.remaining(cancelled) != WHEEL_SLOTS * 3) { return selfTestFail("timer wheel", "new timer isn't pending"); }
+	if (!wheel.cancel(cancelled) || wheel.isPending(cancelled) || wheel.cancel(cancelled) || wheel.remaining(cancelled) != 0) { return selfTestFail("timer wheel", "cancelled handle still works"); }
+
+	//fired timer is stale, even once its slot is reused
+	SlotHandle first = wheel.schedule(1);
+	wheel.advance();
+	SlotHandle reused = wheel.schedule(5);
+	if (wheel.isPending(first) || wheel.cancel(first) || !wheel.isPending(reused)) { return selfTestFail("timer wheel", "fired handle still works"); }
+	wheel.cancel(reused);
+
+	while (wheel.getPending() > 0) { wheel.advance(); }
+
+	for(int i = 0; i < delayCount; i++)
+	{
+		if (firedAt[i] != start + DELAYS[i]) { return selfTestFail("timer wheel", "timer fired on wrong tick"); }
+	}
+
+	if (order.size() != 3 || order[0] != 0 || order[1] != 1 || order[2] != 2) { return selfTestFail("timer wheel", "timers due together fired out of order"); }
+	if (rescheduledAt != start + 201) { return selfTestFail("timer wheel", "timer scheduled from callback fired on wrong tick"); }
+	if (cancelledFired) { return selfTestFail("timer wheel", "cancelled timer fired"); }
+
+	return true;
+}
+
+//fold a value into a running checksum
+static Uint32 mixChecksum(Uint32 sum, Sint32 value)
+{
+	return (sum ^ (Uint32)value) * 16777619u;
+}
+
+//turns between two angles, whichever way round is shorter
+static int angleDistance(FixedAngle a, FixedAngle b)
+{
+	return std::abs((int)(Sint16)(FixedAngle)(a - b));
+}
+
+bool selfTestFixedMath()
+{
+	Uint32 checksum = 2166136261u;
+
+	//every angle against libm
+	for(int angle = 0; angle < FIXED_ANGLE_TURN; angle++)
+	{
+		double radians = fixedAngleToRadians((FixedAngle)angle);
+		Fixed sine = fixedSin((FixedAngle)angle);
+		Fixed cosine = fixedCos((FixedAngle)angle);
+		if (std::abs(sine - std::sin(radians) * FIXED_ONE) > FIXED_SINE_ERROR) { return selfTestFail("fixed math", "sine outside its error bound"); }
+		if (std::abs(cosine - std::cos(radians) * FIXED_ONE) > FIXED_SINE_ERROR) { return selfTestFail("fixed math", "cosine outside its error bound"); }
+		checksum = mixChecksum(checksum, sine);
+	}
+
+	//quarter turns land exactly, so axis movement doesn't drift
+	static const Fixed QUARTER_SINES[4] = { 0, FIXED_ONE, 0, -FIXED_ONE };
+	for(int quarter = 0; quarter < 4; quarter++)
+	{
+		FixedAngle angle = (FixedAngle)(quarter * FIXED_ANGLE_QUARTER);
+		if (fixedSin(angle) != QUARTER_SINES[quarter] || fixedCos(angle) != QUARTER_SINES[(quarter + 1) % 4]) { return selfTestFail("fixed math", "quarter turn wasn't exact"); }
+	}
+
+	//axes, diagonals and a zero vector, including components at the ends of Sint32
+	struct AtanCase { Sint32 y; Sint32 x; FixedAngle angle; };
+	static const AtanCase ATAN_CASES[] =
+	{
+		{ 0, 0, 0 }, { 0, 1, 0 }, { 1, 0, 16384 }, { 0, -1, 32768 }, { -1, 0, 49152 },
+		{ 5, 5, 8192 }, { 5, -5, 24576 }, { -5, -5, 40960 }, { -5, 5, 57344 },
+		{ 0, INT_MAX, 0 }, { INT_MAX, 0, 16384 }, { 0, INT_MIN, 32768 }, { INT_MIN, 0, 49152 },
+		{ INT_MIN, INT_MIN, 40960 }, { INT_MAX, INT_MIN, 24576 }
+	};
+	for(const AtanCase& test : ATAN_CASES)
+	{
+		if (angleDistance(fixedAtan2(test.y, test.x), test.angle) > FIXED_ATAN_ERROR) { return selfTestFail("fixed math", "arctangent edge case wrong"); }
+	}
+	if (fixedAtan2(0, 0) != 0 || fixedAtan2(1, 0) != FIXED_ANGLE_QUARTER || fixedAtan2(0, -1) != FIXED_ANGLE_TURN / 2) { return selfTestFail("fixed math", "arctangent of an axis wasn't exact"); }
+
+	//grid of vectors in every octant against libm
+	for(int y = -300; y <= 300; y += 7)
+	{
+		for(int x = -300; x <= 300; x += 11)
+		{
+			if (x == 0 && y == 0) { continue; }
+
+			FixedAngle angle = fixedAtan2(y, x);
+			FixedAngle exact = (FixedAngle)(Sint32)std::lround(std::atan2((double)y, (double)x) * FIXED_ANGLE_TURN / (2 * M_PI));
+			if (angleDistance(angle, exact) > FIXED_ATAN_ERROR) { return selfTestFail("fixed math", "arctangent outside its error bound"); }
+			checksum = mixChecksum(checksum, angle);
+		}
+	}
+
+	//square root rounds down, exact squares come out exact, 0 and negatives give 0, largest value doesn't overflow
+	if (fixedSqrt(0) != 0 || fixedSqrt(-FIXED_ONE) != 0 || fixedSqrt(INT_MIN) != 0) { return selfTestFail("fixed math", "square root of 0 or a negative wasn't 0"); }
+	for(int whole = 1; whole <= 181; whole++)
+	{
+		if (fixedSqrt(fixedFromInt(whole * whole)) != fixedFromInt(whole)) { return selfTestFail("fixed math", "square root of an exact square wasn't exact"); }
+	}
+	for(Sint64 value = 1; value <= INT_MAX; value = value * 3 + 1)
+	{
+		Fixed root = fixedSqrt((Fixed)value);
+		if (root != (Fixed)std::floor(std::sqrt((double)value * FIXED_ONE))) { return selfTestFail("fixed math", "square root wasn't rounded down"); }
+		checksum = mixChecksum(checksum, root);
+	}
+	if (fixedSqrt(INT_MAX) != (Fixed)std::floor(std::sqrt((double)INT_MAX * FIXED_ONE))) { return selfTestFail("fixed math", "square root of largest value wrong"); }
+
+	//whole numbers saturate at the ends of their range, truncation and rounding work at the ends of Fixed
+	if (fixedFromInt(FIXED_INT_MAX) != FIXED_INT_MAX * FIXED_ONE || fixedFromInt(FIXED_INT_MIN) != INT_MIN) { return selfTestFail("fixed math", "whole number at end of range didn't convert"); }
+	if (fixedFromInt(40000) != fixedFromInt(FIXED_INT_MAX) || fixedFromInt(-40000) != INT_MIN) { return selfTestFail("fixed math", "whole number out of range didn't saturate"); }
+	if (fixedTrunc(INT_MIN) != FIXED_INT_MIN || fixedTrunc(INT_MAX) != FIXED_INT_MAX || fixedTrunc(-FIXED_HALF) != 0 || fixedTrunc(-FIXED_ONE - 1) != -1) { return selfTestFail("fixed math", "truncation wasn't toward 0"); }
+	if (fixedRound(INT_MAX) != FIXED_INT_MAX + 1 || fixedRound(INT_MIN) != FIXED_INT_MIN || fixedRound(FIXED_HALF) != 1) { return selfTestFail("fixed math", "rounding wrong at end of range"); }
+
+	//64 bit intermediates clamp to Fixed's range, e.g. seconds into a wave on a host up for more than 9 hours
+	Sint64 lateSeconds = (Sint64)2000000 * FIXED_ONE / SCREEN_FPS;
+	if (fixedSaturate(lateSeconds) != INT_MAX || fixedSaturate(-lateSeconds) != INT_MIN || fixedSaturate(-5) != -5) { return selfTestFail("fixed math", "64 bit value didn't saturate"); }
+
+	if(checksum != FIXED_MATH_EXPECTED)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Self test fixed math checksum was %u\n", checksum);
+		return selfTestFail("fixed math", "results changed from known checksum");
+	}
+
+	return true;
+}
+
+int runSelfTests(Scene& scene)
+{
+	int failed = 0;
+
+	failed += !selfTestRandom();
+	failed += !selfTestSnapshot(scene);
+	failed += !selfTestNetDelta();
+	failed += !selfTestFlowField();
+	failed += !selfTestSlotMap();
+	failed += !selfTestTimerWheel();
+	failed += !selfTestFixedMath();
+
+	if(failed == 0)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "Self tests passed\n");
+	}
+
+	return failed;
+}
@@ -0,0 +1,45 @@
+/*
+Title:	SelfTest.h
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: header file for self tests for my game engine. Each check exercises one module against known answers and logs what
+	went wrong if it fails, so CI can run the checks with --self-test instead of relying on a person watching a soak run.
+ */
+
+#pragma once
+#ifndef SELFTEST_H
+#define SELFTEST_H
+
+#include <SDL.h>
+
+//forward declaration
+class Scene;
+
+//random sequence from a fixed seed matches known values, and restoring state replays it
+bool selfTestRandom();
+
+//scene saved, written to disk and read back is byte for byte the same, keeps its round timer, and plays on the same as the
+//original
+bool selfTestSnapshot(Scene& scene);
+
+//net deltas decode back to frame they were encoded from, including mass removals, in a buffer sized like server's
+bool selfTestNetDelta();
+
+//flow field repaired as players move matches one searched from scratch
+bool selfTestFlowField();
+
+//slot map handles go stale on remove and stay stale after their slot is reused, generations wrap past 0
+bool selfTestSlotMap();
+
+//timer wheel fires timers on their due tick across every ring and past its range, in schedule order, and cancelled or
+//fired handles go stale
+bool selfTestTimerWheel();
+
+//fixed point sine, cosine, arctangent and square root stay within their stated error of the math library, hit quarter
+//turns and edge cases exactly, and give the same results they always have. Whole number conversions and 64 bit
+//intermediates saturate at their range
+bool selfTestFixedMath();
+
+//run every check, scene must have its player and media. Returns number of checks failed
+int runSelfTests(Scene& scene);
+#endif
@@ -0,0 +1,193 @@
+/*
+Title:	Session.cpp
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: implementation file for Session and SessionHost classes for my game engine
+ */
+
+#include "Session.h"
+#include <algorithm>
+
+Session::Session()
+{
+	//initialize variables
+	served = false;
+	rounds = 0;
+	result = ROUND_PLAYING;
+}
+
+Session::~Session()
+{
+	free();
+}
+
+bool Session::init(const SessionMedia& media, const WaveScript& waves, Uint64 seed, Uint16 port)
+{
+	//scene draws nothing itself, renderer only lets sprites be made from shared textures
+	scene.shareRenderer(media.renderer);
+	scene.seed(seed);
+	scene.setPlayerProjectile(media.projectile, media.muzzleFlash);
+	scene.setEnemyTexture(media.enemy);
+	scene.setPlayerTexture(media.player);
+
+	//copied so sessions don't each read the file
+	scene.getWaves() = waves;
+
+	//clients bring their own players
+	if(port != 0)
+	{
+		served = server.start(&scene, port, media.player);
+		return served;
+	}
+
+	//bot plays in middle of screen like local player would
+	Sprite* player = scene.addSprite(true, ENTITY, media.player);
+	player->setPos(SCREEN_X_CENTER - (player->getWidth() / 2), SCREEN_Y_CENTER - (player->getHeight() / 2));
+	scene.setPlayer(player);
+
+	//every round starts from here
+	scene.saveSnapshot(roundStartState);
+
+	return true;
+}
+
+void Session::free()
+{
+	server.stop();
+	served = false;
+	scene.free();
+}
+
+void Session::step(const PlayerInput* action)
+{
+	if(served)
+	{
+		//apply client inputs, step scene and send results
+		server.receive();
+		scene.simulate();
+		server.sendSnapshots();
+		return;
+	}
+
+	Sprite* player = scene.getPlayer();
+	if (action == NULL) { botInput(); }
+	else if (player != NULL) { player->setInput(*action); }
+
+	scene.simulate();
+
+	//round over when scene's round timer runs out or player dies, then it plays again from start
+	player = scene.getPlayer();
+	result = player == NULL || player->getHealth() == 0 ? ROUND_DIED : scene.isRoundSurvived() ? ROUND_SURVIVED : ROUND_PLAYING;
+	if(result != ROUND_PLAYING)
+	{
+		reset();
+		rounds++;
+	}
+}
+
+void Session::reset()
+{
+	//served scenes have no start saved
+	if(served)
+	{
+		return;
+	}
+
+	scene.loadSnapshot(roundStartState);
+}
+
+void Session::botInput()
+{
+	Sprite* player = scene.getPlayer();
+	if(player == NULL)
+	{
+		return;
+	}
+
+	Uint32 tick = scene.getSimTick();
+	Uint32 phase = (tick / 30) % 4;
+
+	PlayerInput input = {};
+	input.keys = phase == 0 ? INPUT_UP : phase == 1 ? INPUT_RIGHT : phase == 2 ? INPUT_DOWN : INPUT_LEFT;
+	input.fire = true;
+	input.aimX = (Sint16)((tick * 37) % SCREEN_WIDTH);
+	input.aimY = (Sint16)((tick * 23) % SCREEN_HEIGHT);
+
+	player->setInput(input);
+}
+
+SessionHost::SessionHost()
+{
+	//initialize variables
+	shardCount = 0;
+	steps = 0;
+	stepActions = NULL;
+	stepAfter = NULL;
+}
+
+SessionHost::~SessionHost()
+{
+	free();
+}
+
+bool SessionHost::init(int count, int shardCount, const SessionMedia& media, const WaveScript& waves, Uint64 seed, Uint16 port)
+{
+	free();
+
+	//default to a shard per core, and never more shards than sessions
+	if (shardCount <= 0) { shardCount = std::max((int)std::thread::hardware_concurrency(), 1); }
+	this->shardCount = std::max(std::min(shardCount, count), 1);
+
+	for(int i = 0; i < count; i++)
+	{
+		sessions.push_back(std::make_unique<Session>());
+
+		//each session plays its own game
+		if(!sessions.back()->init(media, waves, seed + i, port != 0 ? (Uint16)(port + i) : 0))
+		{
+			SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Unable to start session %d\n", i);
+			free();
+			return false;
+		}
+	}
+
+	//calling thread steps a shard too
+	if (this->shardCount > 1) { pool.start(this->shardCount - 1); }
+
+	SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "Hosting %d sessions in %d shards\n", count, this->shardCount);
+
+	return true;
+}
+
+void SessionHost::free()
+{
+	pool.stop();
+	sessions.clear();
+	shardCount = 0;
+	steps = 0;
+}
+
+void SessionHost::step(const PlayerInput* actions, const std::function<void(int)>& after)
+{
+	//kept on host so shard task only holds this and fits in std::function without allocating
+	stepActions = actions;
+	stepAfter = &after;
+
+	//each shard steps its run of sessions in order, so a session is only ever on one thread at a time
+	pool.parallelFor(shardCount, [this](int shard) { stepShard(shard); });
+
+	steps += (Sint64)sessions.size();
+}
+
+void SessionHost::stepShard(int shard)
+{
+	int count = (int)sessions.size();
+	int first = shard * count / shardCount;
+	int last = (shard + 1) * count / shardCount;
+
+	for(int i = first; i < last; i++)
+	{
+		sessions[i]->step(stepActions != NULL ? &stepActions[i] : NULL);
+		if (*stepAfter) { (*stepAfter)(i); }
+	}
+}
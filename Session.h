@@ -0,0 +1,133 @@
+/*
+Title:	Session.h
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: header file for Session and SessionHost classes for my game engine. A session is one game: a scene with its own
+	random generator, sprites, timers and a round clock counted in simulation ticks, played by a bot or served to clients on
+	a port of its own. Sessions never touch SDL's window or event queue, so any thread can step one.
+
+	SessionHost runs many sessions in one process. They are split into shards, contiguous runs of sessions, and each tick
+	every shard is stepped by one worker thread, so sessions scale with cores without sharing anything while they run.
+ */
+
+#pragma once
+#ifndef SESSION_H
+#define SESSION_H
+
+#include <SDL.h>
+#include <memory>
+#include <functional>
+#include <vector>
+#include "Scene.h"
+#include "NetGame.h"
+#include "Snapshot.h"
+#include "ThreadPool.h"
+
+//how a step left the round
+enum RoundResult
+{
+	ROUND_PLAYING, ROUND_SURVIVED, ROUND_DIED
+};
+
+//renderer and textures sessions make sprites with, loaded once and shared by every session. Sessions never draw with
+//them, sprites only take their sizes
+struct SessionMedia
+{
+	SDL_Renderer* renderer;
+	SDL_Texture* player;
+	SDL_Texture* enemy;
+	SDL_Texture* projectile;
+	SDL_Texture* muzzleFlash;
+};
+
+class Session
+{
+public:
+	//initialize variables
+	Session();
+
+	//destructor
+	~Session();
+
+	//set scene up for a round. Served on port to clients if port isn't 0, otherwise played by a bot. Main thread only
+	bool init(const SessionMedia& media, const WaveScript& waves, Uint64 seed, Uint16 port);
+
+	//deallocates resources
+	void free();
+
+	//run one tick: take input, simulate and send results to clients. Player takes action if one is given, otherwise bot
+	//plays. A played round starts over once it ends
+	void step(const PlayerInput* action = NULL);
+
+	//start played round over from its start
+	void reset();
+
+	//getters
+	Scene& getScene() { return scene; }
+	bool isServed() const { return served; }
+	Uint32 getRoundTicks() const { return ROUND_TICKS - scene.getRoundTicksLeft(); }	//get ticks into current round
+	int getRounds() const { return rounds; }									//get rounds finished by player
+	RoundResult getResult() const { return result; }							//get how last step left round
+	int getClientCount() const { return served ? server.getClientCount() : 0; }
+
+private:
+	//give bot player input for this tick, circling and firing constantly like the soak test bot
+	void botInput();
+
+	//simulated game
+	Scene scene;
+
+	//clients' server, only open when served
+	NetServer server;
+	bool served;
+
+	//state at start of round, restored when a played round ends
+	Snapshot roundStartState;
+	int rounds;
+	RoundResult result;
+};
+
+class SessionHost
+{
+public:
+	//initialize variables
+	SessionHost();
+
+	//destructor
+	~SessionHost();
+
+	//make count sessions seeded from seed, split into shards. A shard count of 0 uses one per core. Served sessions get
+	//ports counting up from port, 0 for bots. Main thread only
+	bool init(int count, int shardCount, const SessionMedia& media, const WaveScript& waves, Uint64 seed, Uint16 port);
+
+	//deallocates resources
+	void free();
+
+	//step every session once, shards in parallel, taking actions[i] if actions are given. after is called with each
+	//session's index on thread that stepped it, right after its step. Returns once all are done
+	void step(const PlayerInput* actions = NULL, const std::function<void(int)>& after = nullptr);
+
+	//getters
+	int getSessionCount() const { return (int)sessions.size(); }
+	int getShardCount() const { return shardCount; }
+	Session& getSession(int index) { return *sessions[index]; }
+	Sint64 getSteps() const { return steps; }			//get session ticks run since init, over every session
+
+private:
+	//sessions, held by pointer since sprites point back at their scene
+	std::vector<std::unique_ptr<Session>> sessions;
+
+	//step sessions in shard with actions and callback of step in progress
+	void stepShard(int shard);
+
+	//workers shards are stepped on
+	ThreadPool pool;
+	int shardCount;
+
+	//actions and callback of step in progress
+	const PlayerInput* stepActions;
+	const std::function<void(int)>* stepAfter;
+
+	Sint64 steps;
+};
+#endif
@@ -0,0 +1,146 @@
+/*
+Title:	SlotMap.h
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: header file for SlotMap class template for my game engine. Items are kept packed in one array so iterating them is a
+	straight walk, and are reached through handles made of a slot index and that slot's generation. Removing an item moves
+	the last item into its place and bumps its slot's generation, so insert, remove and lookup are all O(1), and a handle
+	to a removed item finds nothing instead of whatever moved into its memory.
+ */
+
+#pragma once
+#ifndef SLOTMAP_H
+#define SLOTMAP_H
+
+#include <SDL.h>
+#include <vector>
+#include <utility>
+
+//reference to an item in a slot map. Generation 0 is never used, so a zeroed handle refers to nothing
+struct SlotHandle
+{
+	Uint32 index;
+	Uint32 generation;
+
+	bool operator==(const SlotHandle& other) const { return index == other.index && generation == other.generation; }
+	bool operator!=(const SlotHandle& other) const { return !(*this == other); }
+};
+
+//handle that refers to nothing
+const SlotHandle NULL_HANDLE = { 0, 0 };
+
+//generation a slot gets when reused. 0 is skipped on wrap so it never matches NULL_HANDLE
+inline Uint32 nextGeneration(Uint32 generation) { return generation + 1 != 0 ? generation + 1 : 1; }
+
+template <typename T>
+class SlotMap
+{
+public:
+	//add item, returns its handle. Pointers to items are only good until the next insert or remove
+	template <typename... Args>
+	SlotHandle insert(Args&&... args)
+	{
+		//reuse a freed slot if there is one
+		Uint32 slot;
+		if(freeSlots.empty())
+		{
+			slot = (Uint32)slots.size();
+			slots.push_back({ 0, 1 });
+		}
+		else
+		{
+			slot = freeSlots.back();
+			freeSlots.pop_back();
+		}
+
+		slots[slot].item = (Uint32)items.size();
+		items.emplace_back(std::forward<Args>(args)...);
+		itemSlots.push_back(slot);
+
+		return { slot, slots[slot].generation };
+	}
+
+	//remove item, moving last item into its place. Returns false if handle is stale
+	bool remove(SlotHandle handle)
+	{
+		if(!contains(handle))
+		{
+			return false;
+		}
+
+		Uint32 item = slots[handle.index].item;
+		Uint32 last = (Uint32)items.size() - 1;
+
+		if(item != last)
+		{
+			items[item] = std::move(items[last]);
+			itemSlots[item] = itemSlots[last];
+			slots[itemSlots[item]].item = item;
+		}
+
+		items.pop_back();
+		itemSlots.pop_back();
+
+		//old handles stop matching
+		slots[handle.index].generation = nextGeneration(slots[handle.index].generation);
+		freeSlots.push_back(handle.index);
+
+		return true;
+	}
+
+	//get item for handle, NULL if it was removed
+	T* get(SlotHandle handle) { return contains(handle) ? &items[slots[handle.index].item] : NULL; }
+	const T* get(SlotHandle handle) const { return contains(handle) ? &items[slots[handle.index].item] : NULL; }
+
+	//check handle still refers to an item
+	bool contains(SlotHandle handle) const
+	{
+		return handle.index < slots.size() && handle.generation != 0 && slots[handle.index].generation == handle.generation;
+	}
+
+	//get handle of item at packed position
+	SlotHandle handleAt(int position) const { return { itemSlots[position], slots[itemSlots[position]].generation }; }
+
+	//remove every item, handles to them go stale
+	void clear()
+	{
+		while (!items.empty()) { remove(handleAt((int)items.size() - 1)); }
+	}
+
+	//make room for count items without reallocating
+	void reserve(int count)
+	{
+		items.reserve(count);
+		itemSlots.reserve(count);
+		slots.reserve(count);
+	}
+
+	//packed items, in no particular order once items have been removed
+	T& operator[](int position) { return items[position]; }
+	const T& operator[](int position) const { return items[position]; }
+	T* begin() { return items.data(); }
+	T* end() { return items.data() + items.size(); }
+	const T* begin() const { return items.data(); }
+	const T* end() const { return items.data() + items.size(); }
+
+	//getters
+	int size() const { return (int)items.size(); }
+	bool empty() const { return items.empty(); }
+
+private:
+	//where a slot's item is, and how many times slot has been reused
+	struct Slot
+	{
+		Uint32 item;
+		Uint32 generation;
+	};
+
+	//packed items, and slot each one belongs to
+	std::vector<T> items;
+	std::vector<Uint32> itemSlots;
+
+	//slots handles index, and ones free for reuse
+	std::vector<Slot> slots;
+	std::vector<Uint32> freeSlots;
+};
+#endif
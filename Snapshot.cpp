@@ -0,0 +1,61 @@
+/*
+Title:	Snapshot.cpp
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: implementation file for Snapshot class for my game engine
+ */
+
+#include "Snapshot.h"
+#include <fstream>
+
+Snapshot::Snapshot()
+{
+	size = 0;
+	readPos = 0;
+
+	reserve(SNAPSHOT_DEFAULT_BYTES);
+}
+
+void Snapshot::reserve(size_t bytes)
+{
+	if(bytes > buffer.size())
+	{
+		buffer.resize(bytes);
+	}
+}
+
+bool Snapshot::writeFile(std::string path) const
+{
+	std::ofstream file(path, std::ios::binary);
+	if(!file)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Unable to write snapshot %s\n", path.c_str());
+		return false;
+	}
+
+	file.write((const char*)buffer.data(), size);
+
+	return (bool)file;
+}
+
+bool Snapshot::readFile(std::string path)
+{
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if(!file)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Unable to open snapshot %s\n", path.c_str());
+		return false;
+	}
+
+	//file was opened at end to get its size
+	size_t fileSize = (size_t)file.tellg();
+	file.seekg(0);
+
+	reserve(fileSize);
+	file.read((char*)buffer.data(), fileSize);
+
+	size = file ? fileSize : 0;
+	readPos = 0;
+
+	return size > 0;
+}
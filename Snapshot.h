@@ -0,0 +1,105 @@
+/*
+Title:	Snapshot.h
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: header file for Snapshot class for my game engine. Holds a compact binary copy of a scene's simulation state in a
+	reusable buffer, used for quick save/load, rollback and starting benchmarks from a mid-game state.
+
+	Layout (native endian):
+		SnapshotHeader
+		SpriteState[entityCount]		entity list in order, player included
+		SpriteState[projectileCount]	projectile list in order
+ */
+
+#pragma once
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <SDL.h>
+#include <string>
+#include <vector>
+#include <cstring>
+
+//snapshot constants
+const Uint32 SNAPSHOT_MAGIC = 0x50414E53;	//"SNAP"
+const Uint16 SNAPSHOT_VERSION = 5;
+const size_t SNAPSHOT_DEFAULT_BYTES = 64 * 1024;
+
+//fixed part of a snapshot
+struct SnapshotHeader
+{
+	Uint32 magic;
+	Uint16 version;
+	Uint16 headerSize;
+	Uint32 entityCount;
+	Uint32 projectileCount;
+	Uint64 roundTicksLeft;
+	Uint64 randState;
+	float enemyCountdown;
+	Sint32 enemyCount;
+	Sint32 framesCounted;
+	Uint32 nextSpriteId;
+	Uint32 simTick;
+	Uint32 padding;
+};
+
+class Snapshot
+{
+public:
+	//preallocates default buffer
+	Snapshot();
+
+	//grow buffer ahead of time so saving never allocates
+	void reserve(size_t bytes);
+
+	//start writing from the beginning of buffer
+	void clear() { size = 0; readPos = 0; }
+
+	//append raw bytes, growing buffer if reserve was too small
+	void write(const void* data, size_t bytes)
+	{
+		if (size + bytes > buffer.size()) { buffer.resize((size + bytes) * 2); }
+		memcpy(buffer.data() + size, data, bytes);
+		size += bytes;
+	}
+
+	//read raw bytes from current read position, returns false if snapshot is too short
+	bool read(void* data, size_t bytes)
+	{
+		if (readPos + bytes > size) { return false; }
+		memcpy(data, buffer.data() + readPos, bytes);
+		readPos += bytes;
+		return true;
+	}
+
+	//move read position back to start
+	void rewind() { readPos = 0; }
+
+	//get pointer to bytes at read position and skip past them, NULL if snapshot is too short
+	const void* readPointer(size_t bytes)
+	{
+		if (readPos + bytes > size) { return NULL; }
+		readPos += bytes;
+		return buffer.data() + readPos - bytes;
+	}
+
+	//overwrite bytes already written, used to patch header counts
+	void patch(size_t offset, const void* data, size_t bytes) { memcpy(buffer.data() + offset, data, bytes); }
+
+	//save to or load from disk
+	bool writeFile(std::string path) const;
+	bool readFile(std::string path);
+
+	//getters
+	size_t getSize() const { return size; }		//get bytes used
+	bool isEmpty() const { return size == 0; }
+
+private:
+	//snapshot bytes, only grows
+	std::vector<Uint8> buffer;
+
+	//bytes used and read position
+	size_t size;
+	size_t readPos;
+};
+#endif
@@ -0,0 +1,741 @@
+/*
+Title:	SoftRenderer.cpp
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: implementation file for SoftRenderer class for my game engine
+ */
+
+#include "SoftRenderer.h"
+#include "MemTrack.h"
+#include "PerfOverlay.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+//blend one premultiplied pixel over another, dividing by 255 with rounding the same way the SIMD paths do
+static inline Uint32 blendPixel(Uint32 source, Uint32 dest)
+{
+	Uint32 inverse = 255 - (source >> 24);
+
+	Uint32 redBlue = (dest & 0x00FF00FF) * inverse + 0x00800080;
+	redBlue = ((redBlue + ((redBlue >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+
+	Uint32 alphaGreen = ((dest >> 8) & 0x00FF00FF) * inverse + 0x00800080;
+	alphaGreen = (alphaGreen + ((alphaGreen >> 8) & 0x00FF00FF)) & 0xFF00FF00;
+
+	return source + redBlue + alphaGreen;
+}
+
+#if SOFT_LANES == 8
+//blend 8 pixels, channels widened to 16 bits within each 128 bit half
+static inline __m256i blendLanes(__m256i source, __m256i dest)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i full = _mm256_set1_epi16(255);
+	const __m256i round = _mm256_set1_epi16(128);
+
+	__m256i sourceLo = _mm256_unpacklo_epi8(source, zero);
+	__m256i sourceHi = _mm256_unpackhi_epi8(source, zero);
+
+	//copy each pixel's alpha into all 4 of its channels
+	__m256i alphaLo = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(sourceLo, 0xFF), 0xFF);
+	__m256i alphaHi = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(sourceHi, 0xFF), 0xFF);
+
+	__m256i destLo = _mm256_mullo_epi16(_mm256_unpacklo_epi8(dest, zero), _mm256_sub_epi16(full, alphaLo));
+	__m256i destHi = _mm256_mullo_epi16(_mm256_unpackhi_epi8(dest, zero), _mm256_sub_epi16(full, alphaHi));
+
+	//divide by 255
+	destLo = _mm256_add_epi16(destLo, round);
+	destHi = _mm256_add_epi16(destHi, round);
+	destLo = _mm256_srli_epi16(_mm256_add_epi16(destLo, _mm256_srli_epi16(destLo, 8)), 8);
+	destHi = _mm256_srli_epi16(_mm256_add_epi16(destHi, _mm256_srli_epi16(destHi, 8)), 8);
+
+	return _mm256_adds_epu8(source, _mm256_packus_epi16(destLo, destHi));
+}
+#elif SOFT_LANES == 4
+//blend 4 pixels, channels widened to 16 bits
+static inline __m128i blendLanes(__m128i source, __m128i dest)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i full = _mm_set1_epi16(255);
+	const __m128i round = _mm_set1_epi16(128);
+
+	__m128i sourceLo = _mm_unpacklo_epi8(source, zero);
+	__m128i sourceHi = _mm_unpackhi_epi8(source, zero);
+
+	//copy each pixel's alpha into all 4 of its channels
+	__m128i alphaLo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sourceLo, 0xFF), 0xFF);
+	__m128i alphaHi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sourceHi, 0xFF), 0xFF);
+
+	__m128i destLo = _mm_mullo_epi16(_mm_unpacklo_epi8(dest, zero), _mm_sub_epi16(full, alphaLo));
+	__m128i destHi = _mm_mullo_epi16(_mm_unpackhi_epi8(dest, zero), _mm_sub_epi16(full, alphaHi));
+
+	//divide by 255
+	destLo = _mm_add_epi16(destLo, round);
+	destHi = _mm_add_epi16(destHi, round);
+	destLo = _mm_srli_epi16(_mm_add_epi16(destLo, _mm_srli_epi16(destLo, 8)), 8);
+	destHi = _mm_srli_epi16(_mm_add_epi16(destHi, _mm_srli_epi16(destHi, 8)), 8);
+
+	return _mm_adds_epu8(source, _mm_packus_epi16(destLo, destHi));
+}
+#endif
+
+//blend a row of premultiplied pixels over dest. Groups that are fully clear are skipped and fully solid ones copied
+static void blendSpan(Uint32* dest, const Uint32* source, int count)
+{
+	int i = 0;
+
+#if SOFT_LANES == 8
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i solid = _mm256_set1_epi32(255);
+
+	for(; i + 8 <= count; i += 8)
+	{
+		__m256i pixels = _mm256_loadu_si256((const __m256i*)(source + i));
+		__m256i alpha = _mm256_srli_epi32(pixels, 24);
+
+		if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(alpha, zero)) == -1) { continue; }
+
+		if(_mm256_movemask_epi8(_mm256_cmpeq_epi32(alpha, solid)) == -1)
+		{
+			_mm256_storeu_si256((__m256i*)(dest + i), pixels);
+			continue;
+		}
+
+		__m256i under = _mm256_loadu_si256((const __m256i*)(dest + i));
+		_mm256_storeu_si256((__m256i*)(dest + i), blendLanes(pixels, under));
+	}
+#elif SOFT_LANES == 4
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i solid = _mm_set1_epi32(255);
+
+	for(; i + 4 <= count; i += 4)
+	{
+		__m128i pixels = _mm_loadu_si128((const __m128i*)(source + i));
+		__m128i alpha = _mm_srli_epi32(pixels, 24);
+
+		if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, zero)) == 0xFFFF) { continue; }
+
+		if(_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, solid)) == 0xFFFF)
+		{
+			_mm_storeu_si128((__m128i*)(dest + i), pixels);
+			continue;
+		}
+
+		__m128i under = _mm_loadu_si128((const __m128i*)(dest + i));
+		_mm_storeu_si128((__m128i*)(dest + i), blendLanes(pixels, under));
+	}
+#endif
+
+	//pixels left over from SIMD groups
+	for(; i < count; i++)
+	{
+		Uint32 alpha = source[i] >> 24;
+
+		if (alpha == 255) { dest[i] = source[i]; }
+		else if (alpha != 0) { dest[i] = blendPixel(source[i], dest[i]); }
+	}
+}
+
+//sample a line through image with nearest filtering, starting at (u, v) and stepping (stepU, stepV) per pixel, beginning
+//first steps along. Samples outside bounds are clear
+static void sampleSpan(const SoftImage& image, const SDL_Rect& bounds, float u, float v, float stepU, float stepV, int first, Uint32* out, int count)
+{
+	float minU = (float)bounds.x, maxU = (float)(bounds.x + bounds.w);
+	float minV = (float)bounds.y, maxV = (float)(bounds.y + bounds.h);
+	int i = 0;
+
+#if SOFT_LANES == 8
+	const __m256 lanes = _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7);
+	const __m256 startU = _mm256_set1_ps(u), startV = _mm256_set1_ps(v);
+	const __m256 deltaU = _mm256_set1_ps(stepU), deltaV = _mm256_set1_ps(stepV);
+	const __m256i rowWidth = _mm256_set1_epi32(image.width);
+
+	for(; i + 8 <= count; i += 8)
+	{
+		__m256 step = _mm256_add_ps(_mm256_set1_ps((float)(first + i)), lanes);
+		__m256 sampleU = _mm256_add_ps(startU, _mm256_mul_ps(step, deltaU));
+		__m256 sampleV = _mm256_add_ps(startV, _mm256_mul_ps(step, deltaV));
+
+		//lanes inside bounds, compared as floats so small negatives don't truncate to 0
+		__m256 inside = _mm256_and_ps(
+			_mm256_and_ps(_mm256_cmp_ps(sampleU, _mm256_set1_ps(minU), _CMP_GE_OQ), _mm256_cmp_ps(sampleU, _mm256_set1_ps(maxU), _CMP_LT_OQ)),
+			_mm256_and_ps(_mm256_cmp_ps(sampleV, _mm256_set1_ps(minV), _CMP_GE_OQ), _mm256_cmp_ps(sampleV, _mm256_set1_ps(maxV), _CMP_LT_OQ)));
+		__m256i mask = _mm256_castps_si256(inside);
+
+		__m256i index = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_cvttps_epi32(sampleV), rowWidth), _mm256_cvttps_epi32(sampleU));
+		index = _mm256_and_si256(index, mask);
+
+		__m256i pixels = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), (const int*)image.pixels, index, mask, 4);
+		_mm256_storeu_si256((__m256i*)(out + i), pixels);
+	}
+#endif
+
+	for(; i < count; i++)
+	{
+		float sampleU = u + (first + i) * stepU;
+		float sampleV = v + (first + i) * stepV;
+
+		if (sampleU >= minU && sampleU < maxU && sampleV >= minV && sampleV < maxV) { out[i] = image.pixels[(int)sampleV * image.width + (int)sampleU]; }
+		else { out[i] = 0; }
+	}
+}
+
+//screen box covered by dest rotated about its center
+static SDL_Rect transformBounds(const SDL_Rect& dest, float cosine, float sine)
+{
+	float centerX = dest.x + dest.w / 2.0f;
+	float centerY = dest.y + dest.h / 2.0f;
+	float extentX = (fabsf(dest.w * cosine) + fabsf(dest.h * sine)) / 2;
+	float extentY = (fabsf(dest.w * sine) + fabsf(dest.h * cosine)) / 2;
+
+	int left = (int)floorf(centerX - extentX);
+	int top = (int)floorf(centerY - extentY);
+
+	return { left, top, (int)ceilf(centerX + extentX) - left, (int)ceilf(centerY + extentY) - top };
+}
+
+SoftRenderer::SoftRenderer()
+{
+	//initialize variables
+	mRenderer = NULL;
+	frameTexture = NULL;
+	framebuffer = NULL;
+	sampleRow = NULL;
+	width = 0;
+	height = 0;
+	scale = 1;
+	viewWidth = 0;
+	viewHeight = 0;
+	rotationCache = true;
+	pixelsBlended = 0;
+	cachedRotations = 0;
+	tilesX = 0;
+	tilesY = 0;
+}
+
+SoftRenderer::~SoftRenderer()
+{
+	free();
+}
+
+bool SoftRenderer::init(SDL_Renderer* renderer, int width, int height)
+{
+	free();
+
+	framebuffer = (Uint32*)SDL_SIMDAlloc((size_t)width * height * sizeof(Uint32));
+	sampleRow = (Uint32*)SDL_SIMDAlloc((size_t)width * sizeof(Uint32));
+	frameTexture = memTrackTexture(SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, width, height));
+
+	if(framebuffer == NULL || sampleRow == NULL || frameTexture == NULL)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_RENDER, SDL_LOG_PRIORITY_ERROR, "Unable to create software framebuffer! SDL Error: %s\n", SDL_GetError());
+		free();
+		return false;
+	}
+
+	mRenderer = renderer;
+	this->width = width;
+	this->height = height;
+	setScale(1);
+
+	//smooth stretch when drawing at reduced scale
+	SDL_SetTextureScaleMode(frameTexture, SDL_ScaleModeLinear);
+
+	//one command list per tile, partial tiles at right and bottom edges
+	tilesX = (width + SOFT_TILE_SIZE - 1) / SOFT_TILE_SIZE;
+	tilesY = (height + SOFT_TILE_SIZE - 1) / SOFT_TILE_SIZE;
+	tileCommands.assign((size_t)tilesX * tilesY, std::vector<int>());
+	memTrackAlloc(MEM_SOFTRENDER, (size_t)width * (height + 1) * sizeof(Uint32));
+
+	SDL_LogMessage(SDL_LOG_CATEGORY_RENDER, SDL_LOG_PRIORITY_INFO, "Software renderer %dx%d, %d pixel blits\n", width, height, SOFT_LANES);
+
+	return true;
+}
+
+void SoftRenderer::free()
+{
+	//workers may be drawing from images
+	tiles.stop();
+	commands.clear();
+	tileCommands.clear();
+
+	for (auto& entry : images) { freeImage(entry.second); }
+	images.clear();
+
+	if(framebuffer != NULL)
+	{
+		memTrackFree(MEM_SOFTRENDER, (size_t)width * (height + 1) * sizeof(Uint32));
+	}
+
+	SDL_SIMDFree(framebuffer);
+	SDL_SIMDFree(sampleRow);
+	memDestroyTexture(frameTexture);
+
+	framebuffer = NULL;
+	sampleRow = NULL;
+	frameTexture = NULL;
+	mRenderer = NULL;
+	width = 0;
+	height = 0;
+	viewWidth = 0;
+	viewHeight = 0;
+	tilesX = 0;
+	tilesY = 0;
+	cachedRotations = 0;
+}
+
+void SoftRenderer::setThreads(int threadCount)
+{
+	tiles.stop();
+
+	//calling thread draws tiles too, so it needs one less worker
+	if(threadCount > 1)
+	{
+		tiles.start(threadCount - 1);
+	}
+
+	SDL_LogMessage(SDL_LOG_CATEGORY_RENDER, SDL_LOG_PRIORITY_INFO, "Software renderer drawing with %d threads\n", getThreads());
+}
+
+bool SoftRenderer::addImage(SDL_Texture* texture, SDL_Surface* surface)
+{
+	if(texture == NULL || surface == NULL)
+	{
+		return false;
+	}
+
+	SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+	if(converted == NULL)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_RENDER, SDL_LOG_PRIORITY_ERROR, "Unable to convert image for software renderer! SDL Error: %s\n", SDL_GetError());
+		return false;
+	}
+
+	SoftImage* image = allocImage(converted->w, converted->h);
+
+	//premultiply so blending needs no divide
+	SDL_LockSurface(converted);
+	for(int y = 0; y < converted->h; y++)
+	{
+		const Uint32* row = (const Uint32*)((const Uint8*)converted->pixels + y * converted->pitch);
+
+		for(int x = 0; x < converted->w; x++)
+		{
+			Uint32 pixel = row[x];
+			Uint32 alpha = pixel >> 24;
+			Uint32 red = (((pixel >> 16) & 0xFF) * alpha + 127) / 255;
+			Uint32 green = (((pixel >> 8) & 0xFF) * alpha + 127) / 255;
+			Uint32 blue = ((pixel & 0xFF) * alpha + 127) / 255;
+
+			image->pixels[y * image->width + x] = (alpha << 24) | (red << 16) | (green << 8) | blue;
+		}
+	}
+	SDL_UnlockSurface(converted);
+	SDL_FreeSurface(converted);
+
+	//replace any image texture had before
+	SoftImage*& slot = images[texture];
+	if (slot != NULL) { freeImage(slot); }
+	slot = image;
+
+	return true;
+}
+
+void SoftRenderer::setScale(float scale)
+{
+	//recorded draws may use images resampled to old scale
+	if (scale != this->scale && !commands.empty()) { drawTiles(); }
+
+	this->scale = std::min(std::max(scale, 0.0f), 1.0f);
+	viewWidth = std::max((int)lroundf(width * this->scale), 1);
+	viewHeight = std::max((int)lroundf(height * this->scale), 1);
+}
+
+SDL_Rect SoftRenderer::scaleRect(const SDL_Rect& rect) const
+{
+	if(scale == 1)
+	{
+		return rect;
+	}
+
+	//scale both sides, so rects that touch still touch
+	int left = (int)lroundf(rect.x * scale);
+	int top = (int)lroundf(rect.y * scale);
+	return { left, top, (int)lroundf((rect.x + rect.w) * scale) - left, (int)lroundf((rect.y + rect.h) * scale) - top };
+}
+
+void SoftRenderer::clear(SDL_Color color)
+{
+	SoftCommand command = {};
+	command.color = 0xFF000000 | (color.r << 16) | (color.g << 8) | color.b;
+	command.bounds = { 0, 0, viewWidth, viewHeight };
+
+	submit(command);
+}
+
+void SoftRenderer::copy(SDL_Texture* texture, const SDL_Rect* source, const SDL_Rect* dest)
+{
+	SoftImage* image = findImage(texture);
+	if(image == NULL || dest == NULL)
+	{
+		return;
+	}
+
+	SoftCommand command = {};
+	command.image = image;
+	command.source = source != NULL ? *source : SDL_Rect{ 0, 0, image->width, image->height };
+	command.dest = scaleRect(*dest);
+	command.bounds = command.dest;
+
+	//below full size, part of resampled image that lines up with dest is still a plain copy
+	if(scale != 1)
+	{
+		SoftImage* scaled = scaledImage(*image);
+		float scaleX = (float)scaled->width / image->width;
+		float scaleY = (float)scaled->height / image->height;
+		int left = (int)lroundf(command.source.x * scaleX);
+		int top = (int)lroundf(command.source.y * scaleY);
+		SDL_Rect scaledSource = { left, top, (int)lroundf((command.source.x + command.source.w) * scaleX) - left, (int)lroundf((command.source.y + command.source.h) * scaleY) - top };
+
+		if(scaledSource.w == command.dest.w && scaledSource.h == command.dest.h)
+		{
+			command.image = scaled;
+			command.source = scaledSource;
+		}
+	}
+
+	//same size is a plain blended copy, else scale through transform
+	command.transform = command.dest.w != command.source.w || command.dest.h != command.source.h;
+
+	submit(command);
+}
+
+void SoftRenderer::copyEx(SDL_Texture* texture, const SDL_Rect* source, const SDL_Rect* destRect, double angle)
+{
+	SoftImage* image = findImage(texture);
+	if(image == NULL || destRect == NULL)
+	{
+		return;
+	}
+
+	SDL_Rect scaled = scaleRect(*destRect);
+	const SDL_Rect* dest = &scaled;
+
+	SDL_Rect sourceRect = source != NULL ? *source : SDL_Rect{ 0, 0, image->width, image->height };
+	bool wholeImage = sourceRect.x == 0 && sourceRect.y == 0 && sourceRect.w == image->width && sourceRect.h == image->height;
+	SoftCommand command = {};
+
+	//whole unscaled images use nearest cached angle, centered where dest center is. Below full size angles are cached
+	//from resampled image
+	if(rotationCache && wholeImage && destRect->w == image->width && destRect->h == image->height)
+	{
+		int step = (int)lround(angle * SOFT_ROTATION_STEPS / 360.0) % SOFT_ROTATION_STEPS;
+		if (step < 0) { step += SOFT_ROTATION_STEPS; }
+
+		//built here so tile threads only ever read images
+		SoftImage* drawn = scale != 1 ? scaledImage(*image) : image;
+		SoftImage* rotated = drawn->rotations[step];
+		if (rotated == NULL) { rotated = buildRotation(*drawn, step); }
+
+		command.image = rotated;
+		command.source = { 0, 0, rotated->width, rotated->height };
+		command.dest = { dest->x + (dest->w - rotated->width) / 2, dest->y + (dest->h - rotated->height) / 2, rotated->width, rotated->height };
+		command.bounds = command.dest;
+	}
+	else
+	{
+		float radians = (float)(angle * M_PI / 180);
+
+		command.image = image;
+		command.source = sourceRect;
+		command.dest = *dest;
+		command.angle = angle;
+		command.transform = true;
+		command.bounds = transformBounds(*dest, cosf(radians), sinf(radians));
+	}
+
+	submit(command);
+}
+
+void SoftRenderer::shade(const std::function<void(Uint32* pixels, int pitch, const SDL_Rect& clip)>& shader)
+{
+	//shader sees everything drawn so far
+	if (!commands.empty()) { drawTiles(); }
+
+	tiles.parallelFor(tilesX * tilesY, [this, &shader](int tile)
+	{
+		SDL_Rect clip = tileClip(tile);
+		if (clip.w > 0 && clip.h > 0) { shader(framebuffer, width, clip); }
+	});
+}
+
+void SoftRenderer::present()
+{
+	if (!commands.empty()) { drawTiles(); }
+
+	//only part of framebuffer in view, stretched over whole target
+	SDL_Rect view = { 0, 0, viewWidth, viewHeight };
+	SDL_UpdateTexture(frameTexture, &view, framebuffer, width * sizeof(Uint32));
+	SDL_RenderCopy(mRenderer, frameTexture, &view, NULL);
+	perfCountDraw();
+}
+
+SoftImage* SoftRenderer::findImage(SDL_Texture* texture)
+{
+	auto found = images.find(texture);
+	return found != images.end() ? found->second : NULL;
+}
+
+void SoftRenderer::submit(const SoftCommand& command)
+{
+	if(tiles.getThreadCount() > 0)
+	{
+		commands.push_back(command);
+		return;
+	}
+
+	pixelsBlended += runCommand(command, { 0, 0, viewWidth, viewHeight }, sampleRow);
+}
+
+Sint64 SoftRenderer::runCommand(const SoftCommand& command, const SDL_Rect& clip, Uint32* samples)
+{
+	if(command.image == NULL)
+	{
+		for (int row = clip.y; row < clip.y + clip.h; row++) { std::fill_n(framebuffer + row * width + clip.x, clip.w, command.color); }
+		return 0;
+	}
+
+	if (command.transform) { return transformImage(*command.image, command.source, command.dest, command.angle, clip, samples); }
+
+	return blitImage(*command.image, command.dest.x, command.dest.y, command.source, clip);
+}
+
+void SoftRenderer::drawTiles()
+{
+	for (std::vector<int>& list : tileCommands) { list.clear(); }
+
+	//add each command to every tile its box touches, keeping submission order within tiles
+	for(int i = 0; i < (int)commands.size(); i++)
+	{
+		const SDL_Rect& bounds = commands[i].bounds;
+
+		int left = std::max(bounds.x, 0) / SOFT_TILE_SIZE;
+		int top = std::max(bounds.y, 0) / SOFT_TILE_SIZE;
+		int right = std::min(bounds.x + bounds.w, viewWidth);
+		int bottom = std::min(bounds.y + bounds.h, viewHeight);
+
+		if(right <= 0 || bottom <= 0 || bounds.x >= viewWidth || bounds.y >= viewHeight)
+		{
+			continue;
+		}
+
+		right = (right - 1) / SOFT_TILE_SIZE;
+		bottom = (bottom - 1) / SOFT_TILE_SIZE;
+
+		for(int tileY = top; tileY <= bottom; tileY++)
+		{
+			for(int tileX = left; tileX <= right; tileX++)
+			{
+				std::vector<int>& list = tileCommands[tileY * tilesX + tileX];
+
+				//a clear hides everything drawn before it
+				if (commands[i].image == NULL) { list.clear(); }
+
+				list.push_back(i);
+			}
+		}
+	}
+
+	//tiles don't overlap, so threads never write the same pixel
+	tiles.parallelFor(tilesX * tilesY, [this](int tile)
+	{
+		SDL_Rect clip = tileClip(tile);
+		Uint32 samples[SOFT_TILE_SIZE];
+		Sint64 blended = 0;
+
+		for (int index : tileCommands[tile]) { blended += runCommand(commands[index], clip, samples); }
+
+		pixelsBlended += blended;
+	});
+
+	commands.clear();
+}
+
+SDL_Rect SoftRenderer::tileClip(int tile) const
+{
+	//tiles past view are empty, partial ones at its right and bottom edges
+	int tileX = (tile % tilesX) * SOFT_TILE_SIZE;
+	int tileY = (tile / tilesX) * SOFT_TILE_SIZE;
+	return { tileX, tileY, std::min(SOFT_TILE_SIZE, viewWidth - tileX), std::min(SOFT_TILE_SIZE, viewHeight - tileY) };
+}
+
+Sint64 SoftRenderer::blitImage(const SoftImage& image, int x, int y, const SDL_Rect& source, const SDL_Rect& clip)
+{
+	int left = std::max(x, clip.x);
+	int top = std::max(y, clip.y);
+	int right = std::min(x + source.w, clip.x + clip.w);
+	int bottom = std::min(y + source.h, clip.y + clip.h);
+
+	if(left >= right || top >= bottom)
+	{
+		return 0;
+	}
+
+	for(int row = top; row < bottom; row++)
+	{
+		const Uint32* sourceRow = image.pixels + (source.y + row - y) * image.width + source.x + (left - x);
+		blendSpan(framebuffer + row * width + left, sourceRow, right - left);
+	}
+
+	return (Sint64)(right - left) * (bottom - top);
+}
+
+Sint64 SoftRenderer::transformImage(const SoftImage& image, const SDL_Rect& source, const SDL_Rect& dest, double angle, const SDL_Rect& clip, Uint32* samples)
+{
+	float radians = (float)(angle * M_PI / 180);
+	float cosine = cosf(radians);
+	float sine = sinf(radians);
+	float scaleX = (float)source.w / dest.w;
+	float scaleY = (float)source.h / dest.h;
+	float centerX = dest.x + dest.w / 2.0f;
+	float centerY = dest.y + dest.h / 2.0f;
+
+	//box around rotated dest, clipped
+	SDL_Rect box = transformBounds(dest, cosine, sine);
+	int left = std::max(box.x, clip.x);
+	int top = std::max(box.y, clip.y);
+	int right = std::min(box.x + box.w, clip.x + clip.w);
+	int bottom = std::min(box.y + box.h, clip.y + clip.h);
+
+	if(left >= right || top >= bottom)
+	{
+		return 0;
+	}
+
+	for(int row = top; row < bottom; row++)
+	{
+		//undo rotation for first pixel center in row of unclipped box, then step to clipped start, so every clip samples
+		//the same positions
+		float relativeX = box.x + 0.5f - centerX;
+		float relativeY = row + 0.5f - centerY;
+		float u = source.x + (relativeX * cosine + relativeY * sine + dest.w / 2.0f) * scaleX;
+		float v = source.y + (-relativeX * sine + relativeY * cosine + dest.h / 2.0f) * scaleY;
+
+		sampleSpan(image, source, u, v, cosine * scaleX, -sine * scaleY, left - box.x, samples, right - left);
+		blendSpan(framebuffer + row * width + left, samples, right - left);
+	}
+
+	return (Sint64)(right - left) * (bottom - top);
+}
+
+SoftImage* SoftRenderer::buildRotation(SoftImage& image, int step)
+{
+	//square big enough for any angle
+	if(image.rotatedSize == 0)
+	{
+		image.rotatedSize = (int)ceilf(sqrtf((float)(image.width * image.width + image.height * image.height)));
+	}
+
+	int size = image.rotatedSize;
+	SoftImage* rotated = allocImage(size, size);
+
+	float radians = (float)(step * 2 * M_PI / SOFT_ROTATION_STEPS);
+	float cosine = cosf(radians);
+	float sine = sinf(radians);
+	SDL_Rect bounds = { 0, 0, image.width, image.height };
+
+	for(int row = 0; row < size; row++)
+	{
+		float relativeX = 0.5f - size / 2.0f;
+		float relativeY = row + 0.5f - size / 2.0f;
+		float u = relativeX * cosine + relativeY * sine + image.width / 2.0f;
+		float v = -relativeX * sine + relativeY * cosine + image.height / 2.0f;
+
+		sampleSpan(image, bounds, u, v, cosine, -sine, 0, rotated->pixels + row * size, size);
+	}
+
+	image.rotations[step] = rotated;
+	cachedRotations++;
+
+	return rotated;
+}
+
+SoftImage* SoftRenderer::scaledImage(SoftImage& image)
+{
+	if(image.scaled != NULL && image.scaledAt == scale)
+	{
+		return image.scaled;
+	}
+
+	//setScale draws recorded commands before scale changes, so none still use old copy
+	freeImage(image.scaled);
+
+	int scaledWidth = std::max((int)lroundf(image.width * scale), 1);
+	int scaledHeight = std::max((int)lroundf(image.height * scale), 1);
+	SoftImage* scaled = allocImage(scaledWidth, scaledHeight);
+
+	//average box of pixels under each one, fine since they are premultiplied
+	for(int y = 0; y < scaledHeight; y++)
+	{
+		int top = y * image.height / scaledHeight;
+		int bottom = std::max((y + 1) * image.height / scaledHeight, top + 1);
+
+		for(int x = 0; x < scaledWidth; x++)
+		{
+			int left = x * image.width / scaledWidth;
+			int right = std::max((x + 1) * image.width / scaledWidth, left + 1);
+			Uint32 sums[4] = { 0, 0, 0, 0 };
+
+			for(int row = top; row < bottom; row++)
+			{
+				for(int column = left; column < right; column++)
+				{
+					Uint32 pixel = image.pixels[row * image.width + column];
+					for (int channel = 0; channel < 4; channel++) { sums[channel] += (pixel >> (channel * 8)) & 0xFF; }
+				}
+			}
+
+			Uint32 count = (Uint32)((bottom - top) * (right - left));
+			Uint32 pixel = 0;
+			for (int channel = 0; channel < 4; channel++) { pixel |= ((sums[channel] + count / 2) / count) << (channel * 8); }
+			scaled->pixels[y * scaledWidth + x] = pixel;
+		}
+	}
+
+	image.scaled = scaled;
+	image.scaledAt = scale;
+
+	return scaled;
+}
+
+SoftImage* SoftRenderer::allocImage(int width, int height)
+{
+	SoftImage* image = new SoftImage();
+	image->width = width;
+	image->height = height;
+	image->rotatedSize = 0;
+	image->pixels = (Uint32*)SDL_SIMDAlloc((size_t)width * height * sizeof(Uint32));
+	memset(image->rotations, 0, sizeof(image->rotations));
+	image->scaled = NULL;
+	image->scaledAt = 0;
+
+	memTrackAlloc(MEM_SOFTRENDER, (size_t)width * height * sizeof(Uint32));
+
+	return image;
+}
+
+void SoftRenderer::freeImage(SoftImage* image)
+{
+	if(image == NULL)
+	{
+		return;
+	}
+
+	for (SoftImage* rotated : image->rotations) { freeImage(rotated); }
+	freeImage(image->scaled);
+
+	memTrackFree(MEM_SOFTRENDER, (size_t)image->width * image->height * sizeof(Uint32));
+	SDL_SIMDFree(image->pixels);
+	delete image;
+}
@@ -0,0 +1,195 @@
+/*
+Title:	SoftRenderer.h
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: header file for SoftRenderer class for my game engine. A CPU renderer for hosts without a GPU that draws rotated,
+	alpha blended sprites into an ARGB framebuffer with SSE2 or AVX2 blitters, then hands the whole frame to SDL in one copy.
+	Images are kept premultiplied so blending is one multiply per channel. Rotations can be cached at quantized angles so
+	most rotated sprites become plain blended copies.
+
+	With threads started, draws are recorded instead of done at once. present() bins them into SOFT_TILE_SIZE screen tiles,
+	then tiles are drawn in parallel, each one running its commands in the order they were made and clipped to the tile.
+ */
+
+#pragma once
+#ifndef SOFTRENDERER_H
+#define SOFTRENDERER_H
+
+#include <SDL.h>
+#include <unordered_map>
+#include <vector>
+#include <atomic>
+#include <functional>
+#include "ThreadPool.h"
+
+//use SIMD when building for x86
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SOFT_LANES 8
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SOFT_LANES 4
+#else
+#define SOFT_LANES 1
+#endif
+
+//soft renderer constants
+const int SOFT_ROTATION_STEPS = 128;	//cached angles per full turn, about 2.8 degrees apart
+const int SOFT_TILE_SIZE = 64;			//screen tile drawn by one thread at a time
+
+//premultiplied ARGB image
+struct SoftImage
+{
+	Uint32* pixels;
+	int width;
+	int height;
+
+	//images rotated to each cached angle, built on first use. Each is a square of rotatedSize
+	SoftImage* rotations[SOFT_ROTATION_STEPS];
+	int rotatedSize;
+
+	//copy resampled to scale it was last drawn at below full size, with its own rotations. Built on first use
+	SoftImage* scaled;
+	float scaledAt;
+};
+
+//draw recorded for a threaded frame
+struct SoftCommand
+{
+	const SoftImage* image;		//NULL to clear to color
+	SDL_Rect source;
+	SDL_Rect dest;				//only x and y are used by plain blits
+	double angle;
+	bool transform;				//false for plain blended copy
+	Uint32 color;
+	SDL_Rect bounds;			//screen box command can touch
+};
+
+class SoftRenderer
+{
+public:
+	//initialize variables
+	SoftRenderer();
+
+	//destructor
+	~SoftRenderer();
+
+	//allocate framebuffer and texture it is shown through
+	bool init(SDL_Renderer* renderer, int width, int height);
+
+	//deallocates resources
+	void free();
+
+	//keep pixels of surface to draw in place of texture. Surface is copied, caller still owns it
+	bool addImage(SDL_Texture* texture, SDL_Surface* surface);
+
+	//draw with threadCount threads, including the calling one. 1 or less draws immediately on the calling thread
+	void setThreads(int threadCount);
+
+	//turn rotation cache on or off
+	void setRotationCache(bool enabled) { rotationCache = enabled; }
+
+	//draw into top left scale of framebuffer, stretched over renderer when presented. Positions and sizes given to draws
+	//stay in full size coordinates. Set before drawing a frame
+	void setScale(float scale);
+
+	//fill framebuffer with color
+	void clear(SDL_Color color);
+
+	//blend part of texture's image into framebuffer, NULL source is whole image
+	void copy(SDL_Texture* texture, const SDL_Rect* source, const SDL_Rect* dest);
+
+	//blend image rotated clockwise by angle in degrees about dest center
+	void copyEx(SDL_Texture* texture, const SDL_Rect* source, const SDL_Rect* dest, double angle);
+
+	//run shader over each screen tile in parallel once recorded commands are drawn. Shader is given framebuffer and its
+	//pitch in pixels, and may only change pixels within clip
+	void shade(const std::function<void(Uint32* pixels, int pitch, const SDL_Rect& clip)>& shader);
+
+	//draw recorded commands, then upload framebuffer and copy it to renderer
+	void present();
+
+	//getters
+	bool isActive() const { return framebuffer != NULL; }
+	const Uint32* getPixels() const { return framebuffer; }		//get framebuffer, width pixels per row
+	int getWidth() const { return width; }
+	int getHeight() const { return height; }
+	float getScale() const { return scale; }
+	int getViewWidth() const { return viewWidth; }		//get width of framebuffer drawn at current scale
+	int getViewHeight() const { return viewHeight; }
+	Sint64 getPixelsBlended() const { return pixelsBlended; }	//get pixels blended since init
+	int getCachedRotations() const { return cachedRotations; }
+	int getThreads() const { return tiles.getThreadCount() + 1; }	//get threads drawing tiles
+
+private:
+	//find image for texture, NULL if none was added
+	SoftImage* findImage(SDL_Texture* texture);
+
+	//record command, or run it now when not threaded
+	void submit(const SoftCommand& command);
+
+	//run command clipped to clip, using samples as a row buffer at least clip width long. Returns pixels blended
+	Sint64 runCommand(const SoftCommand& command, const SDL_Rect& clip, Uint32* samples);
+
+	//blend image at position, clipped to clip
+	Sint64 blitImage(const SoftImage& image, int x, int y, const SDL_Rect& source, const SDL_Rect& clip);
+
+	//blend image through an inverse transform, covering box of rotated dest within clip
+	Sint64 transformImage(const SoftImage& image, const SDL_Rect& source, const SDL_Rect& dest, double angle, const SDL_Rect& clip, Uint32* samples);
+
+	//bin recorded commands into tiles and draw tiles in parallel
+	void drawTiles();
+
+	//get part of view in tile, empty past view
+	SDL_Rect tileClip(int tile) const;
+
+	//map rect from full size to view coordinates
+	SDL_Rect scaleRect(const SDL_Rect& rect) const;
+
+	//build image rotated to cached angle step
+	SoftImage* buildRotation(SoftImage& image, int step);
+
+	//get copy of image resampled to current scale, rebuilt when scale has changed
+	SoftImage* scaledImage(SoftImage& image);
+
+	//allocate and free images and pixel buffers, tracked
+	SoftImage* allocImage(int width, int height);
+	void freeImage(SoftImage* image);
+
+	//renderer and texture framebuffer is shown through
+	SDL_Renderer* mRenderer;
+	SDL_Texture* frameTexture;
+
+	//framebuffer, opaque ARGB
+	Uint32* framebuffer;
+	int width;
+	int height;
+
+	//scale drawn at, and part of framebuffer it covers
+	float scale;
+	int viewWidth;
+	int viewHeight;
+
+	//row of transformed samples, reused
+	Uint32* sampleRow;
+
+	//images by texture they stand in for
+	std::unordered_map<SDL_Texture*, SoftImage*> images;
+
+	//flag to use rotation cache
+	bool rotationCache;
+
+	//threads drawing tiles, none when drawing immediately
+	ThreadPool tiles;
+
+	//commands recorded this frame, and indices of those touching each tile in order
+	std::vector<SoftCommand> commands;
+	std::vector<std::vector<int>> tileCommands;
+	int tilesX;
+	int tilesY;
+
+	//stats
+	std::atomic<Sint64> pixelsBlended;
+	int cachedRotations;
+};
+#endif
@@ -6,6 +6,7 @@ Purpose: implementation file for Sprite class for my game engine
  */
 
 #include "Sprite.h"
+#include "PerfOverlay.h"
 #include <cstdio>
 
 //sprite constants
@@ -16,8 +17,8 @@ const int ENEMY_HEALTH = 1;
 const int RELOAD_TIME = 8;
 const int PROJECTILE_WIDTH = 7;
 const int PROJECTILE_HEIGHT = 3;
-const float MUZZLE_LENGTH = 54;
-const float MUZZLEY_OFFSET = 16;
+const int MUZZLE_LENGTH = 54;
+const int MUZZLEY_OFFSET = 16;
 
 Sprite::Sprite()
 {
@@ -35,15 +36,20 @@ Sprite::Sprite()
 	dX = NULL;
 	dY = NULL;
 
-	imgAngle = NULL;
+	heading = 0;
+	drawHeading = 0;
 
 	player = false;
+	projectile = false;
 
 	health = 0;
 
-	reloading = 0;
+	reloadTimer = NULL_HANDLE;
 
-	next = NULL;
+	input = {};
+
+	id = 0;
+	handle = NULL_HANDLE;
 
 	spriteTexture = NULL;
 }
@@ -68,13 +74,21 @@ Sprite::Sprite(Scene* scene, bool player, SpriteType spriteType, SDL_Texture* te
 	dY = 0;
 
 	//set image angle
-	imgAngle = 0;
+	heading = 0;
+	drawHeading = 0;
 
 	//set player flag
 	this->player = player;
 
-	//set reloading variable to 0
-	reloading = 0;
+	//ready to fire
+	reloadTimer = NULL_HANDLE;
+
+	//no input until scene or network sets it
+	input = {};
+
+	//id and handle are assigned when sprite is added to scene
+	id = 0;
+	handle = NULL_HANDLE;
 
 	//set health to appropriate amount
 	if (isPlayer()) { health = PLAYER_HEALTH; }
@@ -84,13 +98,7 @@ Sprite::Sprite(Scene* scene, bool player, SpriteType spriteType, SDL_Texture* te
 	//load sprite image to texture. If no texture passed and default is used, it will print a warning to console
 	setTexture(texture);
 
-	if (spriteType == PROJECTILE) { projectile = true; }
-
-	//initialize pointer to sprite next in list
-	next = NULL;
-
-	//add sprite to appropriate list
-	spriteScene->addSprite(this, spriteType);
+	projectile = spriteType == PROJECTILE;
 }
 
 Sprite::~Sprite()
@@ -128,7 +136,8 @@ void Sprite::free()
 	width = NULL;
 	height = NULL;
 
-	imgAngle = NULL;
+	heading = 0;
+	drawHeading = 0;
 
 	dX = NULL;
 	dY = NULL;
@@ -137,9 +146,7 @@ void Sprite::free()
 
 	health = NULL;;
 
-	reloading = NULL;
-
-	next = NULL;
+	reloadTimer = NULL_HANDLE;
 }
 
 void Sprite::setTexture(SDL_Texture* texture)
@@ -163,8 +170,17 @@ void Sprite::draw()
 	//create rect from image dimensions
 	SDL_Rect textureRect = { x, y, width, height };
 
-	//render to screen
-	SDL_RenderCopyEx(spriteRenderer, spriteTexture, NULL, &textureRect, imgAngle, NULL, SDL_FLIP_NONE);
+	//render to CPU framebuffer if scene uses one, else to screen
+	SoftRenderer* softRenderer = spriteScene->getSoftRenderer();
+	if(softRenderer != NULL)
+	{
+		softRenderer->copyEx(spriteTexture, NULL, &textureRect, fixedAngleToDegrees(drawHeading));
+	}
+	else
+	{
+		SDL_RenderCopyEx(spriteRenderer, spriteTexture, NULL, &textureRect, fixedAngleToDegrees(drawHeading), NULL, SDL_FLIP_NONE);
+		perfCountDraw();
+	}
 }
 
 void Sprite::setPos(int x, int y)
@@ -183,27 +199,29 @@ void Sprite::fireProjectile()
 	if(isPlayer())
 	{
 		//fire speed limit
-		auto* projectile = new Sprite(spriteScene, false, PROJECTILE, spriteScene->getPlayerProjectile());
+		Sprite* projectile = spriteScene->addSprite(false, PROJECTILE, spriteScene->getPlayerProjectile());
 
 		//calculate muzzle position for projectile origin
-		float muzzleX = center.x - (MUZZLEY_OFFSET * sin(getImgAngle())) + (MUZZLE_LENGTH * cos(getImgAngle()));
-		float muzzleY = center.y + (MUZZLEY_OFFSET * cos(getImgAngle())) + (MUZZLE_LENGTH * sin(getImgAngle()));
+		Fixed cosine = fixedCos(heading);
+		Fixed sine = fixedSin(heading);
+		Fixed muzzleX = fixedFromInt(center.x) - MUZZLEY_OFFSET * sine + MUZZLE_LENGTH * cosine;
+		Fixed muzzleY = fixedFromInt(center.y) + MUZZLEY_OFFSET * cosine + MUZZLE_LENGTH * sine;
 
 		//set projectile position to originate at player center
-		projectile->setPos(muzzleX, muzzleY);
+		projectile->setPos(fixedTrunc(muzzleX), fixedTrunc(muzzleY));
 
 		//make projectile face same direction as player image
-		projectile->imgAngle = this->imgAngle;
+		projectile->heading = this->heading;
+		projectile->drawHeading = this->heading;
 
-		//set muzzle rect and render muzzle flash
-		SDL_Rect muzzleTextureRect = { static_cast<int>(muzzleX - (6 * abs(sin(getImgAngle())))), static_cast<int>(muzzleY - (5 * abs(cos(getImgAngle())))), 10, 6 };
-		SDL_RenderCopyEx(spriteRenderer, spriteScene->getMuzzleFlash(),NULL, &muzzleTextureRect, imgAngle, NULL, SDL_FLIP_NONE);
+		//spawn muzzle flash, drawn with the rest of the scene
+		spriteScene->emitMuzzleFlash(fixedToFloat(muzzleX), fixedToFloat(muzzleY), getImgAngle());
 
 		//calculate dx and dy from image angle (direction facing)
 		projectile->calcVector(PROJECTILE_SPEED);
 
-		//set reloading time so can't fire for certain amount of frames
-		reloading = RELOAD_TIME;
+		//can't fire again until reload timer fires
+		reloadTimer = spriteScene->getTimers().schedule(RELOAD_TIME);
 	}
 }
 
@@ -212,12 +230,9 @@ void Sprite::doPlayer()
 	//set center
 	calcCenter();
 
-	//calculate rotation for sprite and save in imgAngle
+	//calculate rotation for sprite and save in heading
 	calcImgAngle(center);
 
-	//pointer to keyboard array
-	int* keyboardInput = spriteScene->getKeyboard();
-
 	//check if sprite is player
 	if (isPlayer())
 	{
@@ -225,25 +240,20 @@ void Sprite::doPlayer()
 		dX = 0;
 		dY = 0;
 
-		//decrements reloading like a timer
-		if(reloading > 0)
-		{
-			reloading--;
-		}
-		if (keyboardInput[SDL_SCANCODE_W] || keyboardInput[SDL_SCANCODE_UP])
+		if (input.keys & INPUT_UP)
 		{
 			//negate player speed since Y = 0 is top of window
 			dY = -(PLAYER_SPEED);
 		}
-		if(keyboardInput[SDL_SCANCODE_S] || keyboardInput[SDL_SCANCODE_DOWN])
+		if(input.keys & INPUT_DOWN)
 		{
 			dY = PLAYER_SPEED;
 		}
-		if(keyboardInput[SDL_SCANCODE_A] || keyboardInput[SDL_SCANCODE_LEFT])
+		if(input.keys & INPUT_LEFT)
 		{
 			dX = -(PLAYER_SPEED);
 		}
-		if(keyboardInput[SDL_SCANCODE_D] || keyboardInput[SDL_SCANCODE_RIGHT])
+		if(input.keys & INPUT_RIGHT)
 		{
 			dX = PLAYER_SPEED;
 		}
@@ -252,7 +262,7 @@ void Sprite::doPlayer()
 		x += dX;
 		y += dY;
 
-		if(spriteScene->getMouseLeft() && reloading == 0)
+		if(input.fire && !spriteScene->getTimers().isPending(reloadTimer))
 		{
 			fireProjectile();
 		}
@@ -269,10 +279,10 @@ void Sprite::moveSprite()
 	calcCenter();
 }
 
-void Sprite::moveEnemy(float speed)
+void Sprite::moveEnemy(int speed)
 {
-	//find player
-	calcImgAngle(center, spriteScene->getPlayerPos());
+	//face next step toward nearest player from shared flow field
+	calcImgAngle(center, spriteScene->getFlowTarget(center));
 
 	//calculate vector to player
 	calcVector(speed);
@@ -281,6 +291,11 @@ void Sprite::moveEnemy(float speed)
 	moveSprite();
 }
 
+void Sprite::aimAt(SDL_Point aim)
+{
+	drawHeading = fixedAtan2(aim.y - center.y, aim.x - center.x);
+}
+
 void Sprite::calcImgAngle(SDL_Point origSpriteCenter, SDL_Point destSpriteCenter )
 {
 	//variables to hold components
@@ -290,9 +305,9 @@ void Sprite::calcImgAngle(SDL_Point origSpriteCenter, SDL_Point destSpriteCenter
 	//we only want to change angle if is the player object
 	if(isPlayer())
 	{
-		//variables for x and y components
-		xComponent = spriteScene->getMousePos().x - origSpriteCenter.x;
-		yComponent = spriteScene->getMousePos().y - origSpriteCenter.y;
+		//variables for x and y components, aiming at input aim point
+		xComponent = input.aimX - origSpriteCenter.x;
+		yComponent = input.aimY - origSpriteCenter.y;
 	}
 	else
 	{
@@ -300,7 +315,8 @@ void Sprite::calcImgAngle(SDL_Point origSpriteCenter, SDL_Point destSpriteCenter
 		yComponent = destSpriteCenter.y - origSpriteCenter.y;
 	}
 
-	imgAngle = atan2(yComponent, xComponent) * 180 / M_PI;
+	heading = fixedAtan2(yComponent, xComponent);
+	drawHeading = heading;
 }
 
 void Sprite::setHealth(int newHealth)
@@ -308,6 +324,49 @@ void Sprite::setHealth(int newHealth)
 	health = newHealth;
 }
 
+Uint32 Sprite::getReloadTicks() const
+{
+	return spriteScene != NULL ? spriteScene->getTimers().remaining(reloadTimer) : 0;
+}
+
+SpriteState Sprite::getState() const
+{
+	SpriteState state = {};
+
+	state.x = x;
+	state.y = y;
+	state.dX = dX;
+	state.dY = dY;
+	state.health = health;
+	state.reloading = spriteScene != NULL ? (Sint32)spriteScene->getTimers().remaining(reloadTimer) : 0;
+	state.player = player;
+	state.projectile = projectile;
+	state.id = id;
+	state.heading = heading;
+
+	return state;
+}
+
+void Sprite::setState(const SpriteState& state)
+{
+	x = state.x;
+	y = state.y;
+	dX = state.dX;
+	dY = state.dY;
+	health = state.health;
+	//reload carries on from where it was
+	if (spriteScene != NULL) { spriteScene->getTimers().cancel(reloadTimer); }
+	reloadTimer = spriteScene != NULL && state.reloading > 0 ? spriteScene->getTimers().schedule(state.reloading) : NULL_HANDLE;
+	player = state.player != 0;
+	projectile = state.projectile != 0;
+	id = state.id;
+	heading = state.heading;
+	drawHeading = heading;
+
+	//center follows position
+	calcCenter();
+}
+
 void Sprite::calcCenter()
 {
 	center = { x + (width / 2), y + (height / 2) };
@@ -315,6 +374,7 @@ void Sprite::calcCenter()
 
 void Sprite::calcVector(int speed)
 {
-	dX = speed * cos(imgAngle * M_PI / 180);
-	dY = speed * sin(imgAngle * M_PI / 180);
+	//whole pixels toward 0, same as truncating float result
+	dX = fixedTrunc(speed * fixedCos(heading));
+	dY = fixedTrunc(speed * fixedSin(heading));
 }
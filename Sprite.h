@@ -11,7 +11,8 @@ Purpose: header file for Sprite class for my game engine. REQUIRES SCENE CLASS
 
 #include <SDL.h>
 #include <SDL_image.h>
-#include "Scene.h"
+#include "SlotMap.h"
+#include "FixedMath.h"
 
  //sprite type enumerations
  //entity and projectiles are all that is included now, 
@@ -20,6 +21,36 @@ enum SpriteType
 	ENTITY, PROJECTILE
 };
 
+//player input key bits
+const Uint8 INPUT_UP = 1;
+const Uint8 INPUT_DOWN = 2;
+const Uint8 INPUT_LEFT = 4;
+const Uint8 INPUT_RIGHT = 8;
+
+//one tick of input for a player sprite, from local keyboard/mouse or from the network
+struct PlayerInput
+{
+	Uint8 keys;		//INPUT_ bits held
+	Uint8 fire;		//fire button held
+	Sint16 aimX;	//aim point in screen coordinates
+	Sint16 aimY;
+};
+
+//plain copy of a sprite's simulation state for snapshots
+struct SpriteState
+{
+	Sint32 x;
+	Sint32 y;
+	Sint32 dX;
+	Sint32 dY;
+	Sint32 health;
+	Sint32 reloading;
+	Uint32 id;
+	FixedAngle heading;
+	Uint8 player;
+	Uint8 projectile;
+};
+
 //forward declaration
 class Scene;
 
@@ -29,7 +60,7 @@ public:
 	//default constructor
 	Sprite();
 
-	//constructor
+	//constructor, use Scene::addSprite to make sprites that are part of scene
 	Sprite(Scene* scene, bool player = false, SpriteType type = ENTITY, SDL_Texture* texture = NULL);
 
 	//destructor
@@ -57,24 +88,43 @@ public:
 	void moveSprite();
 
 	//handler for enemies
-	void moveEnemy(float speed);
+	void moveEnemy(int speed);
 
 	//calculate image angle
 	void calcImgAngle(SDL_Point origSpriteCenter, SDL_Point destSpriteCenter = { NULL, NULL });
 
-	//pointer variable for use with sprite lists
-	Sprite* next;
-
 	//sets health
 	void setHealth(int newHealth);
 
+	//sets input used by doPlayer
+	void setInput(const PlayerInput& newInput) { input = newInput; }
+
+	//turn drawn image to face screen position, leaving simulated input and heading alone
+	void aimAt(SDL_Point aim);
+
+	//sets id and handle, assigned by scene when sprite is added
+	void setId(Uint32 newId) { id = newId; }
+	void setHandle(SlotHandle newHandle) { handle = newHandle; }
+
+	//copy simulation state out of or into sprite
+	SpriteState getState() const;
+	void setState(const SpriteState& state);
+
 	//getters
 	int getHealth() const { return health; }
+	Uint32 getId() const { return id; }
+	SlotHandle getHandle() const { return handle; }	//get handle to sprite in scene's entities or projectiles
+	const PlayerInput& getInput() const { return input; }
 	int getWidth() const { return width; }
 	int getHeight() const { return height; }
 	SDL_Point getCenter() const { return center; }
 	bool isPlayer() const { return player; }
-	double getImgAngle() const { return imgAngle * M_PI / 180; }
+	bool isProjectile() const { return projectile; }
+	SDL_Texture* getTexture() const { return spriteTexture; }
+	double getImgAngle() const { return fixedAngleToRadians(heading); }	//get heading in radians
+	double getDrawAngle() const { return fixedAngleToRadians(drawHeading); }	//get angle image is drawn at in radians
+	FixedAngle getHeading() const { return heading; }
+	Uint32 getReloadTicks() const;		//get ticks until sprite can fire again, 0 if it can now
 	int getX() const { return x; }
 	int getY() const { return y; }
 
@@ -100,8 +150,11 @@ private:
 	int width;
 	int height;
 
-	//angle to display image
-	double imgAngle;
+	//direction sprite faces and moves
+	FixedAngle heading;
+
+	//angle image is drawn at. Follows heading, but aimAt can turn it ahead of simulation
+	FixedAngle drawHeading;
 
 	//calculate dx and dy from image angle
 	void calcVector(int speed);
@@ -117,7 +170,19 @@ private:
 	//health variable to tell if sprite is alive
 	int health;
 
-	//variable to ensure shooting projectile is not called every frame
-	int reloading;
+	//pending while reloading after a shot. Left to expire if sprite is removed, it has nothing to call
+	SlotHandle reloadTimer;
+
+	//input for player sprites
+	PlayerInput input;
+
+	//unique id within scene
+	Uint32 id;
+
+	//where sprite is in scene
+	SlotHandle handle;
 };
+
+//scene is included after sprite so it can keep sprites by value
+#include "Scene.h"
 #endif
@@ -0,0 +1,149 @@
+/*
+Title:	ThreadPool.cpp
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: implementation file for ThreadPool class for my game engine
+ */
+
+#include "ThreadPool.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool()
+{
+	//initialize variables
+	stopping = false;
+}
+
+ThreadPool::~ThreadPool()
+{
+	stop();
+}
+
+void ThreadPool::start(int threadCount)
+{
+	//don't start twice
+	if(!workers.empty())
+	{
+		return;
+	}
+
+	//default to one less than core count so main thread keeps a core
+	if(threadCount <= 0)
+	{
+		threadCount = (int)std::thread::hardware_concurrency() - 1;
+		if (threadCount < 1) { threadCount = 1; }
+	}
+
+	stopping = false;
+
+	for(int i = 0; i < threadCount; i++)
+	{
+		workers.emplace_back(&ThreadPool::workerLoop, this);
+	}
+}
+
+void ThreadPool::stop()
+{
+	//flag workers to exit once queue is empty
+	{
+		std::lock_guard<std::mutex> lock(taskMutex);
+		stopping = true;
+	}
+	taskReady.notify_all();
+
+	//wait for each worker to finish
+	for(std::thread& worker : workers)
+	{
+		if(worker.joinable())
+		{
+			worker.join();
+		}
+	}
+
+	workers.clear();
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+	//if no workers are running, run task on calling thread
+	if(workers.empty())
+	{
+		task();
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(taskMutex);
+		tasks.push_back(std::move(task));
+	}
+
+	//wake one worker for the new task
+	taskReady.notify_one();
+}
+
+void ThreadPool::parallelFor(int count, const std::function<void(int)>& body)
+{
+	//nothing to share work with
+	if(workers.empty() || count <= 1)
+	{
+		for (int i = 0; i < count; i++) { body(i); }
+		return;
+	}
+
+	std::atomic<int> next(0);
+	int helpers = std::min((int)workers.size(), count - 1);
+	int helpersDone = 0;
+	std::mutex doneMutex;
+	std::condition_variable allDone;
+
+	//each runner takes indices until none are left
+	auto runner = [&]
+	{
+		for (int i = next.fetch_add(1); i < count; i = next.fetch_add(1)) { body(i); }
+	};
+
+	for(int i = 0; i < helpers; i++)
+	{
+		submit([&]
+		{
+			runner();
+
+			std::lock_guard<std::mutex> lock(doneMutex);
+			if (++helpersDone == helpers) { allDone.notify_one(); }
+		});
+	}
+
+	//calling thread works too instead of waiting idle
+	runner();
+
+	//helpers use this stack frame, so wait for every one to finish even if it found no work
+	std::unique_lock<std::mutex> lock(doneMutex);
+	allDone.wait(lock, [&] { return helpersDone == helpers; });
+}
+
+void ThreadPool::workerLoop()
+{
+	while(true)
+	{
+		std::function<void()> task;
+
+		{
+			std::unique_lock<std::mutex> lock(taskMutex);
+
+			//sleep until there is work or pool is stopping
+			taskReady.wait(lock, [this] { return stopping || !tasks.empty(); });
+
+			//exit only after queue has drained
+			if(stopping && tasks.empty())
+			{
+				return;
+			}
+
+			task = std::move(tasks.front());
+			tasks.pop_front();
+		}
+
+		//run task outside of lock
+		task();
+	}
+}
@@ -0,0 +1,63 @@
+/*
+Title:	ThreadPool.h
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: header file for ThreadPool class for my game engine. Runs background tasks (chunk loading etc.) on a fixed set of worker threads
+ */
+
+#pragma once
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <functional>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+class ThreadPool
+{
+public:
+	//initialize variables
+	ThreadPool();
+
+	//destructor
+	~ThreadPool();
+
+	//start worker threads. A count of 0 uses one less than the number of cores
+	void start(int threadCount = 0);
+
+	//finish queued tasks and join worker threads
+	void stop();
+
+	//queue task to be run on a worker thread
+	void submit(std::function<void()> task);
+
+	//run body for every index from 0 to count - 1 across workers and calling thread, returning once all are done
+	void parallelFor(int count, const std::function<void(int)>& body);
+
+	//getters
+	int getThreadCount() const { return (int)workers.size(); }	//get number of worker threads
+
+private:
+	//loop each worker thread runs until stopped
+	void workerLoop();
+
+	//worker threads
+	std::vector<std::thread> workers;
+
+	//tasks waiting for a worker
+	std::deque<std::function<void()>> tasks;
+
+	//guards task queue and stopping flag
+	std::mutex taskMutex;
+
+	//wakes workers when a task is queued or pool is stopping
+	std::condition_variable taskReady;
+
+	//flag for workers to exit
+	bool stopping;
+};
+#endif
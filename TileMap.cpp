@@ -0,0 +1,623 @@
+/*
+Title:	TileMap.cpp
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: implementation file for TileMap class for my game engine
+ */
+
+#include "TileMap.h"
+#include "MemTrack.h"
+#include "PerfOverlay.h"
+#include "FrameArena.h"
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+
+//read little endian values from a byte buffer
+static Uint16 readU16(const Uint8* bytes)
+{
+	return (Uint16)(bytes[0] | (bytes[1] << 8));
+}
+
+static Uint32 readU32(const Uint8* bytes)
+{
+	return (Uint32)bytes[0] | ((Uint32)bytes[1] << 8) | ((Uint32)bytes[2] << 16) | ((Uint32)bytes[3] << 24);
+}
+
+//write little endian values to a file
+static void writeU16(std::ofstream& file, Uint16 value)
+{
+	char bytes[2] = { (char)(value & 0xFF), (char)(value >> 8) };
+	file.write(bytes, 2);
+}
+
+static void writeU32(std::ofstream& file, Uint32 value)
+{
+	char bytes[4] = { (char)(value & 0xFF), (char)((value >> 8) & 0xFF), (char)((value >> 16) & 0xFF), (char)(value >> 24) };
+	file.write(bytes, 4);
+}
+
+//divide rounding toward negative infinity, so pixels left of or above the map land in negative chunks
+static int floorDivide(int value, int divisor)
+{
+	return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+TileMap::TileMap()
+{
+	//initialize variables
+	mRenderer = NULL;
+	tilesetTexture = NULL;
+	tileSize = 0;
+	chunkTiles = 0;
+	widthChunks = 0;
+	heightChunks = 0;
+	tilesetColumns = 0;
+	memset(solidTiles, 0, sizeof(solidTiles));
+	fileSize = 0;
+	loaded = false;
+	pendingChunks = 0;
+	frame = 0;
+	revision = 0;
+}
+
+TileMap::~TileMap()
+{
+	free();
+}
+
+bool TileMap::load(SDL_Renderer* renderer, std::string mapPath, SDL_Texture* tileset)
+{
+	//clear any previous map
+	free();
+
+	//open map file
+	std::ifstream file(mapPath, std::ios::binary);
+	if(!file)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_WARN, "Unable to open tile map %s\n", mapPath.c_str());
+		return false;
+	}
+
+	//read and check header
+	Uint8 header[TILEMAP_HEADER_SIZE];
+	file.read((char*)header, TILEMAP_HEADER_SIZE);
+	if(!file || memcmp(header, "TMAP", 4) != 0 || readU16(header + 4) != TILEMAP_VERSION)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Tile map %s has an invalid header\n", mapPath.c_str());
+		return false;
+	}
+
+	tileSize = readU16(header + 6);
+	chunkTiles = readU16(header + 8);
+	widthChunks = readU16(header + 10);
+	heightChunks = readU16(header + 12);
+	tilesetColumns = readU16(header + 14);
+	memcpy(solidTiles, header + 16, TILEMAP_SOLID_BYTES);
+
+	if(tileSize == 0 || chunkTiles == 0 || tilesetColumns == 0)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Tile map %s has invalid dimensions\n", mapPath.c_str());
+		return false;
+	}
+
+	//remember file length so loaders can check chunk offsets against it
+	file.seekg(0, std::ios::end);
+	fileSize = (Sint64)file.tellg();
+
+	mRenderer = renderer;
+	tilesetTexture = tileset;
+	path = mapPath;
+	loaded = true;
+
+	//start background loaders
+	loaders.start(CHUNK_LOADER_THREADS);
+
+	return true;
+}
+
+void TileMap::free()
+{
+	//wait for loaders so none write into freed map
+	loaders.stop();
+
+	//destroy chunk textures and tiles
+	for(auto& entry : chunks)
+	{
+		memDestroyTexture(entry.second.texture);
+
+		if(entry.second.state != CHUNK_LOADING)
+		{
+			memTrackFree(MEM_TILEMAP, entry.second.tiles.size());
+		}
+	}
+	chunks.clear();
+	revision++;
+
+	for(SDL_Texture* texture : texturePool)
+	{
+		memDestroyTexture(texture);
+	}
+	texturePool.clear();
+
+	decoded.clear();
+	pendingChunks = 0;
+
+	mRenderer = NULL;
+	tilesetTexture = NULL;
+	loaded = false;
+}
+
+void TileMap::update(SDL_Point focus, SDL_Rect view)
+{
+	if(!loaded)
+	{
+		return;
+	}
+
+	frame++;
+
+	int chunkPixels = getChunkPixels();
+
+	//chunk range covering view and stream radius around focus, rounded down so ranges left of or above the map stay off it
+	int loadLeft = floorDivide(std::min(view.x, focus.x - CHUNK_STREAM_RADIUS * chunkPixels), chunkPixels);
+	int loadTop = floorDivide(std::min(view.y, focus.y - CHUNK_STREAM_RADIUS * chunkPixels), chunkPixels);
+	int loadRight = floorDivide(std::max(view.x + view.w, focus.x + CHUNK_STREAM_RADIUS * chunkPixels), chunkPixels);
+	int loadBottom = floorDivide(std::max(view.y + view.h, focus.y + CHUNK_STREAM_RADIUS * chunkPixels), chunkPixels);
+
+	//one extra ring is kept but not loaded to avoid thrashing at the edge. Both ranges are clamped to map on their own
+	int keepLeft = std::max(loadLeft - 1, 0);
+	int keepTop = std::max(loadTop - 1, 0);
+	int keepRight = std::min(loadRight + 1, widthChunks - 1);
+	int keepBottom = std::min(loadBottom + 1, heightChunks - 1);
+
+	loadLeft = std::max(loadLeft, 0);
+	loadTop = std::max(loadTop, 0);
+	loadRight = std::min(loadRight, widthChunks - 1);
+	loadBottom = std::min(loadBottom, heightChunks - 1);
+
+	//chunks that should be loaded, sorted nearest first
+	FrameVector<std::pair<int, int>> wanted;
+
+	for(int chunkY = keepTop; chunkY <= keepBottom; chunkY++)
+	{
+		for(int chunkX = keepLeft; chunkX <= keepRight; chunkX++)
+		{
+			int index = chunkY * widthChunks + chunkX;
+
+			//distance from focus to chunk center in pixels
+			int dx = chunkX * chunkPixels + chunkPixels / 2 - focus.x;
+			int dy = chunkY * chunkPixels + chunkPixels / 2 - focus.y;
+			int distance = dx * dx + dy * dy;
+
+			auto found = chunks.find(index);
+			if(found != chunks.end())
+			{
+				//keep loaded chunk alive
+				found->second.lastUsed = frame;
+			}
+			//outer ring is only kept, not loaded
+			else if(chunkX >= loadLeft && chunkX <= loadRight && chunkY >= loadTop && chunkY <= loadBottom)
+			{
+				wanted.push_back({ distance, index });
+			}
+		}
+	}
+
+	std::sort(wanted.begin(), wanted.end());
+
+	//queue nearest missing chunks on loader threads
+	for(auto& want : wanted)
+	{
+		if(pendingChunks >= MAX_PENDING_CHUNKS || (int)chunks.size() >= MAX_RESIDENT_CHUNKS)
+		{
+			break;
+		}
+
+		int index = want.second;
+
+		TileChunk& chunk = chunks[index];
+		chunk.state = CHUNK_LOADING;
+		chunk.texture = NULL;
+		chunk.lastUsed = frame;
+
+		pendingChunks++;
+		loaders.submit([this, index] { decodeChunk(index); });
+	}
+
+	//collect chunks loader threads have finished
+	collectDecoded();
+
+	//upload a few decoded chunks each frame so texture creation never stalls a frame
+	int uploads = 0;
+	for(auto& entry : chunks)
+	{
+		if(uploads >= CHUNK_UPLOADS_PER_FRAME)
+		{
+			break;
+		}
+
+		if(entry.second.state == CHUNK_DECODED)
+		{
+			uploadChunk(entry.second);
+			uploads++;
+		}
+	}
+
+	//evict chunks that fell out of keep range. Loading chunks stay until their decode returns
+	FrameVector<int> evict;
+	for(auto& entry : chunks)
+	{
+		if(entry.second.lastUsed != frame && entry.second.state != CHUNK_LOADING)
+		{
+			evict.push_back(entry.first);
+		}
+	}
+
+	for(int index : evict)
+	{
+		evictChunk(index);
+	}
+}
+
+void TileMap::draw(SDL_Rect view)
+{
+	if(!loaded)
+	{
+		return;
+	}
+
+	int chunkPixels = getChunkPixels();
+
+	//chunk range touching view
+	int left = std::max(view.x / chunkPixels, 0);
+	int top = std::max(view.y / chunkPixels, 0);
+	int right = std::min((view.x + view.w) / chunkPixels, widthChunks - 1);
+	int bottom = std::min((view.y + view.h) / chunkPixels, heightChunks - 1);
+
+	for(int chunkY = top; chunkY <= bottom; chunkY++)
+	{
+		for(int chunkX = left; chunkX <= right; chunkX++)
+		{
+			auto found = chunks.find(chunkY * widthChunks + chunkX);
+
+			//chunks not uploaded yet show background beneath
+			if(found == chunks.end() || found->second.state != CHUNK_RESIDENT)
+			{
+				continue;
+			}
+
+			SDL_Rect chunkRect = { chunkX * chunkPixels - view.x, chunkY * chunkPixels - view.y, chunkPixels, chunkPixels };
+			SDL_RenderCopy(mRenderer, found->second.texture, NULL, &chunkRect);
+			perfCountDraw();
+		}
+	}
+}
+
+void TileMap::drawSoft(SoftRenderer& renderer, SDL_Rect view)
+{
+	if(!loaded)
+	{
+		return;
+	}
+
+	int chunkPixels = getChunkPixels();
+
+	//tile range touching view
+	int left = std::max(view.x / tileSize, 0);
+	int top = std::max(view.y / tileSize, 0);
+	int right = std::min((view.x + view.w) / tileSize, getPixelWidth() / tileSize - 1);
+	int bottom = std::min((view.y + view.h) / tileSize, getPixelHeight() / tileSize - 1);
+
+	for(int tileY = top; tileY <= bottom; tileY++)
+	{
+		for(int tileX = left; tileX <= right; tileX++)
+		{
+			int pixelX = tileX * tileSize;
+			int pixelY = tileY * tileSize;
+			auto found = chunks.find((pixelY / chunkPixels) * widthChunks + pixelX / chunkPixels);
+
+			//chunks not decoded yet show background beneath
+			if(found == chunks.end() || found->second.state == CHUNK_LOADING)
+			{
+				continue;
+			}
+
+			int tile = found->second.tiles[((pixelY % chunkPixels) / tileSize) * chunkTiles + (pixelX % chunkPixels) / tileSize];
+			if(tile == 0)
+			{
+				continue;
+			}
+
+			SDL_Rect sourceRect = { (tile % tilesetColumns) * tileSize, (tile / tilesetColumns) * tileSize, tileSize, tileSize };
+			SDL_Rect destRect = { pixelX - view.x, pixelY - view.y, tileSize, tileSize };
+			renderer.copy(tilesetTexture, &sourceRect, &destRect);
+		}
+	}
+}
+
+bool TileMap::isSolidAt(int x, int y) const
+{
+	int chunkPixels = getChunkPixels();
+
+	if(!loaded || x < 0 || y < 0 || x >= getPixelWidth() || y >= getPixelHeight())
+	{
+		return false;
+	}
+
+	auto found = chunks.find((y / chunkPixels) * widthChunks + x / chunkPixels);
+	if(found == chunks.end() || found->second.state == CHUNK_LOADING)
+	{
+		return false;
+	}
+
+	//tile within chunk
+	int tile = found->second.tiles[((y % chunkPixels) / tileSize) * chunkTiles + (x % chunkPixels) / tileSize];
+
+	return (solidTiles[tile / 8] >> (tile % 8)) & 1;
+}
+
+void TileMap::decodeChunk(int chunkIndex)
+{
+	DecodedChunk result;
+	result.index = chunkIndex;
+	result.success = false;
+	result.tiles.assign(chunkTiles * chunkTiles, 0);
+
+	//each loader opens its own handle so reads don't contend
+	std::ifstream file(path, std::ios::binary);
+
+	//read this chunk's offset and next chunk's offset to get data length
+	Uint8 offsets[8];
+	if(chunkIndex >= 0 && chunkIndex < widthChunks * heightChunks)
+	{
+		file.seekg(TILEMAP_HEADER_SIZE + (std::streamoff)chunkIndex * 4);
+		file.read((char*)offsets, 8);
+	}
+	else
+	{
+		file.setstate(std::ios::failbit);
+	}
+
+	if(file)
+	{
+		Uint32 start = readU32(offsets);
+		Uint32 end = readU32(offsets + 4);
+
+		//offsets come from file, so don't trust them to size a buffer until they are inside it
+		Sint64 dataStart = TILEMAP_HEADER_SIZE + ((Sint64)widthChunks * heightChunks + 1) * 4;
+		if(start >= dataStart && start < end && end <= fileSize)
+		{
+			//read run length data
+			std::vector<Uint8> data(end - start);
+			file.seekg(start);
+			file.read((char*)data.data(), data.size());
+
+			if(file)
+			{
+				//expand runs into tiles
+				size_t tile = 0;
+				for(size_t i = 0; i + 1 < data.size() && tile < result.tiles.size(); i += 2)
+				{
+					size_t run = std::min((size_t)data[i], result.tiles.size() - tile);
+					memset(&result.tiles[tile], data[i + 1], run);
+					tile += run;
+				}
+
+				result.success = tile == result.tiles.size();
+			}
+		}
+	}
+
+	//hand result back to main thread
+	std::lock_guard<std::mutex> lock(decodedMutex);
+	decoded.push_back(std::move(result));
+}
+
+void TileMap::collectDecoded()
+{
+	std::vector<DecodedChunk> finished;
+
+	//swap out finished list so lock is held briefly
+	{
+		std::lock_guard<std::mutex> lock(decodedMutex);
+		finished.swap(decoded);
+	}
+
+	for(DecodedChunk& result : finished)
+	{
+		pendingChunks--;
+
+		auto found = chunks.find(result.index);
+		if(found == chunks.end())
+		{
+			continue;
+		}
+
+		if(!result.success)
+		{
+			SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Unable to decode tile map chunk %d\n", result.index);
+		}
+
+		//failed chunks are kept as empty tiles so they aren't requested every frame
+		found->second.tiles = std::move(result.tiles);
+		found->second.state = CHUNK_DECODED;
+		memTrackAlloc(MEM_TILEMAP, found->second.tiles.size());
+		revision++;
+	}
+}
+
+void TileMap::uploadChunk(TileChunk& chunk)
+{
+	int chunkPixels = getChunkPixels();
+
+	//reuse a texture from an evicted chunk if there is one
+	if(!texturePool.empty())
+	{
+		chunk.texture = texturePool.back();
+		texturePool.pop_back();
+	}
+	else
+	{
+		chunk.texture = memTrackTexture(SDL_CreateTexture(mRenderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, chunkPixels, chunkPixels));
+		if(chunk.texture == NULL)
+		{
+			SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Unable to create chunk texture! SDL Error: %s\n", SDL_GetError());
+			return;
+		}
+		SDL_SetTextureBlendMode(chunk.texture, SDL_BLENDMODE_BLEND);
+	}
+
+	//render tiles into chunk texture
+	SDL_Texture* previousTarget = SDL_GetRenderTarget(mRenderer);
+	SDL_SetRenderTarget(mRenderer, chunk.texture);
+
+	//clear to transparent so empty tiles show background
+	SDL_SetRenderDrawColor(mRenderer, 0, 0, 0, 0);
+	SDL_RenderClear(mRenderer);
+
+	for(int tileY = 0; tileY < chunkTiles; tileY++)
+	{
+		for(int tileX = 0; tileX < chunkTiles; tileX++)
+		{
+			int tile = chunk.tiles[tileY * chunkTiles + tileX];
+
+			if(tile == 0)
+			{
+				continue;
+			}
+
+			SDL_Rect sourceRect = { (tile % tilesetColumns) * tileSize, (tile / tilesetColumns) * tileSize, tileSize, tileSize };
+			SDL_Rect destRect = { tileX * tileSize, tileY * tileSize, tileSize, tileSize };
+			SDL_RenderCopy(mRenderer, tilesetTexture, &sourceRect, &destRect);
+			perfCountDraw();
+		}
+	}
+
+	SDL_SetRenderTarget(mRenderer, previousTarget);
+
+	chunk.state = CHUNK_RESIDENT;
+}
+
+void TileMap::evictChunk(int chunkIndex)
+{
+	auto found = chunks.find(chunkIndex);
+	if(found == chunks.end())
+	{
+		return;
+	}
+
+	//keep texture for the next chunk to be uploaded
+	if(found->second.texture != NULL)
+	{
+		texturePool.push_back(found->second.texture);
+	}
+
+	if(found->second.state != CHUNK_LOADING)
+	{
+		memTrackFree(MEM_TILEMAP, found->second.tiles.size());
+		revision++;
+	}
+
+	chunks.erase(found);
+
+	//pool never holds more than a full set of resident textures
+	while((int)texturePool.size() > MAX_RESIDENT_CHUNKS)
+	{
+		memDestroyTexture(texturePool.back());
+		texturePool.pop_back();
+	}
+}
+
+bool TileMap::saveMap(std::string mapPath, const std::vector<Uint8>& tiles, int widthTiles, int heightTiles,
+	int tileSize, int chunkTiles, int tilesetColumns, const std::vector<Uint8>& solidTiles)
+{
+	if((int)tiles.size() < widthTiles * heightTiles || chunkTiles <= 0)
+	{
+		return false;
+	}
+
+	std::ofstream file(mapPath, std::ios::binary);
+	if(!file)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Unable to write tile map %s\n", mapPath.c_str());
+		return false;
+	}
+
+	//partial chunks at the edges are padded with empty tiles
+	int widthChunks = (widthTiles + chunkTiles - 1) / chunkTiles;
+	int heightChunks = (heightTiles + chunkTiles - 1) / chunkTiles;
+	int chunkCount = widthChunks * heightChunks;
+
+	//encode each chunk as run length pairs
+	std::vector<std::vector<Uint8>> chunkData(chunkCount);
+	for(int chunkY = 0; chunkY < heightChunks; chunkY++)
+	{
+		for(int chunkX = 0; chunkX < widthChunks; chunkX++)
+		{
+			std::vector<Uint8>& data = chunkData[chunkY * widthChunks + chunkX];
+			int run = 0;
+			int runTile = -1;
+
+			for(int tileY = 0; tileY < chunkTiles; tileY++)
+			{
+				for(int tileX = 0; tileX < chunkTiles; tileX++)
+				{
+					int mapX = chunkX * chunkTiles + tileX;
+					int mapY = chunkY * chunkTiles + tileY;
+					int tile = (mapX < widthTiles && mapY < heightTiles) ? tiles[mapY * widthTiles + mapX] : 0;
+
+					//flush run when tile changes or run is full
+					if(tile != runTile || run == 255)
+					{
+						if(run > 0)
+						{
+							data.push_back((Uint8)run);
+							data.push_back((Uint8)runTile);
+						}
+						run = 0;
+						runTile = tile;
+					}
+					run++;
+				}
+			}
+
+			data.push_back((Uint8)run);
+			data.push_back((Uint8)runTile);
+		}
+	}
+
+	//solid tile bit set
+	Uint8 solid[TILEMAP_SOLID_BYTES] = { 0 };
+	for(Uint8 id : solidTiles)
+	{
+		solid[id / 8] |= (Uint8)(1 << (id % 8));
+	}
+
+	//header
+	file.write("TMAP", 4);
+	writeU16(file, TILEMAP_VERSION);
+	writeU16(file, (Uint16)tileSize);
+	writeU16(file, (Uint16)chunkTiles);
+	writeU16(file, (Uint16)widthChunks);
+	writeU16(file, (Uint16)heightChunks);
+	writeU16(file, (Uint16)tilesetColumns);
+	file.write((char*)solid, TILEMAP_SOLID_BYTES);
+
+	//offset table
+	Uint32 offset = TILEMAP_HEADER_SIZE + (chunkCount + 1) * 4;
+	for(int i = 0; i < chunkCount; i++)
+	{
+		writeU32(file, offset);
+		offset += (Uint32)chunkData[i].size();
+	}
+	writeU32(file, offset);
+
+	//chunk data
+	for(std::vector<Uint8>& data : chunkData)
+	{
+		file.write((char*)data.data(), data.size());
+	}
+
+	return (bool)file;
+}
@@ -0,0 +1,169 @@
+/*
+Title:	TileMap.h
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: header file for TileMap class for my game engine. The map is split into fixed size chunks that are decoded on background
+	threads as the player gets close, pre-rendered into cached chunk textures and evicted when far away so memory stays bounded.
+
+	Map file layout (little endian):
+		char[4]		"TMAP"
+		Uint16		version
+		Uint16		tile size in pixels
+		Uint16		tiles per chunk edge
+		Uint16		map width in chunks
+		Uint16		map height in chunks
+		Uint16		tileset columns
+		Uint8[32]	bit set of solid tile ids
+		Uint32[n+1]	file offset of each chunk's data, last entry is end of file
+		chunk data	run length pairs of (Uint8 run, Uint8 tile id), row major. Tile id 0 is empty
+ */
+
+#pragma once
+#ifndef TILEMAP_H
+#define TILEMAP_H
+
+#include <SDL.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include "ThreadPool.h"
+#include "SoftRenderer.h"
+
+//tile map constants
+const int TILEMAP_VERSION = 1;
+const int TILEMAP_HEADER_SIZE = 48;
+const int TILEMAP_SOLID_BYTES = 32;
+const int MAX_RESIDENT_CHUNKS = 64;			//most chunks that can hold decoded tiles and a texture at once
+const int MAX_PENDING_CHUNKS = 16;			//most chunk decodes queued on loader threads at once
+const int CHUNK_UPLOADS_PER_FRAME = 2;		//chunk textures rendered per frame, keeps uploads from hitching
+const int CHUNK_STREAM_RADIUS = 2;			//chunks around the player and view to load
+const int CHUNK_LOADER_THREADS = 2;
+
+//chunk states
+enum ChunkState
+{
+	CHUNK_LOADING, CHUNK_DECODED, CHUNK_RESIDENT
+};
+
+//a chunk that is loading or loaded
+struct TileChunk
+{
+	//current state
+	ChunkState state;
+
+	//decoded tile ids, row major
+	std::vector<Uint8> tiles;
+
+	//pre-rendered chunk image
+	SDL_Texture* texture;
+
+	//last frame chunk was wanted, used for eviction
+	Uint64 lastUsed;
+};
+
+class TileMap
+{
+public:
+	//initialize variables
+	TileMap();
+
+	//destructor
+	~TileMap();
+
+	//read map header and start loader threads. Tileset is not owned by the map
+	bool load(SDL_Renderer* renderer, std::string mapPath, SDL_Texture* tileset);
+
+	//deallocates resources
+	void free();
+
+	//request chunks around focus and view, upload decoded chunks and evict far ones
+	void update(SDL_Point focus, SDL_Rect view);
+
+	//draw resident chunks in view, offset by camera
+	void draw(SDL_Rect view);
+
+	//draw decoded tiles in view with CPU renderer, which must have tileset's image
+	void drawSoft(SoftRenderer& renderer, SDL_Rect view);
+
+	//write a map file in the chunked format. Tiles are row major, width and height in tiles
+	static bool saveMap(std::string mapPath, const std::vector<Uint8>& tiles, int widthTiles, int heightTiles,
+		int tileSize, int chunkTiles, int tilesetColumns, const std::vector<Uint8>& solidTiles);
+
+	//getters
+	bool isLoaded() const { return loaded; }
+	int getResidentChunks() const { return (int)chunks.size(); }		//get number of chunks loading or loaded
+	int getTileSize() const { return tileSize; }						//get width of a tile in pixels
+	int getChunkPixels() const { return chunkTiles * tileSize; }		//get width of a chunk in pixels
+	int getPixelWidth() const { return widthChunks * getChunkPixels(); }
+	int getPixelHeight() const { return heightChunks * getChunkPixels(); }
+	Uint32 getRevision() const { return revision; }					//get count of times decoded tiles changed
+
+	//check if tile under pixel is solid. Tiles in chunks not decoded yet count as open
+	bool isSolidAt(int x, int y) const;
+
+private:
+	//decodes a chunk from file, run on loader threads
+	void decodeChunk(int chunkIndex);
+
+	//move decoded chunks from loader threads into chunk table
+	void collectDecoded();
+
+	//render decoded chunk tiles into a texture
+	void uploadChunk(TileChunk& chunk);
+
+	//remove chunk and recycle its texture
+	void evictChunk(int chunkIndex);
+
+	//renderer chunks are drawn with
+	SDL_Renderer* mRenderer;
+
+	//tileset texture
+	SDL_Texture* tilesetTexture;
+
+	//path to map file, loader threads open their own handle
+	std::string path;
+
+	//map header values
+	int tileSize;
+	int chunkTiles;
+	int widthChunks;
+	int heightChunks;
+	int tilesetColumns;
+	Uint8 solidTiles[TILEMAP_SOLID_BYTES];
+
+	//length of map file in bytes
+	Sint64 fileSize;
+
+	//flag if map header was read
+	bool loaded;
+
+	//chunks currently loading or loaded, keyed by chunk index
+	std::unordered_map<int, TileChunk> chunks;
+
+	//number of chunks waiting on loader threads
+	int pendingChunks;
+
+	//decoded chunks waiting to be collected by main thread
+	struct DecodedChunk
+	{
+		int index;
+		bool success;
+		std::vector<Uint8> tiles;
+	};
+	std::vector<DecodedChunk> decoded;
+	std::mutex decodedMutex;
+
+	//textures from evicted chunks ready to be reused
+	std::vector<SDL_Texture*> texturePool;
+
+	//frame counter for eviction
+	Uint64 frame;
+
+	//bumped whenever a chunk's tiles arrive or are evicted, so solid tile users know to look again
+	Uint32 revision;
+
+	//background loader threads
+	ThreadPool loaders;
+};
+#endif
@@ -79,6 +79,23 @@ void Timer::unpause()
 	}
 }
 
+void Timer::setTicks(Uint64 ticks)
+{
+	//setting time starts the timer
+	started = true;
+
+	//if paused, ticks when paused is elapsed time
+	if(paused)
+	{
+		ticksPaused = ticks;
+	}
+	//else move start back so current ticks minus start is elapsed time
+	else
+	{
+		ticksStart = SDL_GetTicks64() - ticks;
+	}
+}
+
 Uint64 Timer::getTicks()
 {
 	//if timer is not started no ticks to get
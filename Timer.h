@@ -27,6 +27,9 @@ public:
 	//timer current time getter
 	Uint64 getTicks();
 
+	//set elapsed time, used when restoring a snapshot
+	void setTicks(Uint64 ticks);
+
 	//timer status getters
 	bool isStarted() const { return started; }
 	bool isPaused() const { return paused; }
@@ -0,0 +1,167 @@
+/*
+Title:	TimerWheel.cpp
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: implementation file for TimerWheel class for my game engine
+ */
+
+#include "TimerWheel.h"
+
+//list of timers firing this tick, after every ring's slots
+const int FIRING_LIST = WHEEL_LEVELS * WHEEL_SLOTS;
+
+TimerWheel::TimerWheel()
+{
+	//initialize variables
+	for(int i = 0; i <= FIRING_LIST; i++)
+	{
+		heads[i] = -1;
+		tails[i] = -1;
+	}
+
+	tick = 0;
+	pending = 0;
+	fired = 0;
+}
+
+SlotHandle TimerWheel::schedule(Uint32 delay, std::function<void()> callback)
+{
+	//reuse a free timer if there is one
+	int timer;
+	if(freeTimers.empty())
+	{
+		timer = (int)timers.size();
+		timers.push_back({ 0, 1, -1, -1, -1, std::function<void()>() });
+	}
+	else
+	{
+		timer = freeTimers.back();
+		freeTimers.pop_back();
+	}
+
+	//a timer due now would be missed, this tick's slot has already fired
+	timers[timer].due = tick + (delay > 0 ? delay : 1);
+	timers[timer].callback = std::move(callback);
+	link(timer);
+	pending++;
+
+	return { (Uint32)timer, timers[timer].generation };
+}
+
+bool TimerWheel::cancel(SlotHandle timer)
+{
+	if(!isPending(timer))
+	{
+		return false;
+	}
+
+	Timer& cancelled = timers[timer.index];
+	unlink(timer.index);
+	cancelled.callback = std::function<void()>();
+
+	//old handles stop matching
+	cancelled.generation = nextGeneration(cancelled.generation);
+	freeTimers.push_back(timer.index);
+	pending--;
+
+	return true;
+}
+
+void TimerWheel::advance()
+{
+	tick++;
+
+	//when low ring turns over, bring down next ring's slot, highest ring first so its timers land in slots still to come
+	int top = 0;
+	while (top + 1 < WHEEL_LEVELS && (tick & ((1u << (WHEEL_SLOT_BITS * (top + 1))) - 1)) == 0) { top++; }
+
+	for(int level = top; level > 0; level--)
+	{
+		cascade(level, (tick >> (WHEEL_SLOT_BITS * level)) & WHEEL_SLOT_MASK);
+	}
+
+	//everything in this tick's slot is due now. Moved to its own list so callbacks can cancel timers not yet fired
+	int slot = tick & WHEEL_SLOT_MASK;
+	heads[FIRING_LIST] = heads[slot];
+	tails[FIRING_LIST] = tails[slot];
+	heads[slot] = -1;
+	tails[slot] = -1;
+	for (int timer = heads[FIRING_LIST]; timer != -1; timer = timers[timer].next) { timers[timer].list = FIRING_LIST; }
+
+	while(heads[FIRING_LIST] != -1)
+	{
+		int timer = heads[FIRING_LIST];
+		unlink(timer);
+
+		//free timer before calling, callback may schedule into it and pool may grow
+		std::function<void()> callback = std::move(timers[timer].callback);
+		timers[timer].callback = std::function<void()>();
+		timers[timer].generation = nextGeneration(timers[timer].generation);
+		freeTimers.push_back(timer);
+		pending--;
+		fired++;
+
+		if (callback) { callback(); }
+	}
+}
+
+void TimerWheel::clear()
+{
+	for(int timer = 0; timer < (int)timers.size(); timer++)
+	{
+		if (timers[timer].list >= 0) { cancel({ (Uint32)timer, timers[timer].generation }); }
+	}
+}
+
+void TimerWheel::link(int timer)
+{
+	Timer& linked = timers[timer];
+	Uint32 delay = linked.due - tick;
+
+	//lowest ring that reaches due tick, slot picked from due tick's bits for that ring
+	int level = 0;
+	while (level + 1 < WHEEL_LEVELS && delay >= (1u << (WHEEL_SLOT_BITS * (level + 1)))) { level++; }
+
+	//past top ring's reach, wait in its furthest slot and be relinked when it comes round
+	Uint32 placed = delay < WHEEL_RANGE ? linked.due : tick + WHEEL_RANGE - 1;
+	int list = level * WHEEL_SLOTS + ((placed >> (WHEEL_SLOT_BITS * level)) & WHEEL_SLOT_MASK);
+
+	linked.list = list;
+	linked.previous = tails[list];
+	linked.next = -1;
+
+	if (tails[list] != -1) { timers[tails[list]].next = timer; }
+	else { heads[list] = timer; }
+	tails[list] = timer;
+}
+
+void TimerWheel::unlink(int timer)
+{
+	Timer& unlinked = timers[timer];
+
+	if (unlinked.previous != -1) { timers[unlinked.previous].next = unlinked.next; }
+	else { heads[unlinked.list] = unlinked.next; }
+
+	if (unlinked.next != -1) { timers[unlinked.next].previous = unlinked.previous; }
+	else { tails[unlinked.list] = unlinked.previous; }
+
+	unlinked.list = -1;
+	unlinked.previous = -1;
+	unlinked.next = -1;
+}
+
+void TimerWheel::cascade(int level, int slot)
+{
+	//detach whole slot, then relink each timer in order
+	int list = level * WHEEL_SLOTS + slot;
+	int timer = heads[list];
+	heads[list] = -1;
+	tails[list] = -1;
+
+	while(timer != -1)
+	{
+		int next = timers[timer].next;
+		link(timer);
+		timer = next;
+	}
+}
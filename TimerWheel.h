@@ -0,0 +1,97 @@
+/*
+Title:	TimerWheel.h
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: header file for TimerWheel class for my game engine. Schedules things to happen a number of simulation ticks from
+	now, so countdowns don't have to be stepped on every object every tick. Timers sit in rings of slots, the first ring one
+	tick per slot and each ring after it covering a whole turn of the one below per slot. Scheduling and cancelling only
+	link or unlink a timer, and a tick only looks at one slot, plus moving a slot down a ring each time a ring turns over.
+	Timers are reached through generational handles, so a handle to a fired or cancelled timer is just no longer pending.
+ */
+
+#pragma once
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include <SDL.h>
+#include <vector>
+#include <functional>
+#include "SlotMap.h"
+
+//timer wheel constants
+const int WHEEL_LEVELS = 4;
+const int WHEEL_SLOT_BITS = 6;
+const int WHEEL_SLOTS = 1 << WHEEL_SLOT_BITS;
+const Uint32 WHEEL_SLOT_MASK = WHEEL_SLOTS - 1;
+const Uint32 WHEEL_RANGE = 1u << (WHEEL_SLOT_BITS * WHEEL_LEVELS);	//ticks past which timers are held in top ring until near
+
+class TimerWheel
+{
+public:
+	//initialize variables
+	TimerWheel();
+
+	//fire after delay ticks, at least 1, calling callback if there is one. Returns handle to check or cancel it
+	SlotHandle schedule(Uint32 delay, std::function<void()> callback = std::function<void()>());
+
+	//stop timer before it fires, returns false if it already fired or was cancelled
+	bool cancel(SlotHandle timer);
+
+	//move one tick on, firing timers due in the order they were scheduled. Callbacks may schedule and cancel timers,
+	//but not advance
+	void advance();
+
+	//cancel every timer
+	void clear();
+
+	//make room for count timers without reallocating
+	void reserve(int count) { timers.reserve(count); freeTimers.reserve(count); }
+
+	//check timer has yet to fire or be cancelled
+	bool isPending(SlotHandle timer) const
+	{
+		return timer.index < timers.size() && timer.generation != 0 && timers[timer.index].generation == timer.generation && timers[timer.index].list >= 0;
+	}
+
+	//get ticks until timer fires, 0 if it isn't pending
+	Uint32 remaining(SlotHandle timer) const { return isPending(timer) ? timers[timer.index].due - tick : 0; }
+
+	//getters
+	Uint32 getTick() const { return tick; }			//get ticks advanced since made
+	int getPending() const { return pending; }		//get timers waiting to fire
+	Sint64 getFired() const { return fired; }		//get timers fired since made
+
+private:
+	//scheduled timer, linked into a slot's list. Free ones have no list
+	struct Timer
+	{
+		Uint32 due;
+		Uint32 generation;
+		int list;
+		int previous;
+		int next;
+		std::function<void()> callback;
+	};
+
+	//link timer into slot for its due tick, at end so timers due together fire in order
+	void link(int timer);
+
+	//take timer out of its list
+	void unlink(int timer);
+
+	//relink timers in slot of ring now that they are within reach of lower rings
+	void cascade(int level, int slot);
+
+	//timer pool, and ones free for reuse
+	std::vector<Timer> timers;
+	std::vector<int> freeTimers;
+
+	//first and last timer in each slot of each ring, then list of timers firing this tick
+	int heads[WHEEL_LEVELS * WHEEL_SLOTS + 1];
+	int tails[WHEEL_LEVELS * WHEEL_SLOTS + 1];
+
+	Uint32 tick;
+	int pending;
+	Sint64 fired;
+};
+#endif
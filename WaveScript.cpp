@@ -0,0 +1,210 @@
+/*
+Title:	WaveScript.cpp
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: implementation file for WaveScript class for my game engine
+ */
+
+#include "WaveScript.h"
+#include "Scene.h"
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <sys/stat.h>
+
+//wave matching the original hard coded spawner
+static Wave defaultWave()
+{
+	Wave wave;
+	wave.startSeconds = 0;
+	wave.minInterval = 5;
+	wave.maxInterval = 29;
+	wave.burst = 1;
+	wave.cap = ENEMY_SPAWN_LIMIT;
+	wave.edges = WAVE_EDGE_ALL;
+	wave.speedBase = fixedFromInt(ENEMY_SPEED_BASE);
+	wave.speedRandom = 6;
+	wave.speedRamp = 0;
+
+	return wave;
+}
+
+WaveScript::WaveScript()
+{
+	//initialize variables
+	waves.push_back(defaultWave());
+	loadedTime = 0;
+	lastCheck = 0;
+}
+
+bool WaveScript::load(std::string path)
+{
+	std::vector<Wave> parsed;
+
+	//remember path even if it fails so fixing the file reloads it
+	this->path = path;
+	loadedTime = modifiedTime(path);
+	lastCheck = SDL_GetTicks64();
+
+	if(!parse(path, parsed))
+	{
+		return false;
+	}
+
+	waves.swap(parsed);
+
+	SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "Loaded %d waves from %s\n", (int)waves.size(), path.c_str());
+
+	return true;
+}
+
+void WaveScript::checkReload()
+{
+	Uint64 now = SDL_GetTicks64();
+
+	if(path.empty() || now - lastCheck < WAVE_RELOAD_CHECK_MS)
+	{
+		return;
+	}
+
+	lastCheck = now;
+
+	Sint64 time = modifiedTime(path);
+	if(time != 0 && time != loadedTime)
+	{
+		load(path);
+	}
+}
+
+const Wave& WaveScript::getWave(float seconds) const
+{
+	//last wave that has started, first wave before any start
+	size_t current = 0;
+	while(current + 1 < waves.size() && waves[current + 1].startSeconds <= seconds)
+	{
+		current++;
+	}
+
+	return waves[current];
+}
+
+bool WaveScript::parse(std::string path, std::vector<Wave>& parsed)
+{
+	std::ifstream file(path);
+	if(!file)
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Unable to open wave file %s\n", path.c_str());
+		return false;
+	}
+
+	std::string line;
+	int lineNumber = 0;
+
+	while(std::getline(file, line))
+	{
+		lineNumber++;
+
+		//strip comment
+		size_t comment = line.find('#');
+		if (comment != std::string::npos) { line.erase(comment); }
+
+		std::istringstream words(line);
+		std::string setting;
+		if(!(words >> setting))
+		{
+			continue;
+		}
+
+		bool valid = true;
+
+		if(setting == "wave")
+		{
+			//new wave starts with previous wave's settings so only changes need listing
+			Wave wave = parsed.empty() ? defaultWave() : parsed.back();
+			valid = (bool)(words >> wave.startSeconds) && wave.startSeconds >= 0;
+			parsed.push_back(wave);
+		}
+		else if(parsed.empty())
+		{
+			SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "%s:%d: %s before first wave\n", path.c_str(), lineNumber, setting.c_str());
+			return false;
+		}
+		else if(setting == "interval")
+		{
+			Wave& wave = parsed.back();
+			valid = (bool)(words >> wave.minInterval >> wave.maxInterval) && wave.minInterval >= 1 && wave.maxInterval >= wave.minInterval;
+		}
+		else if(setting == "burst")
+		{
+			Wave& wave = parsed.back();
+			valid = (bool)(words >> wave.burst) && wave.burst >= 1;
+		}
+		else if(setting == "cap")
+		{
+			Wave& wave = parsed.back();
+			valid = (bool)(words >> wave.cap) && wave.cap >= 0;
+		}
+		else if(setting == "edges")
+		{
+			Wave& wave = parsed.back();
+			std::string edge;
+			wave.edges = 0;
+
+			while(words >> edge)
+			{
+				if (edge == "left") { wave.edges |= WAVE_EDGE_LEFT; }
+				else if (edge == "right") { wave.edges |= WAVE_EDGE_RIGHT; }
+				else if (edge == "top") { wave.edges |= WAVE_EDGE_TOP; }
+				else if (edge == "bottom") { wave.edges |= WAVE_EDGE_BOTTOM; }
+				else { valid = false; }
+			}
+
+			valid = valid && wave.edges != 0;
+		}
+		else if(setting == "speed")
+		{
+			Wave& wave = parsed.back();
+			float speedBase = 0;
+			valid = (bool)(words >> speedBase >> wave.speedRandom) && wave.speedRandom >= 1;
+			wave.speedBase = fixedFromFloat(speedBase);
+
+			//ramp is optional
+			float speedRamp = 0;
+			if (valid && !(words >> speedRamp)) { speedRamp = 0; }
+			wave.speedRamp = fixedFromFloat(speedRamp);
+		}
+		else
+		{
+			valid = false;
+		}
+
+		if(!valid)
+		{
+			SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "%s:%d: bad %s line\n", path.c_str(), lineNumber, setting.c_str());
+			return false;
+		}
+	}
+
+	if(parsed.empty())
+	{
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "%s has no waves\n", path.c_str());
+		return false;
+	}
+
+	//waves may be listed in any order
+	std::stable_sort(parsed.begin(), parsed.end(), [](const Wave& a, const Wave& b) { return a.startSeconds < b.startSeconds; });
+
+	return true;
+}
+
+Sint64 WaveScript::modifiedTime(std::string path) const
+{
+	struct stat info;
+
+	if(stat(path.c_str(), &info) != 0)
+	{
+		return 0;
+	}
+
+	return (Sint64)info.st_mtime;
+}
@@ -0,0 +1,88 @@
+/*
+Title:	WaveScript.h
+Author:	Austin Sands
+Date:	10/19/2026
+Purpose: header file for WaveScript class for my game engine. Reads enemy spawn waves from a text file so spawn rates, bursts,
+	caps, spawn edges and speeds can be tuned, or pushed to tens of thousands of enemies for load testing, without recompiling.
+	The file is checked for changes while running and reloaded when saved.
+
+	File format, one setting per line, # starts a comment. Settings after a wave line belong to that wave and start out as the
+	previous wave's, so only changes need listing. A wave runs from its start time until the next wave starts:
+		wave <start seconds>
+		interval <min ticks> <max ticks>		ticks between spawns
+		burst <count>							enemies spawned each time
+		cap <count>								no spawning while this many enemies are alive
+		edges <left|right|top|bottom ...>		borders enemies spawn on
+		speed <base> <random> [ramp]			speed is base + ramp * seconds into wave + 0 to random - 1
+ */
+
+#pragma once
+#ifndef WAVESCRIPT_H
+#define WAVESCRIPT_H
+
+#include <SDL.h>
+#include <string>
+#include <vector>
+#include "FixedMath.h"
+
+//spawn edge bits
+const Uint8 WAVE_EDGE_LEFT = 1;
+const Uint8 WAVE_EDGE_RIGHT = 2;
+const Uint8 WAVE_EDGE_TOP = 4;
+const Uint8 WAVE_EDGE_BOTTOM = 8;
+const Uint8 WAVE_EDGE_ALL = 15;
+
+//how often file is checked for changes
+const Uint32 WAVE_RELOAD_CHECK_MS = 1000;
+
+//settings for one wave
+struct Wave
+{
+	float startSeconds;
+	int minInterval;
+	int maxInterval;
+	int burst;
+	int cap;
+	Uint8 edges;
+	Fixed speedBase;
+	int speedRandom;
+	Fixed speedRamp;
+};
+
+class WaveScript
+{
+public:
+	//start with built in default wave
+	WaveScript();
+
+	//load waves from file and remember it for reloading. Keeps current waves and returns false on error
+	bool load(std::string path);
+
+	//reload file if it changed since last load, checked at most once per WAVE_RELOAD_CHECK_MS
+	void checkReload();
+
+	//wave running at time into game
+	const Wave& getWave(float seconds) const;
+
+	//getters
+	int getWaveCount() const { return (int)waves.size(); }
+	std::string getPath() const { return path; }
+
+private:
+	//parse file into waves, false with message on error
+	bool parse(std::string path, std::vector<Wave>& parsed);
+
+	//last write time of file, 0 if it can't be read
+	Sint64 modifiedTime(std::string path) const;
+
+	//waves sorted by start time, never empty
+	std::vector<Wave> waves;
+
+	//file waves came from, empty for built in
+	std::string path;
+
+	//file time when loaded and when file was last checked
+	Sint64 loadedTime;
+	Uint64 lastCheck;
+};
+#endif